@@ -7,7 +7,7 @@
 QT_BEGIN_NAMESPACE
 
 QV4ProfilerAdapter::QV4ProfilerAdapter(QQmlProfilerService *service, QV4::ExecutionEngine *engine) :
-    m_functionCallPos(0), m_memoryPos(0)
+    m_functionCallPos(0), m_memoryPos(0), m_samplePos(0)
 {
     setService(service);
     engine->setProfiler(new QV4::Profiling::Profiler(engine));
@@ -48,27 +48,55 @@ qint64 QV4ProfilerAdapter::appendMemoryEvents(qint64 until, QList<QByteArray> &m
     return memoryData.length() == m_memoryPos ? -1 : memoryData[m_memoryPos].timestamp;
 }
 
+qint64 QV4ProfilerAdapter::appendSampleEvents(qint64 until, QList<QByteArray> &messages,
+                                              QQmlDebugPacket &d)
+{
+    const QVector<QV4::Profiling::StackSampleProperties> &sampleData = m_sampleData;
+
+    while (sampleData.length() > m_samplePos && sampleData[m_samplePos].timestamp <= until) {
+        const QV4::Profiling::StackSampleProperties &props = sampleData[m_samplePos];
+        d << props.timestamp << int(JavaScriptSample) << int(Javascript) << props.count
+          << props.stack;
+        ++m_samplePos;
+        messages.append(d.squeezedData());
+        d.clear();
+    }
+    return sampleData.length() == m_samplePos ? -1 : sampleData[m_samplePos].timestamp;
+}
+
 qint64 QV4ProfilerAdapter::finalizeMessages(qint64 until, QList<QByteArray> &messages,
                                             qint64 callNext, QQmlDebugPacket &d)
 {
     qint64 memoryNext = -1;
+    qint64 sampleNext = -1;
 
     if (callNext == -1) {
         m_functionLocations.clear();
         m_functionCallData.clear();
         m_functionCallPos = 0;
         memoryNext = appendMemoryEvents(until, messages, d);
+        sampleNext = appendSampleEvents(until, messages, d);
     } else {
         memoryNext = appendMemoryEvents(qMin(callNext, until), messages, d);
+        sampleNext = appendSampleEvents(qMin(callNext, until), messages, d);
+    }
+
+    if (sampleNext == -1) {
+        m_sampleData.clear();
+        m_samplePos = 0;
     }
 
     if (memoryNext == -1) {
         m_memoryData.clear();
         m_memoryPos = 0;
-        return callNext;
     }
 
-    return callNext == -1 ? memoryNext : qMin(callNext, memoryNext);
+    qint64 next = -1;
+    for (qint64 pending : { callNext, memoryNext, sampleNext }) {
+        if (pending != -1 && (next == -1 || pending < next))
+            next = pending;
+    }
+    return next;
 }
 
 qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &messages)
@@ -125,7 +153,8 @@ qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &message
 void QV4ProfilerAdapter::receiveData(
         const QV4::Profiling::FunctionLocationHash &locations,
         const QVector<QV4::Profiling::FunctionCallProperties> &functionCallData,
-        const QVector<QV4::Profiling::MemoryAllocationProperties> &memoryData)
+        const QVector<QV4::Profiling::MemoryAllocationProperties> &memoryData,
+        const QVector<QV4::Profiling::StackSampleProperties> &sampleData)
 {
     // In rare cases it could be that another flush or stop event is processed while data from
     // the previous one is still pending. In that case we just append the data.
@@ -144,6 +173,11 @@ void QV4ProfilerAdapter::receiveData(
     else
         m_memoryData.append(memoryData);
 
+    if (m_sampleData.isEmpty())
+        m_sampleData = sampleData;
+    else
+        m_sampleData.append(sampleData);
+
     service->dataReady(this);
 }
 
@@ -155,6 +189,8 @@ quint64 QV4ProfilerAdapter::translateFeatures(quint64 qmlFeatures)
         v4Features |= (one << QV4::Profiling::FeatureFunctionCall);
     if (qmlFeatures & (one << ProfileMemory))
         v4Features |= (one << QV4::Profiling::FeatureMemoryAllocation);
+    if (qmlFeatures & (one << ProfileJavaScriptSampling))
+        v4Features |= (one << QV4::Profiling::FeatureSampling);
     return v4Features;
 }
 
@@ -98,6 +98,8 @@ struct Q_QML_COMPILER_PRIVATE_EXPORT JSUnitGenerator {
     ReturnedValue constant(int idx) const;
 
     int registerJSClass(const QStringList &members);
+    int jsClassSize(int jsClassId) const;
+    QString jsClassMember(int jsClassId, int member) const;
 
     int registerTranslation(const CompiledData::TranslationData &translation);
 
@@ -35,6 +35,7 @@ struct QQmlProfilerDefinitions {
         MemoryAllocation,
         DebugMessage,
         Quick3DFrame,
+        JavaScriptSample,
 
         MaximumMessage
     };
@@ -118,6 +119,7 @@ struct QQmlProfilerDefinitions {
         ProfileInputEvents,
         ProfileDebugMessages,
         ProfileQuick3D,
+        ProfileJavaScriptSampling,
 
         MaximumProfileFeature
     };
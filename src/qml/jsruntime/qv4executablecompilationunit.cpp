@@ -31,6 +31,7 @@
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qscopeguard.h>
 #include <QtCore/qcryptographichash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/QScopedValueRollback>
 
 static_assert(QV4::CompiledData::QmlCompileHashSpace > QML_COMPILE_HASH_LENGTH);
@@ -52,6 +53,64 @@ QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 
+namespace {
+
+// Compiled units that don't come from a cache file are heap allocated. Every engine that loads
+// the same document compiles it to the same bytes, though. Keep one refcounted copy per distinct
+// unit, so that multiple engines in the same process don't each hold their own.
+class SharedUnitStore
+{
+public:
+    const CompiledData::Unit *acquire(const CompiledData::Unit *unit)
+    {
+        const size_t hash = qHashBits(unit, unit->unitSize);
+
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_units.constFind(hash), end = m_units.constEnd();
+             it != end && it.key() == hash; ++it) {
+            const CompiledData::Unit *candidate = it.value();
+            if (candidate->unitSize == unit->unitSize
+                    && memcmp(candidate, unit, unit->unitSize) == 0) {
+                ++m_refCounts[candidate].refCount;
+                return candidate;
+            }
+        }
+
+        m_units.insert(hash, unit);
+        m_refCounts.insert(unit, { hash, 1 });
+        return unit;
+    }
+
+    void release(const CompiledData::Unit *unit)
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            const auto it = m_refCounts.find(unit);
+            Q_ASSERT(it != m_refCounts.end());
+            if (--it->refCount > 0)
+                return;
+            m_units.remove(it->hash, unit);
+            m_refCounts.erase(it);
+        }
+        free(const_cast<CompiledData::Unit *>(unit));
+    }
+
+private:
+    struct RefCount
+    {
+        size_t hash;
+        int refCount;
+    };
+
+    QMutex m_mutex;
+    QMultiHash<size_t, const CompiledData::Unit *> m_units;
+    QHash<const CompiledData::Unit *, RefCount> m_refCounts;
+};
+
+Q_GLOBAL_STATIC(SharedUnitStore, sharedUnitStore)
+
+} // namespace
+
 ExecutableCompilationUnit::ExecutableCompilationUnit() = default;
 
 ExecutableCompilationUnit::ExecutableCompilationUnit(
@@ -62,6 +121,46 @@ ExecutableCompilationUnit::ExecutableCompilationUnit(
 ExecutableCompilationUnit::~ExecutableCompilationUnit()
 {
     unlink();
+    releaseSharedUnitData();
+}
+
+void ExecutableCompilationUnit::shareUnitData()
+{
+    Q_ASSERT(!engine);
+    if (!data || m_hasSharedUnitData || backingFile
+            || (data->flags & CompiledData::Unit::StaticData)
+            || qmlData != data->qmlUnit()) {
+        return;
+    }
+
+    SharedUnitStore *store = sharedUnitStore();
+    if (!store)
+        return;
+
+    const CompiledData::Unit *ownData = data;
+    const CompiledData::Unit *sharedData = store->acquire(ownData);
+    m_hasSharedUnitData = true;
+    if (sharedData == ownData)
+        return;
+
+    setUnitData(sharedData, nullptr, fileName(), finalUrlString());
+    free(const_cast<CompiledData::Unit *>(ownData));
+}
+
+void ExecutableCompilationUnit::releaseSharedUnitData()
+{
+    if (!m_hasSharedUnitData)
+        return;
+
+    const CompiledData::Unit *sharedData = data;
+    m_hasSharedUnitData = false;
+
+    // Keep the base class from freeing the data.
+    setUnitData(nullptr);
+
+    // If the store is gone already, we are shutting down and the data is leaked on purpose.
+    if (SharedUnitStore *store = sharedUnitStore())
+        store->release(sharedData);
 }
 
 QString ExecutableCompilationUnit::localCacheFilePath(const QUrl &url)
@@ -797,7 +896,13 @@ bool ExecutableCompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &s
         }
 
         dataPtrRevert.dismiss();
-        free(const_cast<CompiledData::Unit*>(oldDataPtr));
+        if (m_hasSharedUnitData) {
+            m_hasSharedUnitData = false;
+            if (SharedUnitStore *store = sharedUnitStore())
+                store->release(oldDataPtr);
+        } else {
+            free(const_cast<CompiledData::Unit*>(oldDataPtr));
+        }
         backingFile = std::move(cacheFile);
         return true;
     }
@@ -247,6 +247,11 @@ public:
 
     bool loadFromDisk(const QUrl &url, const QDateTime &sourceTimeStamp, QString *errorString);
 
+    // Replaces heap allocated unit data by an identical copy shared by all engines in the
+    // process, if there is one. Must be called before linking to an engine.
+    void shareUnitData();
+    bool hasSharedUnitData() const { return m_hasSharedUnitData; }
+
     static QString localCacheFilePath(const QUrl &url);
     bool saveToDisk(const QUrl &unitUrl, QString *errorString);
 
@@ -285,6 +290,10 @@ private:
     void getExportedNamesRecursively(
             QStringList *names, QVector<const ExecutableCompilationUnit *> *exportNameSet,
             bool includeDefaultExport = true) const;
+
+    void releaseSharedUnitData();
+
+    bool m_hasSharedUnitData = false;
 };
 
 IdentifierHash ExecutableCompilationUnit::namedObjectsPerComponent(int componentObjectIndex)
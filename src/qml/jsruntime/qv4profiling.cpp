@@ -4,12 +4,74 @@
 #include "qv4profiling_p.h"
 #include <private/qv4mm_p.h>
 #include <private/qv4string_p.h>
+#include <private/qv4stackframe_p.h>
+
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <chrono>
 
 QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 namespace Profiling {
 
+class Sampler : public QThread
+{
+public:
+    Sampler(QAtomicInt *pendingSamples, std::chrono::microseconds interval)
+        : m_pendingSamples(pendingSamples), m_interval(interval)
+    {
+        setObjectName(QLatin1String("QV4 sampling profiler"));
+    }
+
+    void stop()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_stopped = true;
+            m_condition.wakeOne();
+        }
+        wait();
+    }
+
+protected:
+    void run() override
+    {
+        QMutexLocker locker(&m_mutex);
+        while (!m_stopped) {
+            if (!m_condition.wait(&m_mutex, QDeadlineTimer(m_interval, Qt::PreciseTimer)))
+                m_pendingSamples->fetchAndAddRelaxed(1);
+        }
+    }
+
+private:
+    QAtomicInt *m_pendingSamples;
+    std::chrono::microseconds m_interval;
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    bool m_stopped = false;
+};
+
+static std::chrono::microseconds samplingInterval()
+{
+    bool ok = false;
+    const int interval = qEnvironmentVariableIntValue("QV4_PROFILER_SAMPLING_INTERVAL", &ok);
+    return std::chrono::microseconds((ok && interval > 0) ? interval : 1000);
+}
+
+static QString sampledFrameName(Function *function)
+{
+    QString name = function->name()->toQString();
+    if (name.isEmpty())
+        name = QLatin1String("<anonymous>");
+    return name + QLatin1String(" (") + function->executableCompilationUnit()->fileName()
+            + QLatin1Char(':') + QString::number(function->compiledFunction->location.line())
+            + QLatin1Char(')');
+}
+
 FunctionLocation FunctionCall::resolveLocation() const
 {
     return FunctionLocation(m_function->name()->toQString(),
@@ -33,19 +95,59 @@ Profiler::Profiler(QV4::ExecutionEngine *engine) : featuresEnabled(0), m_engine(
     static const int metatypes[] = {
         qRegisterMetaType<QVector<QV4::Profiling::FunctionCallProperties> >(),
         qRegisterMetaType<QVector<QV4::Profiling::MemoryAllocationProperties> >(),
+        qRegisterMetaType<QVector<QV4::Profiling::StackSampleProperties> >(),
         qRegisterMetaType<FunctionLocationHash>()
     };
     Q_UNUSED(metatypes);
     m_timer.start();
 }
 
+Profiler::~Profiler()
+{
+    if (m_sampler)
+        m_sampler->stop();
+}
+
 void Profiler::stopProfiling()
 {
+    if (m_sampler) {
+        m_sampler->stop();
+        m_sampler.reset();
+    }
     featuresEnabled = 0;
+    m_pendingSamples.storeRelaxed(0);
     reportData();
     m_sentLocations.clear();
 }
 
+void Profiler::takeSample()
+{
+    const int intervals = m_pendingSamples.fetchAndStoreRelaxed(0);
+    if (intervals == 0 || !(featuresEnabled & (1 << FeatureSampling)))
+        return;
+
+    QVector<Function *> stack;
+    for (CppStackFrame *frame = m_engine->currentStackFrame; frame; frame = frame->parentFrame()) {
+        if (Function *function = frame->v4Function)
+            stack.append(function);
+    }
+    if (stack.isEmpty())
+        return;
+
+    StackSample &sample = m_samples[stack];
+    const bool first = sample.count == 0;
+    sample.count += intervals;
+    if (first) {
+        sample.timestamp = m_timer.nsecsElapsed();
+        // Keep the functions alive until the stack has been symbolized.
+        for (Function *function : qAsConst(stack)) {
+            SentMarker &marker = m_sampledFunctions[reinterpret_cast<quintptr>(function)];
+            if (!marker.isValid())
+                marker.setFunction(function);
+        }
+    }
+}
+
 bool operator<(const FunctionCall &call1, const FunctionCall &call2)
 {
     return call1.m_start < call2.m_start ||
@@ -72,9 +174,32 @@ void Profiler::reportData()
         }
     }
 
-    emit dataReady(locations, properties, m_memory_data);
+    QVector<StackSampleProperties> samples;
+    samples.reserve(m_samples.size());
+    QHash<Function *, QString> frameNames;
+    for (auto it = m_samples.constBegin(), end = m_samples.constEnd(); it != end; ++it) {
+        const QVector<Function *> &stack = it.key();
+        QString folded;
+        for (auto frame = stack.crbegin(), outermost = stack.crend(); frame != outermost; ++frame) {
+            QString &name = frameNames[*frame];
+            if (name.isEmpty())
+                name = sampledFrameName(*frame);
+            if (!folded.isEmpty())
+                folded += QLatin1Char(';');
+            folded += name;
+        }
+        samples.append({it->timestamp, it->count, folded});
+    }
+    std::sort(samples.begin(), samples.end(),
+              [](const StackSampleProperties &a, const StackSampleProperties &b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    emit dataReady(locations, properties, m_memory_data, samples);
     m_data.clear();
     m_memory_data.clear();
+    m_samples.clear();
+    m_sampledFunctions.clear();
 }
 
 void Profiler::startProfiling(quint64 features)
@@ -98,6 +223,11 @@ void Profiler::startProfiling(quint64 features)
         }
 
         featuresEnabled = features;
+
+        if (features & (1 << FeatureSampling)) {
+            m_sampler.reset(new Sampler(&m_pendingSamples, samplingInterval()));
+            m_sampler->start();
+        }
     }
 }
 
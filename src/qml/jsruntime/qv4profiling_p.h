@@ -25,6 +25,7 @@
 
 #define Q_V4_PROFILE_ALLOC(engine, size, type) (!engine)
 #define Q_V4_PROFILE_DEALLOC(engine, size, type) (!engine)
+#define Q_V4_PROFILE_SAMPLE(engine) Q_UNUSED(engine)
 
 QT_BEGIN_NAMESPACE
 
@@ -52,6 +53,11 @@ QT_END_NAMESPACE
             (engine->profiler()->featuresEnabled & (1 << Profiling::FeatureMemoryAllocation)) ?\
         engine->profiler()->trackDealloc(size, type) : false)
 
+#define Q_V4_PROFILE_SAMPLE(engine) do { \
+    if (Q_UNLIKELY(engine->profiler())) \
+        engine->profiler()->takePendingSamples(); \
+} while (false)
+
 QT_BEGIN_NAMESPACE
 
 namespace QV4 {
@@ -60,7 +66,8 @@ namespace Profiling {
 
 enum Features {
     FeatureFunctionCall,
-    FeatureMemoryAllocation
+    FeatureMemoryAllocation,
+    FeatureSampling
 };
 
 enum MemoryType {
@@ -94,6 +101,14 @@ struct FunctionLocation {
 
 typedef QHash<quintptr, QV4::Profiling::FunctionLocation> FunctionLocationHash;
 
+// An aggregated call stack, outermost frame first, in the "folded" format flamegraph tools
+// understand. timestamp is the time the stack was first sampled since the last report.
+struct StackSampleProperties {
+    qint64 timestamp;
+    qint64 count;
+    QString stack;
+};
+
 struct MemoryAllocationProperties {
     qint64 timestamp;
     qint64 size;
@@ -144,6 +159,8 @@ private:
     qint64 m_end;
 };
 
+class Sampler;
+
 class Q_QML_EXPORT Profiler : public QObject {
     Q_OBJECT
 public:
@@ -188,6 +205,7 @@ public:
     };
 
     Profiler(QV4::ExecutionEngine *engine);
+    ~Profiler() override;
 
     bool trackAlloc(size_t size, MemoryType type)
     {
@@ -218,18 +236,41 @@ public:
     void reportData();
     void setTimer(const QElapsedTimer &timer) { m_timer = timer; }
 
+    void takePendingSamples()
+    {
+        if (m_pendingSamples.loadRelaxed())
+            takeSample();
+    }
+
 signals:
     void dataReady(const QV4::Profiling::FunctionLocationHash &,
                    const QVector<QV4::Profiling::FunctionCallProperties> &,
-                   const QVector<QV4::Profiling::MemoryAllocationProperties> &);
+                   const QVector<QV4::Profiling::MemoryAllocationProperties> &,
+                   const QVector<QV4::Profiling::StackSampleProperties> &);
 
 private:
+    struct StackSample {
+        qint64 timestamp = 0;
+        qint64 count = 0;
+    };
+
+    void takeSample();
+
     QV4::ExecutionEngine *m_engine;
     QElapsedTimer m_timer;
     QVector<FunctionCall> m_data;
     QVector<MemoryAllocationProperties> m_memory_data;
     QHash<quintptr, SentMarker> m_sentLocations;
 
+    // The sampler thread only counts the intervals in m_pendingSamples. The stack is captured on
+    // the engine thread the next time a function is entered or left, or a loop polls for
+    // interruptions, as the frames can't safely be walked from the outside while the engine
+    // is running. All the intervals counted since then are attributed to that stack.
+    QScopedPointer<Sampler> m_sampler;
+    QAtomicInt m_pendingSamples;
+    QHash<QVector<Function *>, StackSample> m_samples;
+    QHash<quintptr, SentMarker> m_sampledFunctions;
+
     friend class FunctionCallProfiler;
 };
 
@@ -242,10 +283,25 @@ public:
     FunctionCallProfiler(ExecutionEngine *engine, Function *f)
     {
         Profiler *p = engine->profiler();
-        if (Q_UNLIKELY(p) && (p->featuresEnabled & (1 << Profiling::FeatureFunctionCall))) {
-            profiler = p;
-            function = f;
-            startTime = profiler->m_timer.nsecsElapsed();
+        if (Q_UNLIKELY(p)) {
+            if (p->featuresEnabled & (1 << Profiling::FeatureFunctionCall)) {
+                profiler = p;
+                function = f;
+                startTime = profiler->m_timer.nsecsElapsed();
+            }
+            if (p->featuresEnabled & (1 << Profiling::FeatureSampling)) {
+                sampler = p;
+                if (p->m_pendingSamples.loadRelaxed()) {
+                    CppStackFrame *frame = engine->currentStackFrame;
+                    if (frame && frame->parentFrame()) {
+                        p->takeSample();
+                    } else {
+                        // No JavaScript was running before this call. The engine was idle
+                        // in the meantime, which is not attributed to anything.
+                        p->m_pendingSamples.storeRelaxed(0);
+                    }
+                }
+            }
         }
     }
 
@@ -253,9 +309,12 @@ public:
     {
         if (profiler)
             profiler->m_data.append(FunctionCall(function, startTime, profiler->m_timer.nsecsElapsed()));
+        if (sampler)
+            sampler->takePendingSamples();
     }
 
     Profiler *profiler = nullptr;
+    Profiler *sampler = nullptr;
     Function *function = nullptr;
     qint64 startTime = 0;
 };
@@ -268,12 +327,14 @@ Q_DECLARE_TYPEINFO(QV4::Profiling::MemoryAllocationProperties, Q_RELOCATABLE_TYP
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionCallProperties, Q_RELOCATABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionCall, Q_RELOCATABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionLocation, Q_RELOCATABLE_TYPE);
+Q_DECLARE_TYPEINFO(QV4::Profiling::StackSampleProperties, Q_RELOCATABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::Profiler::SentMarker, Q_RELOCATABLE_TYPE);
 
 QT_END_NAMESPACE
 Q_DECLARE_METATYPE(QV4::Profiling::FunctionLocationHash)
 Q_DECLARE_METATYPE(QVector<QV4::Profiling::FunctionCallProperties>)
 Q_DECLARE_METATYPE(QVector<QV4::Profiling::MemoryAllocationProperties>)
+Q_DECLARE_METATYPE(QVector<QV4::Profiling::StackSampleProperties>)
 
 #endif // QT_CONFIG(qml_debug)
 
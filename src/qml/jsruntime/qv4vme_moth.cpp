@@ -1127,6 +1127,9 @@ QV4::ReturnedValue VME::interpret(JSTypesStackFrame *frame, ExecutionEngine *eng
 
     MOTH_BEGIN_INSTR(CheckException)
         CHECK_EXCEPTION;
+        // Loops check for exceptions on each iteration. Sample them there, too, as they
+        // may not call any function for a long time.
+        Q_V4_PROFILE_SAMPLE(engine);
     MOTH_END_INSTR(CheckException)
 
     MOTH_BEGIN_INSTR(CmpEqNull)
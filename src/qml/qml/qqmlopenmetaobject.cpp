@@ -7,6 +7,7 @@
 #include <private/qqmlmetatype_p.h>
 #include <private/qmetaobjectbuilder_p.h>
 #include <qdebug.h>
+#include <QtCore/qbitarray.h>
 #include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
@@ -144,6 +145,13 @@ public:
     private:
         QVariant m_value;
         QPointer<QObject> qobjectTracker;
+
+        template<typename T>
+        bool equalsAs(const QVariant &other) const
+        {
+            return *static_cast<const T *>(m_value.constData())
+                    == *static_cast<const T *>(other.constData());
+        }
     public:
         bool valueSet = false;
 
@@ -154,6 +162,28 @@ public:
             return m_value;
         }
         QVariant &valueRef() { return m_value; }
+        bool equals(const QVariant &other) const {
+            // Compare the scalar types commonly stored in open metaobjects in place, without
+            // copying the stored value and dispatching through QMetaType::equals().
+            const QMetaType metaType = m_value.metaType();
+            if (metaType == other.metaType()) {
+                switch (metaType.id()) {
+                case QMetaType::Bool:
+                    return equalsAs<bool>(other);
+                case QMetaType::Int:
+                    return equalsAs<int>(other);
+                case QMetaType::LongLong:
+                    return equalsAs<qlonglong>(other);
+                case QMetaType::Double:
+                    return equalsAs<double>(other);
+                case QMetaType::QString:
+                    return equalsAs<QString>(other);
+                default:
+                    break;
+                }
+            }
+            return value() == other;
+        }
         void setValue(const QVariant &v) {
             m_value = v;
             valueSet = true;
@@ -193,6 +223,9 @@ public:
         return data[idx].valueSet;
     }
 
+    void notify(int idx);
+    void flushNotifications();
+
     void dropPropertyCache() {
         if (QQmlData *ddata = QQmlData::get(object, /*create*/false))
             ddata->propertyCache.reset();
@@ -204,10 +237,45 @@ public:
     QObject *object;
     QQmlRefPointer<QQmlOpenMetaObjectType> type;
     QVector<QByteArray> *deferredPropertyNames = nullptr;
+    QBitArray pendingNotifications;
     bool autoCreate = true;
     bool cacheProperties = false;
+    bool coalesceNotifications = false;
+    bool notificationsPosted = false;
 };
 
+void QQmlOpenMetaObjectPrivate::notify(int idx)
+{
+    if (!coalesceNotifications) {
+        QMetaObject::activate(object, idx + type->d->signalOffset, nullptr);
+        return;
+    }
+
+    if (pendingNotifications.size() <= idx)
+        pendingNotifications.resize(idx + 1);
+    pendingNotifications.setBit(idx);
+
+    if (notificationsPosted)
+        return;
+    notificationsPosted = true;
+
+    // The metaobject is owned by the object. Posted events are discarded together with the
+    // object, so the callback cannot outlive us.
+    QMetaObject::invokeMethod(object, [this]() { flushNotifications(); }, Qt::QueuedConnection);
+}
+
+void QQmlOpenMetaObjectPrivate::flushNotifications()
+{
+    notificationsPosted = false;
+
+    // Handlers may change the values again. Those changes are collected for the next pass.
+    const QBitArray pending = std::exchange(pendingNotifications, QBitArray());
+    for (qsizetype i = 0, end = pending.size(); i < end; ++i) {
+        if (pending.testBit(i))
+            QMetaObject::activate(object, int(i) + type->d->signalOffset, nullptr);
+    }
+}
+
 QQmlOpenMetaObject::QQmlOpenMetaObject(QObject *obj, const QMetaObject *base)
 : d(new QQmlOpenMetaObjectPrivate(this, obj))
 {
@@ -270,11 +338,11 @@ int QQmlOpenMetaObject::metaCall(QObject *o, QMetaObject::Call c, int id, void *
             propertyRead(propId);
             *reinterpret_cast<QVariant *>(a[0]) = d->propertyValue(propId);
         } else if (c == QMetaObject::WriteProperty) {
-            if (propId >= d->data.count() || d->data.at(propId).value() != *reinterpret_cast<QVariant *>(a[0]))  {
+            if (propId >= d->data.count() || !d->data.at(propId).equals(*reinterpret_cast<QVariant *>(a[0])))  {
                 propertyWrite(propId);
                 d->setPropertyValue(propId, propertyWriteValue(propId, *reinterpret_cast<QVariant *>(a[0])));
                 propertyWritten(propId);
-                activate(o, d->type->d->signalOffset + propId, nullptr);
+                d->notify(propId);
             }
         }
         return -1;
@@ -293,11 +361,11 @@ QDynamicMetaObjectData *QQmlOpenMetaObject::parent() const
 
 bool QQmlOpenMetaObject::checkedSetValue(int index, const QVariant &value, bool force)
 {
-    if (!force && d->propertyValue(index) == value)
+    if (!force && d->propertyRef(index).equals(value))
         return false;
 
     d->setPropertyValue(index, value);
-    activate(d->object, index + d->type->d->signalOffset, nullptr);
+    d->notify(index);
     return true;
 }
 
@@ -309,7 +377,7 @@ QVariant QQmlOpenMetaObject::value(int id) const
 void QQmlOpenMetaObject::setValue(int id, const QVariant &value)
 {
     d->setPropertyValue(id, propertyWriteValue(id, value));
-    activate(d->object, id + d->type->d->signalOffset, nullptr);
+    d->notify(id);
 }
 
 QVariant QQmlOpenMetaObject::value(const QByteArray &name) const
@@ -321,6 +389,11 @@ QVariant QQmlOpenMetaObject::value(const QByteArray &name) const
     return d->propertyValue(*iter);
 }
 
+QVariant &QQmlOpenMetaObject::valueRef(int id)
+{
+    return d->propertyValueRef(id);
+}
+
 QVariant &QQmlOpenMetaObject::valueRef(const QByteArray &name)
 {
     QHash<QByteArray, int>::ConstIterator iter = d->type->d->names.constFind(name);
@@ -406,6 +479,24 @@ void QQmlOpenMetaObject::setCached(bool c)
     }
 }
 
+bool QQmlOpenMetaObject::coalescesNotifications() const
+{
+    return d->coalesceNotifications;
+}
+
+// When coalescing, change signals are not emitted right away. Instead, each changed property
+// emits its change signal once on the next pass of the event loop, no matter how often it has
+// been written in the mean time. Switching coalescing off delivers pending signals immediately.
+void QQmlOpenMetaObject::setCoalescesNotifications(bool coalesce)
+{
+    if (coalesce == d->coalesceNotifications)
+        return;
+
+    d->coalesceNotifications = coalesce;
+    if (!coalesce && d->notificationsPosted)
+        d->flushNotifications();
+}
+
 bool QQmlOpenMetaObject::autoCreatesProperties() const
 {
     return d->autoCreate;
@@ -66,6 +66,7 @@ public:
     QVariant value(int) const;
     void setValue(int, const QVariant &);
     QVariant &valueRef(const QByteArray &);
+    QVariant &valueRef(int);
     bool hasValue(int) const;
 
     int count() const;
@@ -78,6 +79,9 @@ public:
     // longer automatically called for new properties.
     void setCached(bool);
 
+    bool coalescesNotifications() const;
+    void setCoalescesNotifications(bool coalesce);
+
     bool autoCreatesProperties() const;
     void setAutoCreatesProperties(bool autoCreate);
 
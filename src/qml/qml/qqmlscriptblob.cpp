@@ -111,6 +111,7 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
         }
     }
 
+    executableUnit->shareUnitData();
     initializeFromCompilationUnit(executableUnit);
 }
 
@@ -767,6 +767,9 @@ void QQmlTypeData::compile(const QQmlRefPointer<QQmlTypeNameCache> &typeNameCach
             qCDebug(DBG_DISK_CACHE) << "Error saving cached version of" << m_compiledData->fileName() << "to disk:" << errorString;
         }
     }
+
+    // If we didn't end up with a mapped cache file, other engines may hold the same unit.
+    m_compiledData->shareUnitData();
 }
 
 void QQmlTypeData::resolveTypes()
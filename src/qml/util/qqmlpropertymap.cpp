@@ -17,6 +17,8 @@ class QQmlPropertyMapMetaObject : public QQmlOpenMetaObject
 public:
     QQmlPropertyMapMetaObject(QQmlPropertyMap *obj, QQmlPropertyMapPrivate *objPriv, const QMetaObject *staticMetaObject);
 
+    using QQmlOpenMetaObject::checkedSetValue;
+
 protected:
     QVariant propertyWriteValue(int, const QVariant &) override;
     void propertyWritten(int index) override;
@@ -35,6 +37,7 @@ class QQmlPropertyMapPrivate : public QObjectPrivate
 public:
     QQmlPropertyMapMetaObject *mo;
     QStringList keys;
+    QHash<QString, int> keyIndex;
 
     QVariant updateValue(const QString &key, const QVariant &input);
     void emitChanged(const QString &key, const QVariant &value);
@@ -88,9 +91,12 @@ void QQmlPropertyMapMetaObject::propertyWritten(int index)
     priv->emitChanged(priv->propertyName(index), value(index));
 }
 
-void QQmlPropertyMapMetaObject::propertyCreated(int, QMetaPropertyBuilder &b)
+void QQmlPropertyMapMetaObject::propertyCreated(int index, QMetaPropertyBuilder &b)
 {
-    priv->keys.append(QString::fromUtf8(b.name()));
+    Q_ASSERT(index == priv->keys.size());
+    const QString key = QString::fromUtf8(b.name());
+    priv->keyIndex.insert(key, index);
+    priv->keys.append(key);
 }
 
 /*!
@@ -126,6 +132,10 @@ void QQmlPropertyMapMetaObject::propertyCreated(int, QMetaPropertyBuilder &b)
     The binding is dynamic - whenever a key's value is updated, anything bound to that
     key will be updated as well.
 
+    By default, bindings are notified as soon as a value changes. If the values in the map are
+    updated frequently, for example from a data feed, call setNotificationsCoalesced() to
+    notify bindings only once per pass of the event loop, no matter how often a value changed.
+
     To detect value changes made in the UI layer you can connect to the valueChanged() signal.
     However, note that valueChanged() is \b NOT emitted when changes are made by calling insert()
     or clear() - it is only emitted when a value is updated from QML.
@@ -163,7 +173,10 @@ QQmlPropertyMap::~QQmlPropertyMap()
 void QQmlPropertyMap::clear(const QString &key)
 {
     Q_D(QQmlPropertyMap);
-    if (d->validKeyName(key))
+    const auto it = d->keyIndex.constFind(key);
+    if (it != d->keyIndex.constEnd())
+        d->mo->checkedSetValue(*it, QVariant(), false);
+    else if (d->validKeyName(key))
         d->mo->setValue(key.toUtf8(), QVariant());
 }
 
@@ -192,7 +205,8 @@ void QQmlPropertyMap::freeze()
 QVariant QQmlPropertyMap::value(const QString &key) const
 {
     Q_D(const QQmlPropertyMap);
-    return d->mo->value(key.toUtf8());
+    const auto it = d->keyIndex.constFind(key);
+    return it == d->keyIndex.constEnd() ? QVariant() : d->mo->value(*it);
 }
 
 /*!
@@ -204,7 +218,10 @@ void QQmlPropertyMap::insert(const QString &key, const QVariant &value)
 {
     Q_D(QQmlPropertyMap);
 
-    if (d->validKeyName(key)) {
+    const auto it = d->keyIndex.constFind(key);
+    if (it != d->keyIndex.constEnd()) {
+        d->mo->checkedSetValue(*it, value, false);
+    } else if (d->validKeyName(key)) {
         d->mo->setValue(key.toUtf8(), value);
     } else {
         qWarning() << "Creating property with name"
@@ -227,9 +244,14 @@ void QQmlPropertyMap::insert(const QVariantHash &values)
 {
     Q_D(QQmlPropertyMap);
 
-    QHash<QByteArray, QVariant> checkedValues;
+    // Existing keys are updated in place. New ones are collected, so that the meta object
+    // only has to be rebuilt once.
+    QHash<QByteArray, QVariant> newValues;
     for (auto it = values.begin(), end = values.end(); it != end; ++it) {
         const QString &key = it.key();
+        if (d->keyIndex.contains(key))
+            continue;
+
         if (!d->validKeyName(key)) {
             qWarning() << "Creating property with name"
                        << key
@@ -237,10 +259,52 @@ void QQmlPropertyMap::insert(const QVariantHash &values)
             return;
         }
 
-        checkedValues.insert(key.toUtf8(), it.value());
+        newValues.insert(key.toUtf8(), it.value());
     }
-    d->mo->setValues(checkedValues);
 
+    if (newValues.size() < values.size()) {
+        for (auto it = values.begin(), end = values.end(); it != end; ++it) {
+            const auto index = d->keyIndex.constFind(it.key());
+            if (index != d->keyIndex.constEnd())
+                d->mo->checkedSetValue(*index, it.value(), false);
+        }
+    }
+
+    if (!newValues.isEmpty())
+        d->mo->setValues(newValues);
+}
+
+/*!
+    \since 6.5
+
+    Returns whether change notifications for the values in this map are coalesced.
+
+    \sa setNotificationsCoalesced()
+*/
+bool QQmlPropertyMap::notificationsCoalesced() const
+{
+    Q_D(const QQmlPropertyMap);
+    return d->mo->coalescesNotifications();
+}
+
+/*!
+    \since 6.5
+
+    If \a coalesced is \c true, changing a value doesn't notify bindings on that value
+    immediately. Instead, every value that has changed notifies its bindings once, on the next
+    pass of the event loop. This avoids re-evaluating bindings many times when values are
+    updated more often than the UI can reflect.
+
+    Setting \a coalesced to \c false delivers any pending notifications immediately.
+
+    The valueChanged() signal is not affected by this setting.
+
+    By default, notifications are not coalesced.
+*/
+void QQmlPropertyMap::setNotificationsCoalesced(bool coalesced)
+{
+    Q_D(QQmlPropertyMap);
+    d->mo->setCoalescesNotifications(coalesced);
 }
 
 /*!
@@ -297,7 +361,7 @@ bool QQmlPropertyMap::isEmpty() const
 bool QQmlPropertyMap::contains(const QString &key) const
 {
     Q_D(const QQmlPropertyMap);
-    return d->keys.contains(key);
+    return d->keyIndex.contains(key);
 }
 
 /*!
@@ -312,13 +376,15 @@ bool QQmlPropertyMap::contains(const QString &key) const
 */
 QVariant &QQmlPropertyMap::operator[](const QString &key)
 {
-    //### optimize
     Q_D(QQmlPropertyMap);
-    QByteArray utf8key = key.toUtf8();
-    if (!d->keys.contains(key))
+    auto it = d->keyIndex.constFind(key);
+    if (it == d->keyIndex.constEnd()) {
         insert(key, QVariant());//force creation -- needed below
+        it = d->keyIndex.constFind(key);
+        Q_ASSERT(it != d->keyIndex.constEnd());
+    }
 
-    return d->mo->valueRef(utf8key);
+    return d->mo->valueRef(*it);
 }
 
 /*!
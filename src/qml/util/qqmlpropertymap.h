@@ -28,6 +28,9 @@ public:
     void clear(const QString &key);
     void freeze();
 
+    bool notificationsCoalesced() const;
+    void setNotificationsCoalesced(bool coalesced);
+
     Q_INVOKABLE QStringList keys() const;
 
     int count() const;
@@ -1716,14 +1716,16 @@ void QQmlJSCodeGenerator::generate_DefineArray(int argc, int args)
         return;
     }
 
-    if (stored->accessSemantics() != QQmlJSScope::AccessSemantics::Sequence) {
-        // This rejects any attempt to store the list into a QVariant.
-        // Therefore, we don't have to adjust the contained type below.
+    const bool storedInVariant = m_typeResolver->equals(stored, m_typeResolver->varType());
+    if (!storedInVariant && stored->accessSemantics() != QQmlJSScope::AccessSemantics::Sequence) {
         reject(u"storing an array in a non-sequence type"_s);
         return;
     }
 
-    const QQmlJSScope::ConstPtr value = stored->valueType();
+    // The type propagator has determined QVariantList as contained type for non-empty arrays.
+    // If that gets stored in a QVariant, we wrap the list.
+    const QQmlJSScope::ConstPtr list = storedInVariant ? m_typeResolver->variantListType() : stored;
+    const QQmlJSScope::ConstPtr value = list->valueType();
     Q_ASSERT(value);
 
     QStringList initializer;
@@ -1732,17 +1734,38 @@ void QQmlJSCodeGenerator::generate_DefineArray(int argc, int args)
                                   registerVariable(args + i));
     }
 
-    m_body += m_state.accumulatorVariableOut + u" = "_s + stored->internalName() + u'{';
-    m_body += initializer.join(u", "_s);
-    m_body += u"};\n";
+    const QString literal = list->internalName() + u'{' + initializer.join(u", "_s) + u'}';
+    m_body += m_state.accumulatorVariableOut + u" = "_s;
+    m_body += storedInVariant ? (u"QVariant::fromValue("_s + literal + u')') : literal;
+    m_body += u";\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_DefineObjectLiteral(int internalClassId, int argc, int args)
 {
-    Q_UNUSED(internalClassId)
-    Q_UNUSED(argc)
-    Q_UNUSED(args)
-    reject(u"DefineObjectLiteral"_s);
+    INJECT_TRACE_INFO(generate_DefineObjectLiteral);
+
+    const int classSize = m_jsUnitGenerator->jsClassSize(internalClassId);
+    Q_ASSERT(argc == classSize);
+
+    const QQmlJSScope::ConstPtr jsValue = m_typeResolver->jsValueType();
+    const QQmlJSScope::ConstPtr stored = m_state.accumulatorOut().storedType();
+
+    // Build a JavaScript object, rather than a QVariantMap. A map would sort its keys and be
+    // copied on every assignment, where JavaScript keeps the order in which the members are
+    // defined and shares the object between all references.
+    m_body += u"{\n"_s;
+    m_body += u"QJSValue object = aotContext->engine->newObject();\n"_s;
+    for (int i = 0; i < classSize; ++i) {
+        m_body += u"object.setProperty("_s
+                + QQmlJSUtils::toLiteral(m_jsUnitGenerator->jsClassMember(internalClassId, i))
+                + u", "_s
+                + conversion(registerType(args + i).storedType(), jsValue,
+                             registerVariable(args + i))
+                + u");\n"_s;
+    }
+    m_body += m_state.accumulatorVariableOut + u" = "_s
+            + conversion(jsValue, stored, u"std::move(object)"_s) + u";\n"_s;
+    m_body += u"}\n"_s;
 }
 
 void QQmlJSCodeGenerator::generate_CreateClass(int classIndex, int heritage, int computedNames)
@@ -155,6 +155,9 @@ public:
         , m_logger(logger)
     {}
 
+    // The name of the instruction that caused the first error, if any
+    QString errorInstruction() const { return m_errorInstruction; }
+
 protected:
     const QV4::Compiler::JSUnitGenerator *m_jsUnitGenerator = nullptr;
     const QQmlJSTypeResolver *m_typeResolver = nullptr;
@@ -162,6 +165,7 @@ protected:
 
     const Function *m_function = nullptr;
     QQmlJS::DiagnosticMessage *m_error = nullptr;
+    QString m_errorInstruction;
 
     State initialState(const Function *function)
     {
@@ -218,6 +222,30 @@ protected:
         return item->location;
     }
 
+    QString instructionName(int instructionOffset) const
+    {
+        Q_ASSERT(m_function);
+        if (instructionOffset < 0 || instructionOffset >= m_function->code.size())
+            return QString();
+
+        using Type = QV4::Moth::Instr::Type;
+        const Type type = QV4::Moth::Instr::unpack(
+                    reinterpret_cast<const uchar *>(m_function->code.constData())
+                    + instructionOffset);
+
+#define QQMLJS_INSTRUCTION_NAME(instr) \
+        case Type::instr: \
+        case Type::instr##_Wide: \
+            return QStringLiteral(#instr);
+
+        switch (type) {
+        FOR_EACH_MOTH_INSTR_ALL(QQMLJS_INSTRUCTION_NAME)
+        }
+#undef QQMLJS_INSTRUCTION_NAME
+
+        return QString();
+    }
+
     QQmlJS::SourceLocation currentSourceLocation() const
     {
         return sourceLocation(currentInstructionOffset());
@@ -230,6 +258,7 @@ protected:
             return;
         m_error->message = message;
         m_error->loc = sourceLocation(instructionOffset);
+        m_errorInstruction = instructionName(instructionOffset);
     }
 
     void setError(const QString &message)
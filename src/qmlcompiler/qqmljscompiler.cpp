@@ -17,6 +17,8 @@
 
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qloggingcategory.h>
 
 #include <limits>
@@ -674,7 +676,10 @@ std::variant<QQmlJSAotFunction, QQmlJS::DiagnosticMessage> QQmlJSAotCompiler::co
     QQmlJS::DiagnosticMessage error;
     const QString name = m_document->stringAt(irBinding.propertyNameIndex);
     QQmlJSCompilePass::Function function = initializer.run(context, name, irBinding, &error);
-    const QQmlJSAotFunction aotFunction = doCompile(context, &function, &error);
+    QString rejectedInstruction;
+    const QQmlJSAotFunction aotFunction = doCompile(context, &function, &error,
+                                                    &rejectedInstruction);
+    recordCoverage(error, rejectedInstruction);
 
     if (error.isValid()) {
         // If it's a signal and the function just returns a closure, it's harmless.
@@ -698,7 +703,10 @@ std::variant<QQmlJSAotFunction, QQmlJS::DiagnosticMessage> QQmlJSAotCompiler::co
     QQmlJS::DiagnosticMessage error;
     const QString name = m_document->stringAt(irFunction.nameIndex);
     QQmlJSCompilePass::Function function = initializer.run(context, name, irFunction, &error);
-    const QQmlJSAotFunction aotFunction = doCompile(context, &function, &error);
+    QString rejectedInstruction;
+    const QQmlJSAotFunction aotFunction = doCompile(context, &function, &error,
+                                                    &rejectedInstruction);
+    recordCoverage(error, rejectedInstruction);
 
     if (error.isValid())
         return diagnose(error.message, QtWarningMsg, error.loc);
@@ -734,18 +742,19 @@ QQmlJSAotFunction QQmlJSAotCompiler::globalCode() const
 
 QQmlJSAotFunction QQmlJSAotCompiler::doCompile(
         const QV4::Compiler::Context *context, QQmlJSCompilePass::Function *function,
-        QQmlJS::DiagnosticMessage *error)
+        QQmlJS::DiagnosticMessage *error, QString *rejectedInstruction)
 {
-    const auto compileError = [&]() {
+    const auto compileError = [&](const QQmlJSCompilePass &pass) {
         Q_ASSERT(error->isValid());
         error->type = context->returnsClosure ? QtDebugMsg : QtWarningMsg;
+        *rejectedInstruction = pass.errorInstruction();
         return QQmlJSAotFunction();
     };
 
     QQmlJSTypePropagator propagator(m_unitGenerator, &m_typeResolver, m_logger);
     auto typePropagationResult = propagator.run(function, error);
     if (error->isValid())
-        return compileError();
+        return compileError(propagator);
 
     QQmlJSBasicBlocks basicBlocks(m_unitGenerator, &m_typeResolver, m_logger);
     typePropagationResult = basicBlocks.run(function, typePropagationResult);
@@ -753,20 +762,63 @@ QQmlJSAotFunction QQmlJSAotCompiler::doCompile(
     QQmlJSShadowCheck shadowCheck(m_unitGenerator, &m_typeResolver, m_logger);
     shadowCheck.run(&typePropagationResult, function, error);
     if (error->isValid())
-        return compileError();
+        return compileError(shadowCheck);
 
     // Generalize all arguments, registers, and the return type.
     QQmlJSStorageGeneralizer generalizer(
                 m_unitGenerator, &m_typeResolver, m_logger);
     typePropagationResult = generalizer.run(typePropagationResult, function, error);
     if (error->isValid())
-        return compileError();
+        return compileError(generalizer);
 
     QQmlJSCodeGenerator codegen(
                 context, m_unitGenerator, &m_typeResolver, m_logger,
                 m_entireSourceCodeLines);
     QQmlJSAotFunction result = codegen.run(function, &typePropagationResult, error);
-    return error->isValid() ? compileError() : result;
+    return error->isValid() ? compileError(codegen) : result;
+}
+
+void QQmlJSAotCompiler::recordCoverage(
+        const QQmlJS::DiagnosticMessage &error, const QString &instruction)
+{
+    if (!m_coverage)
+        return;
+
+    if (!error.isValid()) {
+        ++m_coverage->compiled;
+        return;
+    }
+
+    ++m_coverage->rejected;
+
+    // Errors not caused by a specific instruction are reported by the function initializer,
+    // mostly about the function's signature.
+    ++m_coverage->rejectionsByInstruction[instruction.isEmpty() ? u"<signature>"_s : instruction];
+}
+
+void QQmlJSBytecodeCoverage::merge(const QQmlJSBytecodeCoverage &other)
+{
+    compiled += other.compiled;
+    rejected += other.rejected;
+    for (auto it = other.rejectionsByInstruction.constBegin(),
+         end = other.rejectionsByInstruction.constEnd(); it != end; ++it) {
+        rejectionsByInstruction[it.key()] += it.value();
+    }
+}
+
+QByteArray QQmlJSBytecodeCoverage::toJson() const
+{
+    QJsonObject byInstruction;
+    for (auto it = rejectionsByInstruction.constBegin(), end = rejectionsByInstruction.constEnd();
+         it != end; ++it) {
+        byInstruction.insert(it.key(), it.value());
+    }
+
+    QJsonObject result;
+    result.insert(u"compiled"_s, compiled);
+    result.insert(u"rejected"_s, rejected);
+    result.insert(u"rejectionsByInstruction"_s, byInstruction);
+    return QJsonDocument(result).toJson();
 }
 
 QT_END_NAMESPACE
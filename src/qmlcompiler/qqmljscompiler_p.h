@@ -16,6 +16,7 @@
 
 #include <private/qtqmlcompilerexports_p.h>
 
+#include <QtCore/qhash.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qloggingcategory.h>
@@ -53,6 +54,18 @@ struct Q_QMLCOMPILER_PRIVATE_EXPORT QQmlJSAotFunction
     QString returnType;
 };
 
+struct Q_QMLCOMPILER_PRIVATE_EXPORT QQmlJSBytecodeCoverage
+{
+    int compiled = 0;
+    int rejected = 0;
+
+    // Number of rejected bindings and functions, by the instruction that caused the rejection
+    QHash<QString, int> rejectionsByInstruction;
+
+    void merge(const QQmlJSBytecodeCoverage &other);
+    QByteArray toJson() const;
+};
+
 class Q_QMLCOMPILER_PRIVATE_EXPORT QQmlJSAotCompiler
 {
 public:
@@ -70,6 +83,8 @@ public:
 
     virtual QQmlJSAotFunction globalCode() const;
 
+    void setBytecodeCoverage(QQmlJSBytecodeCoverage *coverage) { m_coverage = coverage; }
+
 protected:
     virtual QQmlJS::DiagnosticMessage diagnose(
             const QString &message, QtMsgType type, const QQmlJS::SourceLocation &location) const;
@@ -87,11 +102,13 @@ protected:
 
     QQmlJSImporter *m_importer = nullptr;
     QQmlJSLogger *m_logger = nullptr;
+    QQmlJSBytecodeCoverage *m_coverage = nullptr;
 
 private:
     QQmlJSAotFunction doCompile(
             const QV4::Compiler::Context *context, QQmlJSCompilePass::Function *function,
-            QQmlJS::DiagnosticMessage *error);
+            QQmlJS::DiagnosticMessage *error, QString *rejectedInstruction);
+    void recordCoverage(const QQmlJS::DiagnosticMessage &error, const QString &instruction);
 };
 
 
@@ -38,6 +38,7 @@ void QQmlJSImporter::readQmltypes(
         const QString &filename, QHash<QString, QQmlJSExportedScope> *objects,
         QList<QQmlDirParser::Import> *dependencies)
 {
+    m_dependencyFiles.insert(filename);
     const QFileInfo fileInfo(filename);
     if (!fileInfo.exists()) {
         m_warnings.append({
@@ -139,6 +140,7 @@ QQmlJSImporter::QQmlJSImporter(const QStringList &importPaths, QQmlJSResourceFil
 QQmlJSImporter::Import QQmlJSImporter::readQmldir(const QString &path)
 {
     Import result;
+    m_dependencyFiles.insert(path + SlashQmldir);
     auto reader = createQmldirParserForFile(path + SlashQmldir);
     result.name = reader.typeNamespace();
 #if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
@@ -239,6 +241,7 @@ QQmlJSImporter::Import QQmlJSImporter::readDirectory(const QString &directory)
         return import;
     }
 
+    m_dependencyFiles.insert(directory);
     QDirIterator it {
         directory,
         QStringList() << QLatin1String("*.qml"),
@@ -719,6 +722,9 @@ bool QQmlJSImporter::importHelper(const QString &module, AvailableTypes *types,
             return typesFromCache;
         }
 
+        if (!qmldirPath.isEmpty())
+            m_dependencyFiles.insert(qmldirPath);
+
         const QFileInfo file(qmldirPath);
         if (file.exists()) {
             const auto import = readQmldir(file.canonicalPath());
@@ -773,6 +779,16 @@ QQmlJSImporter::ImportedTypes QQmlJSImporter::importDirectory(
     return types.qmlNames;
 }
 
+QStringList QQmlJSImporter::dependencyFiles() const
+{
+    QSet<QString> result = m_dependencyFiles;
+    for (auto it = m_importedFiles.keyBegin(), end = m_importedFiles.keyEnd(); it != end; ++it)
+        result.insert(*it);
+    QStringList sorted = result.values();
+    sorted.sort();
+    return sorted;
+}
+
 void QQmlJSImporter::setImportPaths(const QStringList &importPaths)
 {
     m_importPaths = importPaths;
@@ -20,6 +20,8 @@
 #include "qqmljsresourcefilemapper_p.h"
 #include <QtQml/private/qqmldirparser_p.h>
 
+#include <QtCore/qset.h>
+
 #include <memory>
 
 QT_BEGIN_NAMESPACE
@@ -66,6 +68,11 @@ public:
         return result;
     }
 
+    // All qmldir, qmltypes and QML files, as well as the directories, the importer has looked at.
+    // Paths that were probed but didn't exist are included since their appearance would change
+    // the result of an import.
+    QStringList dependencyFiles() const;
+
     QStringList importPaths() const { return m_importPaths; }
     void setImportPaths(const QStringList &importPaths);
 
@@ -137,6 +144,7 @@ private:
     QHash<QString, Import> m_seenQmldirFiles;
 
     QHash<QString, QQmlJSScope::Ptr> m_importedFiles;
+    QSet<QString> m_dependencyFiles;
     QList<QQmlJS::DiagnosticMessage> m_globalWarnings;
     QList<QQmlJS::DiagnosticMessage> m_warnings;
     AvailableTypes m_builtins;
@@ -1617,11 +1617,23 @@ void QQmlJSTypePropagator::generate_DefineArray(int argc, int args)
 
 void QQmlJSTypePropagator::generate_DefineObjectLiteral(int internalClassId, int argc, int args)
 {
-    // TODO: computed property names, getters, and setters are unsupported. How do we catch them?
+    const int classSize = m_jsUnitGenerator->jsClassSize(internalClassId);
+    Q_ASSERT(argc >= classSize);
+
+    // Any arguments beyond the members of the internal class describe computed property names,
+    // getters, and setters. We don't generate code for those.
+    if (argc > classSize) {
+        setError(u"object literal with computed property names, getters, or setters"_s);
+        return;
+    }
+
+    // The literal becomes a JavaScript object, so that it keeps the order of its members and
+    // can be modified through any reference to it, just like in the interpreter.
+    const QQmlJSRegisterContent memberType
+            = m_typeResolver->tracked(m_typeResolver->globalType(m_typeResolver->jsValueType()));
+    for (int i = 0; i < classSize; ++i)
+        addReadRegister(args + i, memberType);
 
-    Q_UNUSED(internalClassId)
-    Q_UNUSED(argc)
-    Q_UNUSED(args)
     setAccumulator(m_typeResolver->globalType(m_typeResolver->jsValueType()));
 }
 
@@ -30,6 +30,8 @@ enum Message {
     SceneGraphFrame,
     MemoryAllocation,
     DebugMessage,
+    Quick3DFrame,
+    JavaScriptSample,
 
     MaximumMessage
 };
@@ -103,6 +105,8 @@ enum ProfileFeature {
     ProfileHandlingSignal,
     ProfileInputEvents,
     ProfileDebugMessages,
+    ProfileQuick3D,
+    ProfileJavaScriptSampling,
 
     MaximumProfileFeature
 };
@@ -63,7 +63,8 @@ QDataStream &operator<<(QDataStream &stream, const QQmlProfilerEventType &type);
 
 inline size_t qHash(const QQmlProfilerEventType &type)
 {
-    return qHash(type.location())
+    // JavaScript samples have no location. They are only told apart by their stacks.
+    return (type.message() == JavaScriptSample ? qHash(type.data()) : qHash(type.location()))
             ^ (((type.message() << 12) & 0xf000)                               // 4 bits message
                | ((type.rangeType() << 24) & 0xf000000)                        // 4 bits rangeType
                | ((static_cast<uint>(type.detailType()) << 28) & 0xf0000000)); // 4 bits detailType
@@ -72,7 +73,8 @@ inline size_t qHash(const QQmlProfilerEventType &type)
 inline bool operator==(const QQmlProfilerEventType &type1, const QQmlProfilerEventType &type2)
 {
     return type1.message() == type2.message() && type1.rangeType() == type2.rangeType()
-            && type1.detailType() == type2.detailType() && type1.location() == type2.location();
+            && type1.detailType() == type2.detailType() && type1.location() == type2.location()
+            && (type1.message() != JavaScriptSample || type1.data() == type2.data());
 }
 
 inline bool operator!=(const QQmlProfilerEventType &type1, const QQmlProfilerEventType &type2)
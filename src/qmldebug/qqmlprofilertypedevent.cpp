@@ -128,6 +128,18 @@ QDataStream &operator>>(QDataStream &stream, QQmlProfilerTypedEvent &event)
         event.event.setNumbers<qint64>({delta});
         break;
     }
+    case JavaScriptSample: {
+        // An aggregated stack in folded format, with the number of times it was sampled.
+        qint64 count;
+        QString stack;
+        stream >> count >> stack;
+
+        event.type = QQmlProfilerEventType(
+                    static_cast<Message>(messageType),
+                    MaximumRangeType, -1, QQmlProfilerEventLocation(), stack);
+        event.event.setNumbers<qint64>({count});
+        break;
+    }
     case RangeStart: {
         if (!stream.atEnd()) {
             qint64 typeId;
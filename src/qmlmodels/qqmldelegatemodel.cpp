@@ -24,6 +24,13 @@ QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcItemViewDelegateRecycling, "qt.qml.delegatemodel.recycling")
 
+// Posted to flush the changes that were held back by setCoalesceChanges().
+static QEvent::Type flushChangesEventType()
+{
+    static const QEvent::Type type = QEvent::Type(QEvent::registerEventType());
+    return type;
+}
+
 class QQmlDelegateModelItem;
 
 namespace QV4 {
@@ -164,6 +171,8 @@ QQmlDelegateModelPrivate::QQmlDelegateModelPrivate(QQmlContext *ctxt)
     , m_transaction(false)
     , m_incubatorCleanupScheduled(false)
     , m_waitingToFetchMore(false)
+    , m_coalesceChanges(false)
+    , m_changesScheduled(false)
     , m_cacheItems(nullptr)
     , m_items(nullptr)
     , m_persistedItems(nullptr)
@@ -1382,6 +1391,36 @@ void QQmlDelegateModelPrivate::setGroups(
     emitChanges();
 }
 
+// Lets the changes that the model reports within one pass of the event loop be sent
+// as one change set, instead of one for each signal of the model. Since the change
+// signals of the groups and of the attached objects are then sent later, this is only
+// meant for delegate models that are private to a view, which calls flushChanges()
+// before it uses the indexes of the model. changesPending() tells it when the first
+// change is held back.
+void QQmlDelegateModel::setCoalesceChanges(bool coalesce)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_coalesceChanges == coalesce)
+        return;
+    d->m_coalesceChanges = coalesce;
+    if (!coalesce)
+        flushChanges();
+}
+
+// Sends the changes that have been held back because of setCoalesceChanges().
+// Returns false if there were none.
+bool QQmlDelegateModel::flushChanges()
+{
+    Q_D(QQmlDelegateModel);
+    if (!d->m_changesScheduled)
+        return false;
+    d->m_changesScheduled = false;
+    if (d->m_transaction || !d->m_complete || !d->m_context || !d->m_context->isValid())
+        return false;
+    d->emitPendingChanges();
+    return true;
+}
+
 bool QQmlDelegateModel::event(QEvent *e)
 {
     Q_D(QQmlDelegateModel);
@@ -1392,6 +1431,8 @@ bool QQmlDelegateModel::event(QEvent *e)
         d->m_incubatorCleanupScheduled = false;
         qDeleteAll(d->m_finishedIncubating);
         d->m_finishedIncubating.clear();
+    } else if (e->type() == flushChangesEventType()) {
+        flushChanges();
     }
     return QQmlInstanceModel::event(e);
 }
@@ -1799,6 +1840,26 @@ void QQmlDelegateModelPrivate::emitChanges()
     if (m_transaction || !m_complete || !m_context || !m_context->isValid())
         return;
 
+    if (m_coalesceChanges && !m_reset) {
+        // Let the changes of the model signals that arrive in the same event loop pass add
+        // up in the change sets of the groups, which merge adjacent inserts, removes and
+        // moves, and send them all at once. The view polishes when it is told about the
+        // first one, which is where it takes changes into use, and flushes them before.
+        if (!m_changesScheduled) {
+            Q_Q(QQmlDelegateModel);
+            m_changesScheduled = true;
+            QCoreApplication::postEvent(q, new QEvent(flushChangesEventType()));
+            emit q->changesPending(QQmlDelegateModel::QPrivateSignal());
+        }
+        return;
+    }
+
+    emitPendingChanges();
+}
+
+void QQmlDelegateModelPrivate::emitPendingChanges()
+{
+    m_changesScheduled = false;
     m_transaction = true;
     QV4::ExecutionEngine *engine = m_context->engine()->handle();
     for (int i = 1; i < m_groupCount; ++i)
@@ -99,6 +99,9 @@ public:
 
     const QAbstractItemModel *abstractItemModel() const override;
 
+    void setCoalesceChanges(bool coalesce);
+    bool flushChanges();
+
     bool event(QEvent *) override;
 
     static QQmlDelegateModelAttached *qmlAttachedProperties(QObject *obj);
@@ -108,6 +111,7 @@ Q_SIGNALS:
     void defaultGroupsChanged();
     void rootIndexChanged();
     void delegateChanged();
+    void changesPending(QPrivateSignal);
 
 private Q_SLOTS:
     void _q_itemsChanged(int index, int count, const QVector<int> &roles);
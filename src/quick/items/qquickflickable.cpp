@@ -262,6 +262,7 @@ QQuickFlickablePrivate::QQuickFlickablePrivate()
     , boundsMovement(QQuickFlickable::FollowBoundsBehavior)
     , rebound(nullptr)
 {
+    hitTestLimitedToBounds = true;
 }
 
 void QQuickFlickablePrivate::init()
@@ -528,6 +528,13 @@ qreal QQuickImage::paintedHeight() const
     Note that this property is only valid for images read from the
     local filesystem.  Images loaded via a network resource (e.g. HTTP)
     are always loaded asynchronously.
+
+    Local images are decoded by a pool of threads. Images that are inside
+    the window and not clipped away by their parents are decoded first,
+    for example before the ones in the cacheBuffer of a ListView. The size
+    of the pool defaults to half the number of CPU cores, up to 8, and can
+    be set with the \c QML_IMAGE_DECODER_THREADS environment variable.
+    Setting it to 0 decodes all images on a single loader thread.
 */
 
 /*!
@@ -536,6 +543,14 @@ qreal QQuickImage::paintedHeight() const
     Specifies whether the image should be cached. The default value is
     true. Setting \a cache to false is useful when dealing with large images,
     to make sure that they aren't cached at the expense of small 'ui element' images.
+
+    Independently of this property, decoded local images can be kept on disk
+    between runs of the application, so that they do not need to be decoded
+    and scaled again. Set the \c QML_IMAGE_DISK_CACHE environment variable to
+    \c 1 to enable this. The cache is stored in \c QML_IMAGE_DISK_CACHE_PATH,
+    by default a \c qmlimagecache directory in the application's cache
+    location. It is kept below \c QML_IMAGE_DISK_CACHE_SIZE megabytes,
+    512 by default, by removing the entries that were used least recently.
 */
 
 /*!
@@ -41,6 +41,44 @@ bool QQuickImageBasePrivate::updateDevicePixelRatio(qreal targetDevicePixelRatio
     return setDevicePixelRatio;
 }
 
+// Images that are scrolled out of sight, like the ones in a view's cacheBuffer, can wait
+// until the visible ones have been loaded.
+QQuickPixmap::LoadPriority QQuickImageBasePrivate::loadPriority() const
+{
+    Q_Q(const QQuickImageBase);
+    if (!window || !effectiveVisible)
+        return QQuickPixmap::LowPriority;
+
+    QRectF visibleRect(QPointF(), window->size());
+    for (QQuickItem *parent = parentItem; parent && !visibleRect.isEmpty(); parent = parent->parentItem()) {
+        if (parent->clip())
+            visibleRect &= parent->mapRectToScene(parent->clipRect());
+    }
+
+    const QRectF sceneRect = q->mapRectToScene(QRectF(0, 0, q->width(), q->height()));
+    const bool inView = sceneRect.isEmpty() ? visibleRect.contains(sceneRect.topLeft())
+                                            : visibleRect.intersects(sceneRect);
+    return inView ? QQuickPixmap::HighPriority : QQuickPixmap::LowPriority;
+}
+
+// Has transformChanged() called while a load is pending, also when an ancestor moves,
+// so that the priority follows the image when it is scrolled into or out of view.
+void QQuickImageBasePrivate::observeSceneTransform()
+{
+    for (QQuickItem *parent = parentItem; parent; parent = parent->parentItem())
+        QQuickItemPrivate::get(parent)->subtreeTransformChangedEnabled = true;
+}
+
+bool QQuickImageBasePrivate::transformChanged(QQuickItem *transformedItem)
+{
+    Q_Q(QQuickImageBase);
+    const bool loading = pix.isLoading();
+    if (loading && window)
+        q->polish();
+    // Returning false once loading is done lets the ancestors stop visiting this subtree.
+    return QQuickImplicitSizeItemPrivate::transformChanged(transformedItem) || loading;
+}
+
 QQuickImageBase::QQuickImageBase(QQuickItem *parent)
 : QQuickImplicitSizeItem(*(new QQuickImageBasePrivate), parent)
 {
@@ -333,6 +371,8 @@ void QQuickImageBase::loadPixmap(const QUrl &url, LoadPixmapOptions loadOptions)
         d->pix.connectFinished(this, thisRequestFinished);
         d->pix.connectDownloadProgress(this, thisRequestProgress);
         update(); //pixmap may have invalidated texture, updatePaintNode needs to be called before the next repaint
+        polish(); // to prioritize the request once the item has been positioned
+        d->observeSceneTransform();
     } else {
         requestFinished();
     }
@@ -414,10 +454,23 @@ void QQuickImageBase::itemChange(ItemChange change, const ItemChangeData &value)
             if (d->devicePixelRatio == oldDpr)
                 d->updateDevicePixelRatio(value.realValue);
         }
+    } else if ((change == ItemVisibleHasChanged || change == ItemParentHasChanged)
+               && d->pix.isLoading()) {
+        polish();
+        if (change == ItemParentHasChanged)
+            d->observeSceneTransform();
     }
     QQuickItem::itemChange(change, value);
 }
 
+void QQuickImageBase::updatePolish()
+{
+    Q_D(QQuickImageBase);
+    if (d->pix.isLoading())
+        d->pix.setLoadPriority(d->loadPriority());
+    QQuickItem::updatePolish();
+}
+
 void QQuickImageBase::componentComplete()
 {
     Q_D(QQuickImageBase);
@@ -40,9 +40,13 @@ public:
         mirrorVertically(false),
         oldAutoTransform(false)
     {
+        hitTestLimitedToBounds = true;
     }
 
     virtual bool updateDevicePixelRatio(qreal targetDevicePixelRatio);
+    QQuickPixmap::LoadPriority loadPriority() const;
+    void observeSceneTransform();
+    bool transformChanged(QQuickItem *transformedItem) override;
 
     QQuickPixmap pix;
     QQuickImageBase::Status status;
@@ -33,6 +33,7 @@
 #include <private/qqmlopenmetaobject_p.h>
 #include <QtQuick/private/qquickstate_p.h>
 #include <private/qquickitem_p.h>
+#include <QtQuick/private/qquickitemhitindex_p.h>
 #include <QtQuick/private/qquickaccessibleattached_p.h>
 #include <QtQuick/private/qquickhoverhandler_p.h>
 #include <QtQuick/private/qquickpointerhandler_p.h>
@@ -2882,6 +2883,8 @@ QList<QQuickItem *> QQuickItemPrivate::paintOrderChildItems() const
         }
     }
     if (haveZ) {
+        for (int i = 0; i < childItems.count(); ++i)
+            QQuickItemPrivate::get(childItems.at(i))->childSequence = i;
         sortedChildItems = new QList<QQuickItem*>(childItems);
         std::stable_sort(sortedChildItems->begin(), sortedChildItems->end(), itemZOrder_sort);
         return *sortedChildItems;
@@ -2892,6 +2895,134 @@ QList<QQuickItem *> QQuickItemPrivate::paintOrderChildItems() const
     return childItems;
 }
 
+// The first item in the sorted children that does not go before a child with
+// the given z and childSequence. The z of \a moved, if it is among them, is
+// taken to be \a movedZ, because setZ() has already changed it.
+static QList<QQuickItem *>::const_iterator lowerBoundInPaintOrder(const QList<QQuickItem *> &sorted,
+                                                                 qreal z, int sequence,
+                                                                 const QQuickItem *moved = nullptr,
+                                                                 qreal movedZ = 0)
+{
+    return std::lower_bound(sorted.cbegin(), sorted.cend(), z,
+                            [sequence, moved, movedZ](QQuickItem *item, qreal value) {
+        const qreal itemZ = item == moved ? movedZ : item->z();
+        return itemZ < value || (itemZ == value && QQuickItemPrivate::get(item)->childSequence < sequence);
+    });
+}
+
+/*!
+    \internal
+    Returns the index of \a child in sortedChildItems, given that its z was \a z
+    when it was put there. Children with the same z are in the order of their
+    childSequence, so this only takes a binary search.
+*/
+qsizetype QQuickItemPrivate::sortedChildIndex(QQuickItem *child, qreal z) const
+{
+    const int sequence = QQuickItemPrivate::get(child)->childSequence;
+    auto it = lowerBoundInPaintOrder(*sortedChildItems, z, sequence, child, z);
+    Q_ASSERT(it != sortedChildItems->cend() && *it == child);
+    return it - sortedChildItems->cbegin();
+}
+
+/*!
+    \internal
+    Puts \a child, which has just been appended to childItems, into
+    sortedChildItems, instead of sorting all children again.
+*/
+void QQuickItemPrivate::insertSortedChild(QQuickItem *child)
+{
+    if (!sortedChildItems || sortedChildItems == &childItems) {
+        markSortedChildrenDirty(child);
+        return;
+    }
+
+    const int count = childItems.count();
+    const int previousSequence = count > 1
+            ? QQuickItemPrivate::get(childItems.at(count - 2))->childSequence : -1;
+    if (previousSequence == std::numeric_limits<int>::max()) {
+        delete sortedChildItems;
+        sortedChildItems = nullptr;
+        return;
+    }
+    QQuickItemPrivate::get(child)->childSequence = previousSequence + 1;
+
+    // It comes after all siblings with the same z.
+    const qreal z = child->z();
+    auto it = std::upper_bound(sortedChildItems->cbegin(), sortedChildItems->cend(), z,
+            [](qreal value, QQuickItem *item) { return value < item->z(); });
+    sortedChildItems->insert(it - sortedChildItems->cbegin(), child);
+}
+
+/*!
+    \internal
+    Takes \a child, which has just been removed from childItems, out of
+    sortedChildItems, instead of sorting the remaining children again.
+*/
+void QQuickItemPrivate::removeSortedChild(QQuickItem *child)
+{
+    if (!sortedChildItems || sortedChildItems == &childItems) {
+        markSortedChildrenDirty(child);
+        return;
+    }
+
+    sortedChildItems->removeAt(sortedChildIndex(child, child->z()));
+}
+
+/*!
+    \internal
+    Moves \a child, whose z has changed from \a oldZ, to its new place in
+    sortedChildItems, instead of sorting all children again.
+*/
+void QQuickItemPrivate::restackSortedChild(QQuickItem *child, qreal oldZ)
+{
+    if (!sortedChildItems || sortedChildItems == &childItems) {
+        markSortedChildrenDirty(child);
+        return;
+    }
+
+    sortedChildItems->removeAt(sortedChildIndex(child, oldZ));
+    const qreal z = child->z();
+    const int sequence = QQuickItemPrivate::get(child)->childSequence;
+    auto it = lowerBoundInPaintOrder(*sortedChildItems, z, sequence);
+    sortedChildItems->insert(it - sortedChildItems->cbegin(), child);
+}
+
+/*!
+    \internal
+    Returns the child items in paint order, like paintOrderChildItems(), but
+    leaves out those that can not have a target of a pointer event at
+    \a scenePos, neither themselves nor any of their descendants, if there
+    are enough children to be worth keeping a QQuickItemHitIndex for.
+*/
+QList<QQuickItem *> QQuickItemPrivate::childItemsAt(const QPointF &scenePos)
+{
+    Q_Q(QQuickItem);
+    if (childItems.count() < QQuickItemHitIndex::MinimumChildCount)
+        return paintOrderChildItems();
+
+    QQuickItemHitIndex *&hitIndex = extra.value().hitIndex;
+    if (!hitIndex)
+        hitIndex = new QQuickItemHitIndex(q);
+    return hitIndex->childItemsAt(q->mapFromScene(scenePos));
+}
+
+/*!
+    \internal
+    Invalidates the hit index of this item and of any ancestor whose hit index
+    depends on the geometry of this item.
+*/
+void QQuickItemPrivate::invalidateHitIndexes()
+{
+    // Rebuilding an index marks the items it visits again, so the walk can
+    // stop at the first item that has already been through here since then.
+    for (QQuickItemPrivate *d = this; d && d->hitIndexed;
+         d = d->parentItem ? QQuickItemPrivate::get(d->parentItem) : nullptr) {
+        d->hitIndexed = false;
+        if (d->extra.isAllocated() && d->extra->hitIndex)
+            d->extra->hitIndex->invalidate();
+    }
+}
+
 void QQuickItemPrivate::addChild(QQuickItem *child)
 {
     Q_Q(QQuickItem);
@@ -2913,7 +3044,7 @@ void QQuickItemPrivate::addChild(QQuickItem *child)
         setHasHoverInChild(true);
 
     childPrivate->recursiveRefFromEffectItem(extra.value().recursiveEffectRefCount);
-    markSortedChildrenDirty(child);
+    insertSortedChild(child);
     dirty(QQuickItemPrivate::ChildrenChanged);
 
     itemChange(QQuickItem::ItemChildAddedChange, child);
@@ -2942,7 +3073,7 @@ void QQuickItemPrivate::removeChild(QQuickItem *child)
         setHasHoverInChild(false);
 
     childPrivate->recursiveRefFromEffectItem(-extra.value().recursiveEffectRefCount);
-    markSortedChildrenDirty(child);
+    removeSortedChild(child);
     dirty(QQuickItemPrivate::ChildrenChanged);
 
     itemChange(QQuickItem::ItemChildRemovedChange, child);
@@ -3181,12 +3312,15 @@ QQuickItemPrivate::QQuickItemPrivate()
     , hasCursorHandler(false)
     , maybeHasSubsceneDeliveryAgent(true)
     , subtreeTransformChangedEnabled(true)
+    , hitIndexed(false)
+    , hitTestLimitedToBounds(false)
     , dirtyAttributes(0)
     , nextDirtyItem(nullptr)
     , prevDirtyItem(nullptr)
     , window(nullptr)
     , windowRefCount(0)
     , parentItem(nullptr)
+    , childSequence(0)
     , sortedChildItems(&childItems)
     , subFocusItem(nullptr)
     , x(0)
@@ -3205,6 +3339,8 @@ QQuickItemPrivate::~QQuickItemPrivate()
 {
     if (sortedChildItems != &childItems)
         delete sortedChildItems;
+    if (extra.isAllocated())
+        delete extra->hitIndex;
 }
 
 void QQuickItemPrivate::init(QQuickItem *parent)
@@ -5149,6 +5285,10 @@ void QQuickItem::classBegin()
 {
     Q_D(QQuickItem);
     d->componentComplete = false;
+    // An Item, as opposed to a C++ subclass that shares QQuickItemPrivate. Those
+    // can only be created from QML if they have Q_OBJECT.
+    if (metaObject() == &QQuickItem::staticMetaObject)
+        d->hitTestLimitedToBounds = true;
     if (d->_stateGroup)
         d->_stateGroup->classBegin();
     if (d->_anchors)
@@ -5870,12 +6010,13 @@ void QQuickItem::setZ(qreal v)
     if (d->z() == v)
         return;
 
+    const qreal oldZ = d->z();
     d->extra.value().z = v;
 
     d->dirty(QQuickItemPrivate::ZValue);
     if (d->parentItem) {
         QQuickItemPrivate::get(d->parentItem)->dirty(QQuickItemPrivate::ChildrenStackingChanged);
-        QQuickItemPrivate::get(d->parentItem)->markSortedChildrenDirty(this);
+        QQuickItemPrivate::get(d->parentItem)->restackSortedChild(this, oldZ);
     }
 
     emit zChanged();
@@ -6469,6 +6610,9 @@ void QQuickItemPrivate::dirty(DirtyType type)
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged(q);
 
+    if (hitIndexed && (type & HitIndexUpdateMask))
+        invalidateHitIndexes();
+
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
         if (window && componentComplete) {
@@ -8308,6 +8452,8 @@ void QQuickItem::setContainmentMask(QObject *mask)
         d->extra.value().maskContains = mask->metaObject()->method(methodIndex);
     }
     d->mask = mask;
+    if (d->hitIndexed)
+        d->invalidateHitIndexes();
     quickMask = qobject_cast<QQuickItem *>(mask);
     d->quickMask = quickMask;
     if (quickMask) {
@@ -8949,6 +9095,8 @@ void QQuickItemPrivate::addPointerHandler(QQuickPointerHandler *h)
     auto &handlers = extra.value().pointerHandlers;
     if (!handlers.contains(h))
         handlers.prepend(h);
+    if (hitIndexed)
+        invalidateHitIndexes();
     auto &res = extra.value().resourcesList;
     if (!res.contains(h)) {
         res.append(h);
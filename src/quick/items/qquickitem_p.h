@@ -51,6 +51,7 @@ class QQuickLayoutMirroringAttached;
 class QQuickEnterKeyAttached;
 class QQuickScreenAttached;
 class QQuickPointerHandler;
+class QQuickItemHitIndex;
 
 class QQuickContents : public QQuickItemChangeListener
 {
@@ -388,6 +389,9 @@ public:
         // Mask contains() method
         QMetaMethod maskContains;
 
+        // Only created for items with many children, see childItemsAt()
+        QQuickItemHitIndex *hitIndex = nullptr;
+
         QObjectList resourcesList;
 
         // Although acceptedMouseButtons is inside ExtraData, we actually store
@@ -483,6 +487,13 @@ public:
     // set true if this item or any child wants QQuickItemPrivate::transformChanged() to visit all children
     // (e.g. when parent has ItemIsViewport and child has ItemObservesViewport)
     bool subtreeTransformChangedEnabled:1;
+    // set true if the geometry of this item went into the QQuickItemHitIndex of an ancestor, or itself
+    bool hitIndexed:1;
+    // set true, from its private class, by a class whose contains() accepts no points outside of
+    // the bounds, so that a QQuickItemHitIndex can leave the item out there. A subclass that shares
+    // the private class and overrides contains() to accept more points must set it false again.
+    // Items of other classes, like C++ subclasses of QQuickItem, are tested at every point.
+    bool hitTestLimitedToBounds:1;
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
@@ -513,7 +524,10 @@ public:
                                   Window,
         ComplexTransformUpdateMask     = Transform | Window,
         ContentUpdateMask       = Size | Content | Smooth | Window | Antialiasing,
-        ChildrenUpdateMask      = ChildrenChanged | ChildrenStackingChanged | EffectReference | Window
+        ChildrenUpdateMask      = ChildrenChanged | ChildrenStackingChanged | EffectReference | Window,
+        HitIndexUpdateMask      = TransformOrigin | Transform | BasicTransform | Position | Size |
+                                  ZValue | ChildrenChanged | ChildrenStackingChanged | ParentChanged |
+                                  Clip
     };
 
     quint32 dirtyAttributes;
@@ -532,15 +546,24 @@ public:
     inline QSGRenderContext *sceneGraphRenderContext() const;
 
     QQuickItem *parentItem;
+    // Orders this item after the siblings with the same z that come before it in the
+    // childItems of its parent, while the parent keeps a separate sortedChildItems.
+    int childSequence;
 
     QList<QQuickItem *> childItems;
     mutable QList<QQuickItem *> *sortedChildItems;
     QList<QQuickItem *> paintOrderChildItems() const;
+    QList<QQuickItem *> childItemsAt(const QPointF &scenePos);
+    void invalidateHitIndexes();
     void addChild(QQuickItem *);
     void removeChild(QQuickItem *);
     void siblingOrderChanged();
 
     inline void markSortedChildrenDirty(QQuickItem *child);
+    void insertSortedChild(QQuickItem *child);
+    void removeSortedChild(QQuickItem *child);
+    void restackSortedChild(QQuickItem *child, qreal oldZ);
+    qsizetype sortedChildIndex(QQuickItem *child, qreal z) const;
 
     void refWindow(QQuickWindow *);
     void derefWindow();
@@ -0,0 +1,166 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qquickitemhitindex_p.h"
+#include "qquickitem_p.h"
+
+#include <QtCore/qvarlengtharray.h>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+// Deeper subtrees are not worth following, and are tested at every point instead.
+static const int MaximumSubtreeDepth = 32;
+// The grid never gets more cells than this along either axis.
+static const int MaximumCellsPerAxis = 256;
+
+/*
+    Finds the rectangle in the coordinate system of the parent of item, outside of
+    which neither item nor any of its descendants can be a target of a pointer event.
+    Returns false if there is no such rectangle. Every item that is visited is marked,
+    so that changes to it invalidate the index.
+*/
+static bool subtreeExtent(QQuickItem *item, QRectF *extent, int depth)
+{
+    QQuickItemPrivate *d = QQuickItemPrivate::get(item);
+    d->hitIndexed = true;
+
+    if (depth > MaximumSubtreeDepth || d->mask || !d->hitTestLimitedToBounds
+            || (d->extra.isAllocated() && d->extra->subsceneDeliveryAgent)) {
+        return false;
+    }
+
+    QRectF rect(0, 0, d->width, d->height);
+    // Delivery does not look inside an item that clips unless the point is inside it.
+    if (!(d->flags & QQuickItem::ItemClipsChildrenToShape)) {
+        // A pointer handler can want points outside of its parent, e.g. because of its margin.
+        if (d->hasPointerHandlers())
+            return false;
+        for (QQuickItem *child : std::as_const(d->childItems)) {
+            QRectF childExtent;
+            if (!subtreeExtent(child, &childExtent, depth + 1))
+                return false;
+            rect |= childExtent;
+        }
+    }
+
+    QTransform transform;
+    d->itemToParentTransform(transform);
+    *extent = transform.mapRect(rect.normalized());
+    return true;
+}
+
+QList<QQuickItem *> QQuickItemHitIndex::childItemsAt(const QPointF &pos)
+{
+    if (!m_valid)
+        rebuild();
+
+    QVarLengthArray<int, 64> found(m_everywhere.cbegin(), m_everywhere.cend());
+    for (int i : std::as_const(m_large)) {
+        if (m_extents.at(i).contains(pos))
+            found.append(i);
+    }
+    if (m_bounds.contains(pos)) {
+        const int column = qBound(0, int((pos.x() - m_bounds.x()) * m_columns / m_bounds.width()), m_columns - 1);
+        const int row = qBound(0, int((pos.y() - m_bounds.y()) * m_rows / m_bounds.height()), m_rows - 1);
+        const int cell = row * m_columns + column;
+        for (int j = m_cellStart.at(cell); j < m_cellStart.at(cell + 1); ++j) {
+            const int i = m_cellItems.at(j);
+            if (m_extents.at(i).contains(pos))
+                found.append(i);
+        }
+    }
+
+    // Each child is found at most once, so sorting brings back the paint order.
+    std::sort(found.begin(), found.end());
+    QList<QQuickItem *> children;
+    children.reserve(found.size());
+    for (int i : found)
+        children.append(m_children.at(i));
+    return children;
+}
+
+void QQuickItemHitIndex::rebuild()
+{
+    QQuickItemPrivate *d = QQuickItemPrivate::get(m_item);
+    d->hitIndexed = true;
+    m_valid = true;
+
+    m_children = d->paintOrderChildItems();
+    const int count = m_children.size();
+    m_extents.fill(QRectF(), count);
+    m_everywhere.clear();
+    m_large.clear();
+    m_cellStart.clear();
+    m_cellItems.clear();
+    m_bounds = QRectF();
+
+    QList<int> bounded;
+    bounded.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QRectF extent;
+        if (!subtreeExtent(m_children.at(i), &extent, 0)) {
+            m_everywhere.append(i);
+        } else if (!extent.isEmpty()) {
+            // Leave some room for rounding in the transformations of the points that
+            // are tested. Children with an empty extent contain no point at all.
+            extent.adjust(-1, -1, 1, 1);
+            m_extents[i] = extent;
+            m_bounds |= extent;
+            bounded.append(i);
+        }
+    }
+
+    if (bounded.isEmpty()) {
+        m_columns = m_rows = 0;
+        return;
+    }
+
+    // About one child per cell, in cells that are roughly square.
+    const qreal aspect = m_bounds.width() / m_bounds.height();
+    const qreal cells = bounded.size();
+    m_columns = qBound(1, int(std::sqrt(cells * aspect)), MaximumCellsPerAxis);
+    m_rows = qBound(1, int(std::sqrt(cells / aspect)), MaximumCellsPerAxis);
+    const qreal cellWidth = m_bounds.width() / m_columns;
+    const qreal cellHeight = m_bounds.height() / m_rows;
+    const int largeCellCount = qMax(4, m_columns * m_rows / 4);
+
+    struct CellRange { int left, top, right, bottom; };
+    QList<CellRange> ranges(count);
+    m_cellStart.fill(0, m_columns * m_rows + 1);
+    for (int i : std::as_const(bounded)) {
+        const QRectF &extent = m_extents.at(i);
+        CellRange &range = ranges[i];
+        range.left = qBound(0, int((extent.left() - m_bounds.x()) / cellWidth), m_columns - 1);
+        range.right = qBound(0, int((extent.right() - m_bounds.x()) / cellWidth), m_columns - 1);
+        range.top = qBound(0, int((extent.top() - m_bounds.y()) / cellHeight), m_rows - 1);
+        range.bottom = qBound(0, int((extent.bottom() - m_bounds.y()) / cellHeight), m_rows - 1);
+        if ((range.right - range.left + 1) * (range.bottom - range.top + 1) > largeCellCount) {
+            m_large.append(i);
+            range.left = -1;
+            continue;
+        }
+        for (int row = range.top; row <= range.bottom; ++row) {
+            for (int column = range.left; column <= range.right; ++column)
+                ++m_cellStart[row * m_columns + column + 1];
+        }
+    }
+
+    for (int cell = 1; cell < m_cellStart.size(); ++cell)
+        m_cellStart[cell] += m_cellStart.at(cell - 1);
+    m_cellItems.resize(m_cellStart.last());
+
+    QList<int> next = m_cellStart;
+    for (int i : std::as_const(bounded)) {
+        const CellRange &range = ranges.at(i);
+        if (range.left < 0)
+            continue;
+        for (int row = range.top; row <= range.bottom; ++row) {
+            for (int column = range.left; column <= range.right; ++column)
+                m_cellItems[next[row * m_columns + column]++] = i;
+        }
+    }
+}
+
+QT_END_NAMESPACE
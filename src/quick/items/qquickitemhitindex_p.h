@@ -0,0 +1,77 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKITEMHITINDEX_P_H
+#define QQUICKITEMHITINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrect.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickItem;
+
+/*
+    A uniform grid over the child items of an item with many of them, which lets
+    pointer event delivery find the children that can have a target at a point
+    without visiting all of them.
+
+    Each child is entered with the extent of its subtree in the item's coordinate
+    system: the union of its own bounds and those of its descendants, or only its
+    own bounds if it clips. A child whose subtree contains an item with pointer
+    handlers, a containment mask, a class that has not set
+    QQuickItemPrivate::hitTestLimitedToBounds or anything else that can accept
+    points outside its bounds is returned for every point.
+
+    The index is rebuilt on the next query after QQuickItemPrivate::dirty() has
+    invalidated it, because the geometry, transform, stacking order or children of
+    an item that went into it changed.
+*/
+class QQuickItemHitIndex
+{
+public:
+    explicit QQuickItemHitIndex(QQuickItem *item) : m_item(item) {}
+
+    // Items with fewer children are faster to just walk through.
+    static constexpr int MinimumChildCount = 128;
+
+    void invalidate() { m_valid = false; }
+
+    // The children, in paint order, whose subtrees can contain pos, which is in
+    // the coordinate system of the item.
+    QList<QQuickItem *> childItemsAt(const QPointF &pos);
+
+private:
+    void rebuild();
+
+    QQuickItem *m_item;
+    QList<QQuickItem *> m_children;
+    QList<QRectF> m_extents;
+    // Children that are tested at every point, because their extent is not known,
+    // or covers too many cells to be worth entering in each of them.
+    QList<int> m_everywhere;
+    QList<int> m_large;
+    // The children in cell i are m_cellItems[m_cellStart[i]] up to m_cellStart[i + 1].
+    QList<int> m_cellStart;
+    QList<int> m_cellItems;
+    QRectF m_bounds;
+    int m_columns = 0;
+    int m_rows = 0;
+    bool m_valid = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKITEMHITINDEX_P_H
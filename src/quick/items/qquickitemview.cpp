@@ -184,6 +184,7 @@ void QQuickItemView::setModel(const QVariant &m)
         if (!d->ownModel) {
             d->model = new QQmlDelegateModel(qmlContext(this), this);
             d->ownModel = true;
+            static_cast<QQmlDelegateModel *>(d->model.data())->setCoalesceChanges(true);
             if (isComponentComplete())
                 static_cast<QQmlDelegateModel *>(d->model.data())->componentComplete();
         } else {
@@ -219,8 +220,11 @@ void QQuickItemView::setModel(const QVariant &m)
 
         connect(d->model, SIGNAL(modelUpdated(QQmlChangeSet,bool)),
                 this, SLOT(modelUpdated(QQmlChangeSet,bool)));
-        if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model))
+        if (QQmlDelegateModel *dataModel = qobject_cast<QQmlDelegateModel*>(d->model)) {
             QObjectPrivate::connect(dataModel, &QQmlDelegateModel::delegateChanged, d, &QQuickItemViewPrivate::applyDelegateChange);
+            if (d->ownModel)
+                connect(dataModel, &QQmlDelegateModel::changesPending, this, &QQuickItem::polish, Qt::UniqueConnection);
+        }
         emit countChanged();
     }
     emit modelChanged();
@@ -246,6 +250,7 @@ void QQuickItemView::setDelegate(QQmlComponent *delegate)
     if (!d->ownModel) {
         d->model = new QQmlDelegateModel(qmlContext(this));
         d->ownModel = true;
+        static_cast<QQmlDelegateModel *>(d->model.data())->setCoalesceChanges(true);
         if (isComponentComplete())
             static_cast<QQmlDelegateModel *>(d->model.data())->componentComplete();
     }
@@ -958,10 +963,22 @@ void QQuickItemView::forceLayout()
 void QQuickItemViewPrivate::applyPendingChanges()
 {
     Q_Q(QQuickItemView);
+    flushModelChanges();
     if (q->isComponentComplete() && currentChanges.hasPendingChanges())
         layout();
 }
 
+bool QQuickItemViewPrivate::flushModelChanges()
+{
+    // The delegate model we own holds back the changes of a burst of model
+    // signals, to send them as one. Collect them before using any indexes.
+    if (ownModel) {
+        if (QQmlDelegateModel *delegateModel = qobject_cast<QQmlDelegateModel *>(model))
+            return delegateModel->flushChanges();
+    }
+    return false;
+}
+
 int QQuickItemViewPrivate::findMoveKeyIndex(QQmlChangeSet::MoveKey key, const QVector<QQmlChangeSet::Change> &changes) const
 {
     for (int i=0; i<changes.count(); i++) {
@@ -1672,6 +1689,10 @@ void QQuickItemViewPrivate::clear(bool onDestruction)
 {
     Q_Q(QQuickItemView);
 
+    // Changes that are held back describe the items we are about to release.
+    if (!onDestruction)
+        flushModelChanges();
+
     isClearing = true;
     auto cleanup = qScopeGuard([this] { isClearing = false; });
 
@@ -1736,6 +1757,12 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
     Q_Q(QQuickItemView);
     if (!model || !model->isValid() || !q->isComponentComplete())
         return;
+    // The changes that were held back have to be applied to the visible items
+    // before any are added by index.
+    if (flushModelChanges() && !inLayout && hasPendingChanges()) {
+        layout();
+        return;
+    }
     if (!model->count()) {
         updateHeader();
         updateFooter();
@@ -1827,6 +1854,7 @@ void QQuickItemViewPrivate::layout()
     if (inLayout)
         return;
 
+    flushModelChanges();
     inLayout = true;
 
     // viewBounds contains bounds before any add/remove/move operation to the view
@@ -1948,6 +1976,7 @@ bool QQuickItemViewPrivate::applyModelChanges(ChangeResult *totalInsertionResult
     }
 
     updateUnrequestedIndexes();
+    aboutToApplyModelChanges(currentChanges.pendingChanges);
 
     FxViewItem *prevVisibleItemsFirst = visibleItems.count() ? *visibleItems.constBegin() : nullptr;
     int prevItemCount = itemCount;
@@ -2354,10 +2383,7 @@ void QQuickItemView::createdItem(int index, QObject* object)
     if (!d->inRequest) {
         d->unrequestedItems.insert(item, index);
         d->requestedIndex = -1;
-        if (d->hasPendingChanges())
-            d->layout();
-        else
-            d->refill();
+        d->refillOrLayout();
         if (d->unrequestedItems.contains(item))
             d->repositionPackageItemAt(item, index);
         else if (index == d->currentIndex)
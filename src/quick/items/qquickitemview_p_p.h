@@ -159,6 +159,7 @@ public:
     void applyDelegateChange();
 
     void applyPendingChanges();
+    bool flushModelChanges();
     bool applyModelChanges(ChangeResult *insertionResult, ChangeResult *removalResult);
     bool applyRemovalChange(const QQmlChangeSet::Change &removal, ChangeResult *changeResult, int *removedCount);
     void removeItem(FxViewItem *item, const QQmlChangeSet::Change &removal, ChangeResult *removeResult);
@@ -191,6 +192,7 @@ public:
     }
 
     void refillOrLayout() {
+        flushModelChanges();
         if (hasPendingChanges())
             layout();
         else
@@ -333,6 +335,7 @@ protected:
                 QList<FxViewItem *> *newItems, QList<MovedItem> *movingIntoView) = 0;
 
     virtual bool needsRefillForAddedOrRemovedIndex(int) const { return false; }
+    virtual void aboutToApplyModelChanges(const QQmlChangeSet &) {}
     virtual void translateAndTransitionItemsAfter(int afterIndex, const ChangeResult &insertionResult, const ChangeResult &removalResult) = 0;
 
     virtual void initializeViewItem(FxViewItem *) {}
@@ -13,6 +13,7 @@
 #include <QtCore/qmath.h>
 
 #include <private/qquicksmoothedanimation_p_p.h>
+#include <private/qquickfenwicktree_p.h>
 #include <private/qqmlcomponent_p.h>
 #include "qplatformdefs.h"
 
@@ -26,6 +27,31 @@ Q_LOGGING_CATEGORY(lcEvents, "qt.quick.listview.events")
 
 class FxListItemSG;
 
+// What is known about the sizes of a range of items: the sum of the sizes that have been
+// measured or hinted by the model, and how many of them that is.
+struct QQuickListViewItemSizes
+{
+    qreal size = 0;
+    int known = 0;
+
+    QQuickListViewItemSizes &operator+=(const QQuickListViewItemSizes &other)
+    {
+        size += other.size;
+        known += other.known;
+        return *this;
+    }
+    friend QQuickListViewItemSizes operator-(QQuickListViewItemSizes lhs, const QQuickListViewItemSizes &rhs)
+    {
+        lhs.size -= rhs.size;
+        lhs.known -= rhs.known;
+        return lhs;
+    }
+    friend bool operator==(const QQuickListViewItemSizes &lhs, const QQuickListViewItemSizes &rhs)
+    {
+        return lhs.size == rhs.size && lhs.known == rhs.known;
+    }
+};
+
 class QQuickListViewPrivate : public QQuickItemViewPrivate
 {
 public:
@@ -101,6 +127,16 @@ public:
 
     void updateAverage();
 
+    bool usesItemSizeIndex() const { return cacheItemSizes || !sizeHintRole.isEmpty(); }
+    bool hasItemSizeIndex() const;
+    void ensureItemSizes();
+    void resetItemSizes();
+    QQuickListViewItemSizes itemSizeHint(int modelIndex) const;
+    void setItemSize(int modelIndex, qreal size);
+    qreal itemsExtent(int from, int to) const;
+    int indexAtExtent(int from, qreal extent) const;
+    void aboutToApplyModelChanges(const QQmlChangeSet &changes) override;
+
     void itemGeometryChanged(QQuickItem *item, QQuickGeometryChange change, const QRectF &oldGeometry) override;
     void fixupPosition() override;
     void fixup(AxisData &data, qreal minExtent, qreal maxExtent) override;
@@ -120,6 +156,9 @@ public:
     qreal spacing;
     QQuickListView::SnapMode snapMode;
 
+    QQuickFenwickTree<QQuickListViewItemSizes> itemSizes;
+    QString sizeHintRole;
+
     QQuickListView::HeaderPositioning headerPositioning;
     QQuickListView::FooterPositioning footerPositioning;
 
@@ -151,6 +190,7 @@ public:
     bool correctFlick : 1;
     bool inFlickCorrection : 1;
     bool wantedMousePress : 1;
+    bool cacheItemSizes : 1;
 
     QQuickListViewPrivate()
         : orient(QQuickListView::Vertical)
@@ -165,6 +205,7 @@ public:
         , overshootDist(0.0), desiredViewportPosition(0.0), fixupHeaderPosition(0.0)
         , headerNeedsSeparateFixup(false), desiredHeaderVisible(false)
         , correctFlick(false), inFlickCorrection(false), wantedMousePress(false)
+        , cacheItemSizes(false)
     {
         highlightMoveDuration = -1; //override default value set in base class
     }
@@ -486,7 +527,7 @@ qreal QQuickListViewPrivate::originPosition() const
     if (!visibleItems.isEmpty()) {
         pos = (*visibleItems.constBegin())->position();
         if (visibleIndex > 0)
-            pos -= visibleIndex * (averageSize + spacing);
+            pos -= itemsExtent(0, visibleIndex);
     }
     return pos;
 }
@@ -513,9 +554,12 @@ qreal QQuickListViewPrivate::lastPosition() const
         }
         pos = (*(visibleItems.constEnd() - 1))->endPosition();
         if (invisibleCount > 0)
-            pos += invisibleCount * (averageSize + spacing);
+            pos += itemsExtent(model->count() - invisibleCount, model->count());
     } else if (model && model->count()) {
-        pos = (model->count() * averageSize + (model->count()-1) * spacing);
+        if (hasItemSizeIndex())
+            pos = itemsExtent(0, model->count()) - spacing;
+        else
+            pos = (model->count() * averageSize + (model->count()-1) * spacing);
     }
     return pos;
 }
@@ -533,10 +577,10 @@ qreal QQuickListViewPrivate::positionAt(int modelIndex) const
                 cs = currentItem->size() + spacing;
                 --count;
             }
-            return (*visibleItems.constBegin())->position() - count * (averageSize + spacing) - cs;
+            return (*visibleItems.constBegin())->position() - itemsExtent(visibleIndex - count, visibleIndex) - cs;
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(visibleItems.constEnd() - 1))->endPosition() + spacing + count * (averageSize + spacing);
+            const int lastVisibleIndex = findLastVisibleIndex(visibleIndex);
+            return (*(visibleItems.constEnd() - 1))->endPosition() + spacing + itemsExtent(lastVisibleIndex + 1, modelIndex);
         }
     }
     return 0;
@@ -548,11 +592,10 @@ qreal QQuickListViewPrivate::endPositionAt(int modelIndex) const
         return item->endPosition();
     if (!visibleItems.isEmpty()) {
         if (modelIndex < visibleIndex) {
-            int count = visibleIndex - modelIndex;
-            return (*visibleItems.constBegin())->position() - (count - 1) * (averageSize + spacing) - spacing;
+            return (*visibleItems.constBegin())->position() - itemsExtent(modelIndex + 1, visibleIndex) - spacing;
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(visibleItems.constEnd() - 1))->endPosition() + count * (averageSize + spacing);
+            const int lastVisibleIndex = findLastVisibleIndex(visibleIndex);
+            return (*(visibleItems.constEnd() - 1))->endPosition() + itemsExtent(lastVisibleIndex + 1, modelIndex);
         }
     }
     return 0;
@@ -646,6 +689,7 @@ void QQuickListViewPrivate::clear(bool onDestruction)
     releaseSectionItem(nextSectionItem);
     nextSectionItem = nullptr;
     lastVisibleSection = QString();
+    itemSizes.clear();
     QQuickItemViewPrivate::clear(onDestruction);
 }
 
@@ -720,6 +764,8 @@ bool QQuickListViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::Reu
 
 bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal bufferFrom, qreal bufferTo, bool doBuffer)
 {
+    ensureItemSizes();
+
     qreal itemEnd = visiblePos;
     if (visibleItems.count()) {
         visiblePos = (*visibleItems.constBegin())->position();
@@ -734,14 +780,15 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
         || bufferTo < visiblePos - averageSize - spacing)) {
         // We've jumped more than a page.  Estimate which items are now
         // visible and fill from there.
-        int count = (fillFrom - itemEnd) / (averageSize + spacing);
+        int count = hasItemSizeIndex() ? indexAtExtent(modelIndex, fillFrom - itemEnd) - modelIndex
+                                       : int((fillFrom - itemEnd) / (averageSize + spacing));
         int newModelIdx = qBound(0, modelIndex + count, model->count());
         count = newModelIdx - modelIndex;
         if (count) {
             releaseVisibleItems(reusableFlag);
+            visiblePos = itemEnd + itemsExtent(modelIndex, newModelIdx);
             modelIndex = newModelIdx;
             visibleIndex = modelIndex;
-            visiblePos = itemEnd + count * (averageSize + spacing);
             itemEnd = visiblePos;
         }
     }
@@ -858,6 +905,7 @@ void QQuickListViewPrivate::visibleItemsChanged()
 
 void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
 {
+    ensureItemSizes();
     if (!visibleItems.isEmpty()) {
         const qreal from = isContentFlowReversed() ? -position()-displayMarginBeginning-size() : position()-displayMarginBeginning;
         const qreal to = isContentFlowReversed() ? -position()+displayMarginEnd : position()+size()+displayMarginEnd;
@@ -867,6 +915,7 @@ void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
         firstVisibleItemPosition = firstItem->position();
         qreal sum = firstItem->size();
         qreal pos = firstItem->position() + firstItem->size() + spacing;
+        setItemSize(firstItem->index, firstItem->size());
         firstItem->setVisible(firstItem->endPosition() >= from && firstItem->position() <= to);
 
         // setPosition will affect the position of the item, and its section, if it has one.
@@ -882,6 +931,7 @@ void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
             }
             pos += item->size() + spacing;
             sum += item->size();
+            setItemSize(item->index, item->size());
             fixedCurrent = fixedCurrent || (currentItem && item->item == currentItem->item);
         }
         averageSize = qRound(sum / visibleItems.count());
@@ -1404,6 +1454,120 @@ void QQuickListViewPrivate::updateAverage()
     averageSize = qRound(sum / visibleItems.count());
 }
 
+/*
+    With cacheItemSizes or sizeHintRole, the sizes of the items that have been laid out, or
+    that the model provides hints for, are kept in a Fenwick tree. The distance between any
+    two items can then be found without creating the delegates in between, and so can the
+    item at a distance. Items whose size is not known are assumed to be averageSize, which
+    is all there is to go by otherwise.
+*/
+bool QQuickListViewPrivate::hasItemSizeIndex() const
+{
+    return usesItemSizeIndex() && model && itemSizes.size() == model->count();
+}
+
+void QQuickListViewPrivate::ensureItemSizes()
+{
+    if (usesItemSizeIndex() && model && itemSizes.size() != model->count())
+        resetItemSizes();
+}
+
+void QQuickListViewPrivate::resetItemSizes()
+{
+    if (!usesItemSizeIndex() || !model || !model->count()) {
+        itemSizes.clear();
+        return;
+    }
+
+    QList<QQuickListViewItemSizes> sizes(model->count());
+    if (!sizeHintRole.isEmpty()) {
+        for (int i = 0; i < sizes.size(); ++i)
+            sizes[i] = itemSizeHint(i);
+    }
+    itemSizes.assign(sizes);
+}
+
+QQuickListViewItemSizes QQuickListViewPrivate::itemSizeHint(int modelIndex) const
+{
+    if (sizeHintRole.isEmpty())
+        return QQuickListViewItemSizes();
+
+    bool ok = false;
+    const qreal size = model->variantValue(modelIndex, sizeHintRole).toReal(&ok);
+    if (!ok || size < 0)
+        return QQuickListViewItemSizes();
+    return QQuickListViewItemSizes { size, 1 };
+}
+
+void QQuickListViewPrivate::setItemSize(int modelIndex, qreal size)
+{
+    if (hasItemSizeIndex() && modelIndex >= 0 && modelIndex < itemSizes.size())
+        itemSizes.setValue(modelIndex, QQuickListViewItemSizes { size, 1 });
+}
+
+// The distance from the start of item from to the start of item to, including spacing.
+qreal QQuickListViewPrivate::itemsExtent(int from, int to) const
+{
+    if (!hasItemSizeIndex())
+        return (to - from) * (averageSize + spacing);
+
+    const auto startOf = [this](int index) {
+        const QQuickListViewItemSizes sizes = itemSizes.sum(index);
+        return sizes.size + (index - sizes.known) * averageSize + index * spacing;
+    };
+    return startOf(to) - startOf(from);
+}
+
+// The index of the item that covers the position extent past the start of item from.
+int QQuickListViewPrivate::indexAtExtent(int from, qreal extent) const
+{
+    const qreal position = itemsExtent(0, from) + extent;
+    if (position < 0)
+        return 0;
+    return int(itemSizes.indexOf(position, [this](const QQuickListViewItemSizes &sizes, qsizetype count) {
+        return sizes.size + (count - sizes.known) * averageSize + count * spacing;
+    }));
+}
+
+void QQuickListViewPrivate::aboutToApplyModelChanges(const QQmlChangeSet &changes)
+{
+    if (!usesItemSizeIndex() || !model)
+        return;
+
+    // Move the known sizes along with their items, rather than starting over.
+    QList<QQuickListViewItemSizes> sizes = itemSizes.values();
+    bool valid = sizes.size() == itemCount;
+    for (const QQmlChangeSet::Change &removal : changes.removes()) {
+        if (!valid || removal.index + removal.count > sizes.size()) {
+            valid = false;
+            break;
+        }
+        sizes.remove(removal.index, removal.count);
+    }
+    for (const QQmlChangeSet::Change &insertion : changes.inserts()) {
+        if (!valid || insertion.index > sizes.size()) {
+            valid = false;
+            break;
+        }
+        sizes.insert(insertion.index, insertion.count, QQuickListViewItemSizes());
+    }
+    if (!valid || sizes.size() != model->count()) {
+        resetItemSizes();
+        return;
+    }
+
+    // Changed items are measured again when they are laid out.
+    for (const QQmlChangeSet::Change &insertion : changes.inserts()) {
+        for (int i = insertion.index; i < insertion.end(); ++i)
+            sizes[i] = itemSizeHint(i);
+    }
+    for (const QQmlChangeSet::Change &change : changes.changes()) {
+        for (int i = change.index; i < qMin<qsizetype>(change.end(), sizes.size()); ++i)
+            sizes[i] = itemSizeHint(i);
+    }
+    itemSizes.assign(sizes);
+}
+
 qreal QQuickListViewPrivate::headerSize() const
 {
     return header ? header->size() : 0.0;
@@ -3048,6 +3212,86 @@ void QQuickListView::setFooterPositioning(QQuickListView::FooterPositioning posi
     }
 }
 
+/*!
+    \qmlproperty bool QtQuick::ListView::cacheItemSizes
+    \since 6.5
+
+    This property holds whether the view remembers the size of every delegate item it
+    has created.
+
+    The view only creates delegate items for the visible part of the list, so by default
+    it estimates the position of the other items, and \l {Flickable::}{contentHeight}
+    or \l {Flickable::}{contentWidth}, from the average size of the items that are
+    currently created. When the delegates vary in size, this makes the content size
+    change while scrolling, and makes \l positionViewAtIndex() and jumps of the
+    scroll bar land some distance away from where they should.
+
+    When this property is \c true, the size of each item is remembered once it has been
+    laid out, and only the items that have never been created are estimated from the
+    average. Positions are looked up in a structure that takes logarithmic time in the
+    number of items, so this remains cheap for models with millions of rows.
+
+    The default value is \c false.
+
+    \sa sizeHintRole
+*/
+bool QQuickListView::cacheItemSizes() const
+{
+    Q_D(const QQuickListView);
+    return d->cacheItemSizes;
+}
+
+void QQuickListView::setCacheItemSizes(bool cache)
+{
+    Q_D(QQuickListView);
+    if (d->cacheItemSizes == cache)
+        return;
+
+    d->cacheItemSizes = cache;
+    d->resetItemSizes();
+    d->forceLayoutPolish();
+    emit cacheItemSizesChanged();
+}
+
+/*!
+    \qmlproperty string QtQuick::ListView::sizeHintRole
+    \since 6.5
+
+    This property holds the name of a model role that provides the size of each item
+    before its delegate has been created: its height in a vertical list, or its width in
+    a horizontal one.
+
+    Setting it makes the view remember the sizes of its items, like
+    \l cacheItemSizes, and start from the sizes in the model rather than from an
+    average. With exact hints, \l {Flickable::}{contentHeight} is exact as well, and
+    \l positionViewAtIndex() and scroll bar jumps land precisely, without creating the
+    delegates in between. Items whose role value is not a number are estimated instead.
+
+    The role is read for every item whenever the model is reset, and for the rows that
+    are inserted or changed afterwards.
+
+    By default this property is empty.
+
+    \sa cacheItemSizes
+*/
+QString QQuickListView::sizeHintRole() const
+{
+    Q_D(const QQuickListView);
+    return d->sizeHintRole;
+}
+
+void QQuickListView::setSizeHintRole(const QString &role)
+{
+    Q_D(QQuickListView);
+    if (d->sizeHintRole == role)
+        return;
+
+    d->sizeHintRole = role;
+    d->resetItemSizes();
+    d->forceLayoutPolish();
+    emit sizeHintRoleChanged();
+}
+
 /*!
     \qmlproperty Transition QtQuick::ListView::populate
 
@@ -3664,7 +3908,7 @@ bool QQuickListViewPrivate::applyInsertionChange(const QQmlChangeSet::Change &ch
         if (insertionIdx < visibleIndex) {
             if (pos >= from) {
                 // items won't be visible, just note the size for repositioning
-                insertResult->sizeChangesBeforeVisiblePos += count * (averageSize + spacing);
+                insertResult->sizeChangesBeforeVisiblePos += itemsExtent(modelIndex, modelIndex + count);
             }
         } else {
             MutableModelIterator it(model, modelIndex + count - 1, modelIndex -1);
@@ -95,6 +95,9 @@ class Q_QUICK_PRIVATE_EXPORT QQuickListView : public QQuickItemView
     Q_PROPERTY(HeaderPositioning headerPositioning READ headerPositioning WRITE setHeaderPositioning NOTIFY headerPositioningChanged REVISION(2, 4))
     Q_PROPERTY(FooterPositioning footerPositioning READ footerPositioning WRITE setFooterPositioning NOTIFY footerPositioningChanged REVISION(2, 4))
 
+    Q_PROPERTY(bool cacheItemSizes READ cacheItemSizes WRITE setCacheItemSizes NOTIFY cacheItemSizesChanged REVISION(6, 5))
+    Q_PROPERTY(QString sizeHintRole READ sizeHintRole WRITE setSizeHintRole NOTIFY sizeHintRoleChanged REVISION(6, 5))
+
     Q_CLASSINFO("DefaultProperty", "data")
     QML_NAMED_ELEMENT(ListView)
     QML_ADDED_IN_VERSION(2, 0)
@@ -143,6 +146,12 @@ public:
     FooterPositioning footerPositioning() const;
     void setFooterPositioning(FooterPositioning positioning);
 
+    bool cacheItemSizes() const;
+    void setCacheItemSizes(bool cache);
+
+    QString sizeHintRole() const;
+    void setSizeHintRole(const QString &role);
+
     static QQuickListViewAttached *qmlAttachedProperties(QObject *);
 
 public Q_SLOTS:
@@ -159,6 +168,8 @@ Q_SIGNALS:
     void snapModeChanged();
     Q_REVISION(2, 4) void headerPositioningChanged();
     Q_REVISION(2, 4) void footerPositioningChanged();
+    Q_REVISION(6, 5) void cacheItemSizesChanged();
+    Q_REVISION(6, 5) void sizeHintRoleChanged();
 
 protected:
     void viewportMoved(Qt::Orientations orient) override;
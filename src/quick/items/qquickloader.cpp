@@ -22,6 +22,7 @@ QQuickLoaderPrivate::QQuickLoaderPrivate()
     : item(nullptr), object(nullptr), itemContext(nullptr), incubator(nullptr), updatingSize(false),
       active(true), loadingFromSource(false), asynchronous(false), status(computeStatus())
 {
+    hitTestLimitedToBounds = true;
 }
 
 QQuickLoaderPrivate::~QQuickLoaderPrivate()
@@ -35,6 +35,7 @@ QQuickMouseAreaPrivate::QQuickMouseAreaPrivate()
   , cursor(nullptr)
 #endif
 {
+    hitTestLimitedToBounds = true;
 }
 
 QQuickMouseAreaPrivate::~QQuickMouseAreaPrivate()
@@ -0,0 +1,286 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qquickplaintextdocumentlayout_p.h"
+
+#include <QtGui/qfontmetrics.h>
+#include <QtGui/qtextdocument.h>
+#include <QtGui/qtextlayout.h>
+#include <QtGui/qtextobject.h>
+
+#include <QtCore/qmath.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+QQuickPlainTextDocumentLayout::QQuickPlainTextDocumentLayout(QTextDocument *document)
+    : QAbstractTextDocumentLayout(document)
+{
+}
+
+qreal QQuickPlainTextDocumentLayout::margin() const
+{
+    return document()->documentMargin();
+}
+
+// The width lines are broken at, or FLT_MAX if they are not broken.
+qreal QQuickPlainTextDocumentLayout::lineWidth() const
+{
+    const qreal textWidth = document()->textWidth();
+    if (textWidth < 0)
+        return FLT_MAX;
+    return qMax<qreal>(0, textWidth - 2 * margin());
+}
+
+// The width lines wrap at, or FLT_MAX if they do not wrap.
+qreal QQuickPlainTextDocumentLayout::wrapWidth() const
+{
+    if (document()->defaultTextOption().wrapMode() == QTextOption::NoWrap)
+        return FLT_MAX;
+    return lineWidth();
+}
+
+void QQuickPlainTextDocumentLayout::estimate(const QTextBlock &block, qreal *height,
+                                             qreal *width, int *lines) const
+{
+    const qreal available = wrapWidth();
+    const bool wraps = available < FLT_MAX;
+    const qreal textWidth = block.length() * m_averageCharWidth;
+
+    *lines = wraps && available > 0 ? qMax(1, qCeil(textWidth / available)) : 1;
+    *height = *lines * m_lineSpacing;
+    *width = wraps ? qMin(textWidth, available) : textWidth;
+}
+
+void QQuickPlainTextDocumentLayout::layoutBlock(const QTextBlock &block) const
+{
+    const int blockNumber = block.blockNumber();
+    const QSizeF oldSize = documentSize();
+
+    QTextLayout *layout = block.layout();
+    QTextOption option = document()->defaultTextOption();
+    option.setTextDirection(block.textDirection());
+    layout->setTextOption(option);
+
+    const qreal width = lineWidth();
+    qreal height = 0;
+    qreal naturalWidth = 0;
+    int lines = 0;
+    layout->beginLayout();
+    for (QTextLine line = layout->createLine(); line.isValid(); line = layout->createLine()) {
+        line.setLineWidth(width);
+        line.setPosition(QPointF(0, height));
+        height += line.height();
+        naturalWidth = qMax(naturalWidth, line.naturalTextWidth());
+        ++lines;
+    }
+    layout->endLayout();
+
+    m_laidOut.setBit(blockNumber);
+    m_heights.setValue(blockNumber, height);
+    m_widths[blockNumber] = naturalWidth;
+    m_lineCount += lines - m_lines.at(blockNumber);
+    m_lines[blockNumber] = lines;
+    m_idealWidth = qMax(m_idealWidth, naturalWidth);
+
+    const QSizeF newSize = documentSize();
+    if (newSize != oldSize)
+        emit const_cast<QQuickPlainTextDocumentLayout *>(this)->documentSizeChanged(newSize);
+}
+
+int QQuickPlainTextDocumentLayout::hitTest(const QPointF &point, Qt::HitTestAccuracy accuracy) const
+{
+    if (m_heights.isEmpty())
+        return -1;
+
+    const int blockNumber = int(qBound<qsizetype>(0, m_heights.indexOf(point.y() - margin()),
+                                                  m_heights.size() - 1));
+    const QTextBlock block = document()->findBlockByNumber(blockNumber);
+    const QRectF rect = blockBoundingRect(block);
+    if (accuracy == Qt::ExactHit && !rect.contains(point))
+        return -1;
+
+    const QTextLayout *layout = block.layout();
+    const QPointF position = point - rect.topLeft();
+    const int lineCount = layout->lineCount();
+    for (int i = 0; i < lineCount; ++i) {
+        const QTextLine line = layout->lineAt(i);
+        if (position.y() < line.y() + line.height() || i == lineCount - 1) {
+            if (accuracy == Qt::ExactHit && !line.naturalTextRect().contains(position))
+                return -1;
+            return block.position() + line.xToCursor(position.x());
+        }
+    }
+    return block.position();
+}
+
+/*
+    Lays out the blocks from the one at \a top down to the first one that starts below
+    \a bottom, in document coordinates. QQuickTextEdit calls this from updatePolish()
+    for the range that updatePaintNode() renders, so that text is shaped on the GUI
+    thread, not while the render thread synchronizes.
+*/
+void QQuickPlainTextDocumentLayout::layoutRange(qreal top, qreal bottom)
+{
+    if (m_heights.isEmpty())
+        return;
+
+    // Laying out a block only moves the ones below it, so one pass from the top suffices.
+    int blockNumber = int(qBound<qsizetype>(0, m_heights.indexOf(top - margin()),
+                                            m_heights.size() - 1));
+    for (QTextBlock block = document()->findBlockByNumber(blockNumber); block.isValid();
+         block = block.next(), ++blockNumber) {
+        if (!m_laidOut.testBit(blockNumber))
+            layoutBlock(block);
+        if (margin() + m_heights.sum(blockNumber) > bottom)
+            break;
+    }
+}
+
+QSizeF QQuickPlainTextDocumentLayout::documentSize() const
+{
+    return QSizeF(qMax(document()->textWidth(), idealWidth()),
+                  m_heights.total() + 2 * margin());
+}
+
+qreal QQuickPlainTextDocumentLayout::idealWidth() const
+{
+    return m_idealWidth + 2 * margin();
+}
+
+QRectF QQuickPlainTextDocumentLayout::frameBoundingRect(QTextFrame *frame) const
+{
+    if (frame != document()->rootFrame())
+        return QRectF();
+    return QRectF(QPointF(0, 0), documentSize());
+}
+
+QRectF QQuickPlainTextDocumentLayout::blockBoundingRect(const QTextBlock &block) const
+{
+    if (!block.isValid() || block.blockNumber() >= m_heights.size())
+        return QRectF();
+
+    // Blocks in view have been laid out by layoutRange() already; this only catches
+    // those that somebody asks about without having polished first.
+    const int blockNumber = block.blockNumber();
+    if (!m_laidOut.testBit(blockNumber))
+        layoutBlock(block);
+
+    // Blocks move whenever one above them is laid out for the first time, so the
+    // position of the layout is only brought up to date when somebody looks at it.
+    const QPointF position(margin(), margin() + m_heights.sum(blockNumber));
+    block.layout()->setPosition(position);
+
+    const qreal width = lineWidth() < FLT_MAX ? lineWidth() : m_widths.at(blockNumber);
+    return QRectF(position, QSizeF(width, m_heights.value(blockNumber)));
+}
+
+void QQuickPlainTextDocumentLayout::documentChanged(int from, int charsRemoved, int charsAdded)
+{
+    QTextDocument *doc = document();
+    const QSizeF oldSize = documentSize();
+    const qsizetype oldBlockCount = m_widths.size();
+    const int blockCount = doc->blockCount();
+
+    const QFontMetricsF fontMetrics(doc->defaultFont());
+    const bool metricsChanged = !qFuzzyCompare(fontMetrics.height(), m_lineSpacing)
+            || !qFuzzyCompare(fontMetrics.averageCharWidth(), m_averageCharWidth);
+    m_lineSpacing = fontMetrics.height();
+    m_averageCharWidth = fontMetrics.averageCharWidth();
+
+    // QTextDocument reports changes to the page size, the default font and the default
+    // text option as a change of the whole document. If the blocks still wrap at the same
+    // width, their heights stay valid as estimates, and only need to be laid out again.
+    const bool wholeDocument = from == 0 && charsRemoved == 0 && charsAdded == doc->characterCount();
+    if (wholeDocument && blockCount == oldBlockCount && !metricsChanged
+            && m_estimatedWrapWidth == wrapWidth()) {
+        m_laidOut.fill(false);
+        emit update();
+        return;
+    }
+    m_estimatedWrapWidth = wrapWidth();
+
+    const int firstChanged = doc->findBlock(from).blockNumber();
+    const QTextBlock lastBlock = doc->findBlock(from + charsAdded);
+    const int lastChanged = lastBlock.isValid() ? lastBlock.blockNumber() : blockCount - 1;
+    const qsizetype oldChangedCount = (lastChanged - firstChanged + 1) - (blockCount - oldBlockCount);
+
+    if (metricsChanged || wholeDocument || firstChanged < 0 || oldChangedCount < 0) {
+        // Start over.
+        QList<qreal> heights(blockCount);
+        m_widths.resize(blockCount);
+        m_lines.resize(blockCount);
+        m_laidOut = QBitArray(blockCount);
+        m_lineCount = 0;
+        m_idealWidth = 0;
+        int blockNumber = 0;
+        for (QTextBlock block = doc->begin(); block.isValid(); block = block.next(), ++blockNumber) {
+            estimate(block, &heights[blockNumber], &m_widths[blockNumber], &m_lines[blockNumber]);
+            m_lineCount += m_lines.at(blockNumber);
+            m_idealWidth = qMax(m_idealWidth, m_widths.at(blockNumber));
+        }
+        m_heights.assign(heights);
+    } else if (blockCount == oldBlockCount) {
+        // An edit within blocks: only those need new estimates.
+        QTextBlock block = doc->findBlockByNumber(firstChanged);
+        for (int blockNumber = firstChanged; blockNumber <= lastChanged; ++blockNumber) {
+            qreal height;
+            int lines;
+            estimate(block, &height, &m_widths[blockNumber], &lines);
+            m_heights.setValue(blockNumber, height);
+            m_lineCount += lines - m_lines.at(blockNumber);
+            m_lines[blockNumber] = lines;
+            m_laidOut.clearBit(blockNumber);
+            m_idealWidth = qMax(m_idealWidth, m_widths.at(blockNumber));
+            block = block.next();
+        }
+    } else {
+        // Blocks were inserted or removed: splice estimates for the changed range in
+        // between what is known about the blocks before and after it.
+        const qsizetype tail = oldBlockCount - (firstChanged + oldChangedCount);
+        QList<qreal> heights = m_heights.values().mid(0, firstChanged);
+        QList<qreal> widths = m_widths.mid(0, firstChanged);
+        QList<int> lines = m_lines.mid(0, firstChanged);
+        QBitArray laidOut(blockCount);
+        for (int i = 0; i < firstChanged; ++i)
+            laidOut.setBit(i, m_laidOut.testBit(i));
+
+        QTextBlock block = doc->findBlockByNumber(firstChanged);
+        for (int blockNumber = firstChanged; blockNumber <= lastChanged; ++blockNumber) {
+            qreal height;
+            qreal width;
+            int lineCount;
+            estimate(block, &height, &width, &lineCount);
+            heights.append(height);
+            widths.append(width);
+            lines.append(lineCount);
+            block = block.next();
+        }
+
+        const qsizetype oldTailStart = oldBlockCount - tail;
+        heights.append(m_heights.values().mid(oldTailStart));
+        widths.append(m_widths.mid(oldTailStart));
+        lines.append(m_lines.mid(oldTailStart));
+        for (qsizetype i = 0; i < tail; ++i)
+            laidOut.setBit(blockCount - tail + i, m_laidOut.testBit(oldTailStart + i));
+
+        m_heights.assign(heights);
+        m_widths = widths;
+        m_lines = lines;
+        m_laidOut = laidOut;
+        m_lineCount = std::accumulate(m_lines.cbegin(), m_lines.cend(), 0);
+        m_idealWidth = m_widths.isEmpty() ? 0 : *std::max_element(m_widths.cbegin(), m_widths.cend());
+    }
+
+    const QSizeF newSize = documentSize();
+    if (newSize != oldSize)
+        emit documentSizeChanged(newSize);
+    emit update();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qquickplaintextdocumentlayout_p.cpp"
@@ -0,0 +1,84 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKPLAINTEXTDOCUMENTLAYOUT_P_H
+#define QQUICKPLAINTEXTDOCUMENTLAYOUT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtquickglobal_p.h>
+#include <QtQuick/private/qquickfenwicktree_p.h>
+
+#include <QtCore/qbitarray.h>
+#include <QtGui/qabstracttextdocumentlayout.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Document layout for plain text that only lays out the blocks somebody asks about.
+
+    QTextDocumentLayout lays out the whole document to know its size. This one estimates
+    the height of every block from the font metrics and its length instead, and replaces
+    the estimate with the real height once a block is laid out, which usually happens
+    because it has become visible. Block positions are kept in a Fenwick tree, so that
+    finding the block at a position stays cheap in documents with hundreds of thousands
+    of blocks.
+
+    The document size is therefore an estimate, which grows or shrinks as more of the
+    document is laid out; documentSizeChanged() is emitted when it does.
+*/
+class Q_QUICK_PRIVATE_EXPORT QQuickPlainTextDocumentLayout : public QAbstractTextDocumentLayout
+{
+    Q_OBJECT
+
+public:
+    explicit QQuickPlainTextDocumentLayout(QTextDocument *document);
+
+    void draw(QPainter *, const PaintContext &) override {}
+    int hitTest(const QPointF &point, Qt::HitTestAccuracy accuracy) const override;
+
+    int pageCount() const override { return 1; }
+    QSizeF documentSize() const override;
+
+    QRectF frameBoundingRect(QTextFrame *frame) const override;
+    QRectF blockBoundingRect(const QTextBlock &block) const override;
+
+    void layoutRange(qreal top, qreal bottom);
+
+    // Including the document margins, like QTextDocument::idealWidth().
+    qreal idealWidth() const;
+    int lineCount() const { return m_lineCount; }
+
+protected:
+    void documentChanged(int from, int charsRemoved, int charsAdded) override;
+
+private:
+    qreal margin() const;
+    qreal lineWidth() const;
+    qreal wrapWidth() const;
+    void estimate(const QTextBlock &block, qreal *height, qreal *width, int *lines) const;
+    void layoutBlock(const QTextBlock &block) const;
+
+    mutable QQuickFenwickTree<qreal> m_heights;
+    mutable QList<qreal> m_widths;
+    mutable QList<int> m_lines;
+    mutable QBitArray m_laidOut;
+    mutable qreal m_idealWidth = 0;
+    mutable int m_lineCount = 0;
+    qreal m_estimatedWrapWidth = -1; // the wrap width the estimates are for
+    qreal m_lineSpacing = 0;
+    qreal m_averageCharWidth = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKPLAINTEXTDOCUMENTLAYOUT_P_H
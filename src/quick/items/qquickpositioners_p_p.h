@@ -58,6 +58,7 @@ public:
         , doingPositioning(false), anchorConflict(false), layoutDirection(Qt::LeftToRight)
 
     {
+        hitTestLimitedToBounds = true;
     }
 
     void init(QQuickBasePositioner::PositionerType at)
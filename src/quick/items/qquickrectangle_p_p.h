@@ -30,6 +30,7 @@ public:
     QQuickRectanglePrivate() :
     color(Qt::white), gradient(QJSValue::UndefinedValue), pen(0), radius(0)
     {
+        hitTestLimitedToBounds = true;
     }
 
     ~QQuickRectanglePrivate()
@@ -538,6 +538,30 @@
     \sa {Selecting items}, selectionModel, keyNavigationEnabled
 */
 
+/*!
+    \qmlproperty int QtQuick::TableView::prefetchLines
+    \since 6.5
+
+    This property holds how many rows or columns ahead of the visible table
+    TableView creates delegate items for while the view is being flicked.
+
+    TableView predicts where the view is heading from the velocity of the
+    flick, and starts to incubate the delegate items of the next
+    \c prefetchLines rows or columns in that direction asynchronously. The
+    incubation is spread over several frames by the incubation controller of
+    the window, which only uses the time that is left of each frame. When the
+    rows or columns later become visible, their delegate items are then
+    already created, or nearly so. When the delegate items are created
+    asynchronously, the cells of a new row or column are also created at
+    the same time, rather than one after the other.
+
+    Prefetched delegate items are kept invisible, and count as loaded items
+    while they wait, so a higher value uses more memory. The default value is
+    \c 0, which disables prefetching.
+
+    \sa reuseItems, {Reusing items}
+*/
+
 /*!
     \qmlmethod QtQuick::TableView::positionViewAtCell(point cell, PositionMode mode, point offset, rect subRect)
 
@@ -943,6 +967,9 @@ QQuickTableViewPrivate::QQuickTableViewPrivate()
 
 QQuickTableViewPrivate::~QQuickTableViewPrivate()
 {
+    if (tableModel)
+        releasePrefetchedItems(QQmlTableInstanceModel::NotReusable);
+
     for (auto *fxTableItem : loadedItems) {
         if (auto item = fxTableItem->item) {
             if (fxTableItem->ownItem)
@@ -1973,6 +2000,8 @@ FxTableItem *QQuickTableViewPrivate::loadFxTableItem(const QPoint &cell, QQmlInc
     QBoolBlocker guard(blockItemCreatedCallback);
     auto item = createFxTableItem(cell, incubationMode);
     qCDebug(lcTableViewDelegateLifecycle) << cell << "ready?" << bool(item);
+    if (item)
+        dropPrefetchedItem(item->index);
     return item;
 }
 
@@ -2622,7 +2651,11 @@ void QQuickTableViewPrivate::processLoadRequest()
 
         if (!fxTableItem) {
             // Requested item is not yet ready. Just leave, and wait for this
-            // function to be called again when the item is ready.
+            // function to be called again when the item is ready. But rather than
+            // waiting for the rest of the edge one item at a time, start incubating
+            // those as well, so that they can be ready by then.
+            if (prefetchLines > 0 && loadRequest.incubationMode() != QQmlIncubator::Synchronous)
+                prefetchCells(loadRequest.remainingCells());
             return;
         }
 
@@ -2650,6 +2683,132 @@ void QQuickTableViewPrivate::processLoadRequest()
     qCDebug(lcTableViewDelegateLifecycle()) << "****************************************";
 }
 
+void QQuickTableViewPrivate::prefetchAhead()
+{
+    // While the viewport moves, we start incubating the delegate items of the next
+    // prefetchLines rows and columns in the direction it moves. The incubation is
+    // asynchronous, and is driven by the incubation controller of the window, which
+    // only spends what is left of each frame on it. When the viewport later reaches
+    // those rows and columns, their items are (mostly) ready, instead of being
+    // created one after the other in the frame that needs them.
+    Q_Q(QQuickTableView);
+
+    if (prefetchLines <= 0 || !tableModel || loadedItems.isEmpty() || loadRequest.isActive())
+        return;
+
+    // Predict the direction from the velocity of the flick, and fall back to
+    // how the viewport moved since last time for movements that don't report
+    // a velocity, like animations and programmatic flicks.
+    const QPointF delta = viewportRect.topLeft() - prefetchViewportPos;
+    prefetchViewportPos = viewportRect.topLeft();
+    const qreal directionX = !qFuzzyIsNull(q->horizontalVelocity()) ? q->horizontalVelocity() : delta.x();
+    const qreal directionY = !qFuzzyIsNull(q->verticalVelocity()) ? q->verticalVelocity() : delta.y();
+
+    if (qFuzzyIsNull(directionX) && qFuzzyIsNull(directionY)) {
+        // Keep what we have until we know where the viewport is heading next.
+        return;
+    }
+
+    QVector<QPoint> cells;
+
+    if (!qFuzzyIsNull(directionX)) {
+        const Qt::Edge edge = directionX > 0 ? Qt::RightEdge : Qt::LeftEdge;
+        int column = edge == Qt::RightEdge ? rightColumn() : leftColumn();
+        for (int line = 0; line < prefetchLines; ++line) {
+            column = nextVisibleEdgeIndex(edge, edge == Qt::RightEdge ? column + 1 : column - 1);
+            if (column == kEdgeIndexAtEnd)
+                break;
+            for (int row : loadedRows)
+                cells.append(QPoint(column, row));
+        }
+    }
+
+    if (!qFuzzyIsNull(directionY)) {
+        const Qt::Edge edge = directionY > 0 ? Qt::BottomEdge : Qt::TopEdge;
+        int row = edge == Qt::BottomEdge ? bottomRow() : topRow();
+        for (int line = 0; line < prefetchLines; ++line) {
+            row = nextVisibleEdgeIndex(edge, edge == Qt::BottomEdge ? row + 1 : row - 1);
+            if (row == kEdgeIndexAtEnd)
+                break;
+            for (int column : loadedColumns)
+                cells.append(QPoint(column, row));
+        }
+    }
+
+    // Give back the items that the viewport is no longer heading for. They end up
+    // in the reuse pool, from where they can be picked up again for other cells.
+    QSet<int> wantedIndexes;
+    for (const QPoint &cell : std::as_const(cells))
+        wantedIndexes.insert(modelIndexAtCell(cell));
+    for (auto it = prefetchedItems.begin(); it != prefetchedItems.end();) {
+        if (wantedIndexes.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        QObject *object = it.value();
+        it = prefetchedItems.erase(it);
+        model->release(object, reusableFlag);
+    }
+
+    prefetchCells(cells);
+}
+
+void QQuickTableViewPrivate::prefetchCells(const QVector<QPoint> &cells)
+{
+    if (!tableModel)
+        return;
+
+    for (const QPoint &cell : cells) {
+        const int modelIndex = modelIndexAtCell(cell);
+        if (loadedItems.contains(modelIndex)
+                || prefetchedItems.contains(modelIndex)
+                || pendingPrefetches.contains(modelIndex))
+            continue;
+
+        // Items incubate in the order they are requested, so the
+        // cells closest to the loaded table are ready first.
+        QBoolBlocker guard(blockItemCreatedCallback);
+        if (QObject *object = model->object(modelIndex, QQmlIncubator::Asynchronous))
+            holdPrefetchedItem(modelIndex, object);
+        else if (model->incubationStatus(modelIndex) == QQmlIncubator::Loading)
+            pendingPrefetches.insert(modelIndex);
+    }
+}
+
+void QQuickTableViewPrivate::holdPrefetchedItem(int modelIndex, QObject *object)
+{
+    if (loadedItems.contains(modelIndex)) {
+        // The cell was loaded in the meantime, and holds its own reference.
+        model->release(object);
+        return;
+    }
+
+    // Keep the item out of sight until a load request takes it into use.
+    if (auto item = qmlobject_cast<QQuickItem *>(object))
+        QQuickItemPrivate::get(item)->setCulled(true);
+
+    prefetchedItems.insert(modelIndex, object);
+}
+
+void QQuickTableViewPrivate::dropPrefetchedItem(int modelIndex)
+{
+    // The cell has been loaded, which takes a reference of its own.
+    pendingPrefetches.remove(modelIndex);
+    if (QObject *object = prefetchedItems.take(modelIndex))
+        model->release(object);
+}
+
+void QQuickTableViewPrivate::releasePrefetchedItems(QQmlTableInstanceModel::ReusableFlag reusableFlag)
+{
+    // Items that are still incubating will be deleted by the
+    // model once they are done, since nobody references them.
+    pendingPrefetches.clear();
+    auto const tmpList = prefetchedItems;
+    prefetchedItems.clear();
+    for (QObject *object : tmpList)
+        model->release(object, reusableFlag);
+}
+
 void QQuickTableViewPrivate::processRebuildTable()
 {
     Q_Q(QQuickTableView);
@@ -3297,6 +3456,7 @@ bool QQuickTableViewPrivate::updateTable()
         return !loadRequest.isActive();
 
     loadAndUnloadVisibleEdges();
+    prefetchAhead();
 
     return !loadRequest.isActive();
 }
@@ -3466,6 +3626,16 @@ void QQuickTableViewPrivate::itemCreatedCallback(int modelIndex, QObject*)
     qCDebug(lcTableViewDelegateLifecycle) << "item done loading:"
         << cellAtModelIndex(modelIndex);
 
+    if (pendingPrefetches.remove(modelIndex)) {
+        // A prefetched item is ready. Hold on to it until the cell is
+        // loaded, which might not be until a later edge is loaded.
+        QBoolBlocker guard(blockItemCreatedCallback);
+        if (QObject *object = model->object(modelIndex, QQmlIncubator::Asynchronous))
+            holdPrefetchedItem(modelIndex, object);
+        if (!loadRequest.isActive())
+            return;
+    }
+
     // Since the item we waited for has finished incubating, we can
     // continue with the load request. processLoadRequest will
     // ask the model for the requested item once more, which will be
@@ -3521,6 +3691,10 @@ void QQuickTableViewPrivate::syncWithPendingChanges()
     // unpredicted behavior, and possibly a crash, we need to postpone taking
     // such assignments into effect until we're in a state that allows it.
 
+    // A rebuild can change what is in the cells we have prefetched items for.
+    if (scheduledRebuildOptions && tableModel)
+        releasePrefetchedItems(reusableFlag);
+
     syncViewportRect();
     syncModel();
     syncDelegate();
@@ -5069,6 +5243,25 @@ void QQuickTableView::setSelectionBehavior(SelectionBehavior selectionBehavior)
     emit selectionBehaviorChanged();
 }
 
+int QQuickTableView::prefetchLines() const
+{
+    return d_func()->prefetchLines;
+}
+
+void QQuickTableView::setPrefetchLines(int lines)
+{
+    Q_D(QQuickTableView);
+    lines = qMax(0, lines);
+    if (d->prefetchLines == lines)
+        return;
+
+    d->prefetchLines = lines;
+    if (lines == 0 && d->tableModel)
+        d->releasePrefetchedItems(d->reusableFlag);
+
+    emit prefetchLinesChanged();
+}
+
 class QObjectPrivate;
 class QQuickTableSectionSizeProviderPrivate : public QObjectPrivate {
 public:
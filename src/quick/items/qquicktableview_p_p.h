@@ -19,6 +19,7 @@
 
 #include <QtCore/qtimer.h>
 #include <QtCore/qitemselectionmodel.h>
+#include <QtCore/qset.h>
 #include <QtQmlModels/private/qqmltableinstancemodel_p.h>
 #include <QtQml/private/qqmlincubator_p.h>
 #include <QtQmlModels/private/qqmlchangeset_p.h>
@@ -115,6 +116,14 @@ public:
 
         inline QPointF startPosition() const { return m_startPos; }
 
+        QVector<QPoint> remainingCells() const
+        {
+            QVector<QPoint> cells;
+            for (int i = m_currentIndex + 1; i < m_visibleCellsInEdge.count(); ++i)
+                cells.append(cellAt(i));
+            return cells;
+        }
+
         QString toString() const
         {
             QString str;
@@ -243,6 +252,13 @@ public:
 
     QQmlTableInstanceModel::ReusableFlag reusableFlag = QQmlTableInstanceModel::Reusable;
 
+    // Delegate items that we have started to incubate, or hold a reference to, ahead
+    // of the edges that will be loaded next, keyed on model index. See prefetchAhead().
+    int prefetchLines = 0;
+    QHash<int, QObject *> prefetchedItems;
+    QSet<int> pendingPrefetches;
+    QPointF prefetchViewportPos;
+
     bool blockItemCreatedCallback = false;
     mutable bool layoutWarningIssued = false;
     bool polishing = false;
@@ -412,6 +428,12 @@ public:
     void drainReusePoolAfterLoadRequest();
     void processLoadRequest();
 
+    void prefetchAhead();
+    void prefetchCells(const QVector<QPoint> &cells);
+    void holdPrefetchedItem(int modelIndex, QObject *object);
+    void dropPrefetchedItem(int modelIndex);
+    void releasePrefetchedItems(QQmlTableInstanceModel::ReusableFlag reusableFlag);
+
     void processRebuildTable();
     bool moveToNextRebuildState();
     void calculateTopLeft(QPoint &topLeft, QPointF &topLeftPos);
@@ -64,6 +64,7 @@ QQuickTextPrivate::QQuickTextPrivate()
     , updateSizeRecursionGuard(false)
 {
     implicitAntialiasing = true;
+    hitTestLimitedToBounds = true;
 }
 
 QQuickTextPrivate::ExtraData::ExtraData()
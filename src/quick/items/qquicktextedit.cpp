@@ -9,6 +9,7 @@
 #include "qquickwindow.h"
 #include "qquicktextnode_p.h"
 #include "qquicktextnodeengine_p.h"
+#include "qquickplaintextdocumentlayout_p.h"
 
 #include <QtCore/qmath.h>
 #include <QtGui/qguiapplication.h>
@@ -22,6 +23,7 @@
 #include <private/qqmlglobal_p.h>
 #include <private/qqmlproperty_p.h>
 #include <private/qtextengine_p.h>
+#include <private/qtextdocumentlayout_p.h>
 #include <private/qsgadaptationlayer_p.h>
 
 #include "qquicktextdocument.h"
@@ -383,6 +385,7 @@ void QQuickTextEdit::setText(const QString &text)
     d->document->clearResources();
     d->richText = d->format == RichText || (d->format == AutoText && Qt::mightBeRichText(text));
     d->markdownText = d->format == MarkdownText;
+    d->updateDocumentLayout();
     if (!isComponentComplete()) {
         d->text = text;
     } else if (d->richText) {
@@ -396,7 +399,8 @@ void QQuickTextEdit::setText(const QString &text)
     } else {
         d->control->setPlainText(text);
     }
-    setFlag(QQuickItem::ItemObservesViewport, text.size() > QQuickTextEditPrivate::largeTextSizeThreshold);
+    setFlag(QQuickItem::ItemObservesViewport, d->plainTextLayout()
+            || text.size() > QQuickTextEditPrivate::largeTextSizeThreshold);
 }
 
 void QQuickTextEdit::invalidate()
@@ -406,6 +410,7 @@ void QQuickTextEdit::invalidate()
         if (d->document != nullptr)
             d->document->markContentsDirty(0, d->document->characterCount());
         invalidateFontCaches();
+        polish();
         d->updateType = QQuickTextEditPrivate::UpdateAll;
         update();
     }
@@ -480,6 +485,7 @@ void QQuickTextEdit::setTextFormat(TextFormat format)
     bool wasRich = d->richText;
     d->richText = format == RichText || (format == AutoText && (wasRich || Qt::mightBeRichText(text())));
     d->markdownText = format == MarkdownText;
+    d->updateDocumentLayout();
 
 #if QT_CONFIG(texthtmlparser)
     if (isComponentComplete()) {
@@ -1657,6 +1663,7 @@ void QQuickTextEdit::setReadOnly(bool r)
     } else if (hasActiveFocus()) {
         setCursorVisible(true);
     }
+    d->updateDocumentLayout();
 }
 
 bool QQuickTextEdit::isReadOnly() const
@@ -2116,10 +2123,17 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
         }
 
         // If there's a lot of text, insert only the range of blocks that can possibly be visible within the viewport.
-        QRectF viewport;
-        if (flags().testFlag(QQuickItem::ItemObservesViewport)) {
-            viewport = clipRect();
+        const QRectF viewport = d->nodeViewport();
+        if (!viewport.isNull())
             qCDebug(lcVP) << "text viewport" << viewport;
+
+        // Find the first block that can be visible directly, instead of going through all
+        // the blocks above it. Only the root frame can be skipped through like this.
+        int firstVisibleBlockPos = 0;
+        if (!viewport.isNull() && d->document->rootFrame()->childFrames().isEmpty()) {
+            const QPointF topLeft(0, viewport.top() - qMax(qreal(0), d->yoff));
+            const int pos = d->document->documentLayout()->hitTest(topLeft, Qt::FuzzyHit);
+            firstVisibleBlockPos = d->document->findBlock(qMax(0, pos)).position();
         }
 
         // FIXME: the text decorations could probably be handled separately (only updated for affected textFrames)
@@ -2191,6 +2205,12 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
                         ++it;
                         continue;
                     }
+                    const QTextBlock nextBlock = block.next();
+                    if (nextBlock.isValid() && nextBlock.position() <= firstVisibleBlockPos
+                            && nextBlock.position() < firstCleanNode.startPos()) {
+                        ++it; // above the viewport
+                        continue;
+                    }
 
                     if (!engine.hasContents())
                         nodeOffset = d->document->documentLayout()->blockBoundingRect(block).topLeft();
@@ -2308,7 +2328,15 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
 
 void QQuickTextEdit::updatePolish()
 {
+    Q_D(QQuickTextEdit);
     invalidateFontCaches();
+
+    // Lay out the blocks that updatePaintNode() is about to render here, on the GUI thread.
+    if (QQuickPlainTextDocumentLayout *layout = d->plainTextLayout()) {
+        const QRectF viewport = d->nodeViewport();
+        if (!viewport.isNull())
+            layout->layoutRange(viewport.top() - qMax(qreal(0), d->yoff), viewport.bottom());
+    }
 }
 
 /*!
@@ -2626,7 +2654,7 @@ void QQuickTextEdit::updateSize()
 
     qreal naturalWidth = d->implicitWidth - leftPadding() - rightPadding();
 
-    qreal newWidth = d->document->idealWidth();
+    qreal newWidth = d->documentIdealWidth();
     // ### assumes that if the width is set, the text will fill to edges
     // ### (unless wrap is false, then clipping will occur)
     if (widthValid()) {
@@ -2637,8 +2665,11 @@ void QQuickTextEdit::updateSize()
                 return;
         }
         if (d->requireImplicitWidth) {
-            d->document->setTextWidth(-1);
-            naturalWidth = d->document->idealWidth();
+            // The plain text layout only knows the width of the lines it has laid out, so
+            // do not make it lay out the document again without wrapping to find out.
+            if (!d->plainTextLayout())
+                d->document->setTextWidth(-1);
+            naturalWidth = d->documentIdealWidth();
 
             const bool wasInLayout = d->inLayout;
             d->inLayout = true;
@@ -2651,7 +2682,7 @@ void QQuickTextEdit::updateSize()
         const qreal newTextWidth = width() - leftPadding() - rightPadding();
         if (d->document->textWidth() != newTextWidth) {
             d->document->setTextWidth(newTextWidth);
-            newWidth = d->document->idealWidth();
+            newWidth = d->documentIdealWidth();
         }
         //### need to confirm cost of always setting these
     } else if (d->wrapMode == NoWrap && d->document->textWidth() != newWidth) {
@@ -2759,6 +2790,15 @@ void QQuickTextEdit::updateTotalLines()
 {
     Q_D(QQuickTextEdit);
 
+    if (QQuickPlainTextDocumentLayout *layout = d->plainTextLayout()) {
+        // Counting the lines of each block would create a layout for every one of them.
+        if (d->lineCount != layout->lineCount()) {
+            d->lineCount = layout->lineCount();
+            emit lineCountChanged();
+        }
+        return;
+    }
+
     int subLines = 0;
 
     for (QTextBlock it = d->document->begin(); it != d->document->end(); it = it.next()) {
@@ -2816,6 +2856,71 @@ void QQuickTextEditPrivate::updateDefaultTextOption()
     }
 }
 
+QQuickPlainTextDocumentLayout *QQuickTextEditPrivate::plainTextLayout() const
+{
+    return qobject_cast<QQuickPlainTextDocumentLayout *>(document->documentLayout());
+}
+
+// The part of the item that updatePaintNode() creates nodes for, or a null rectangle
+// if it creates them for all of the text.
+QRectF QQuickTextEditPrivate::nodeViewport() const
+{
+    Q_Q(const QQuickTextEdit);
+    QRectF viewport;
+    if (q->flags().testFlag(QQuickItem::ItemObservesViewport)) {
+        viewport = q->clipRect();
+        // When blocks are only laid out once they are visible, render half a viewport
+        // more above and below, so that scrolling does not lay out blocks every frame.
+        if (plainTextLayout())
+            viewport.adjust(0, -viewport.height() / 2, 0, viewport.height() / 2);
+    }
+    return viewport;
+}
+
+qreal QQuickTextEditPrivate::documentIdealWidth() const
+{
+    if (const QQuickPlainTextDocumentLayout *layout = plainTextLayout())
+        return layout->idealWidth();
+    return document->idealWidth();
+}
+
+/*
+    Switches the document between QTextDocumentLayout, which lays out everything, and
+    QQuickPlainTextDocumentLayout, which only lays out the blocks near the viewport.
+    The latter can only be used for read-only plain text.
+*/
+void QQuickTextEditPrivate::updateDocumentLayout()
+{
+    Q_Q(QQuickTextEdit);
+    const bool usePlainTextLayout = virtualized && !richText && !markdownText && q->isReadOnly();
+    if (usePlainTextLayout == (plainTextLayout() != nullptr))
+        return;
+
+    QAbstractTextDocumentLayout *layout = nullptr;
+    if (usePlainTextLayout)
+        layout = new QQuickPlainTextDocumentLayout(document);
+    else
+        layout = new QTextDocumentLayout(document);
+
+    const QVariant cursorWidth = document->documentLayout()->property("cursorWidth");
+    document->setDocumentLayout(layout); // deletes the previous one
+    layout->setProperty("cursorWidth", cursorWidth);
+    layout->registerHandler(QTextFormat::ImageObject, document);
+
+    QObject::connect(layout, &QAbstractTextDocumentLayout::update, control, &QQuickTextControl::updateRequest);
+    QObject::connect(layout, &QAbstractTextDocumentLayout::updateBlock, control, &QQuickTextControl::updateRequest);
+    QObject::connect(layout, &QAbstractTextDocumentLayout::updateBlock, q, &QQuickTextEdit::invalidateBlock);
+    if (usePlainTextLayout) {
+        // Blocks are laid out while the nodes are updated, so the size is caught up with later.
+        QObject::connect(layout, &QAbstractTextDocumentLayout::documentSizeChanged,
+                         q, &QQuickTextEdit::updateSize, Qt::QueuedConnection);
+        q->setFlag(QQuickItem::ItemObservesViewport);
+    }
+
+    q->updateWholeDocument();
+    q->updateSize();
+}
+
 void QQuickTextEdit::focusInEvent(QFocusEvent *event)
 {
     Q_D(QQuickTextEdit);
@@ -2955,6 +3060,7 @@ void QQuickTextEdit::insert(int position, const QString &text)
     QTextCursor cursor(d->document);
     cursor.setPosition(position);
     d->richText = d->richText || (d->format == AutoText && Qt::mightBeRichText(text));
+    d->updateDocumentLayout();
     if (d->richText) {
 #if QT_CONFIG(texthtmlparser)
         cursor.insertHtml(text);
@@ -3158,6 +3264,7 @@ void QQuickTextEdit::setPadding(qreal padding)
     d->extra.value().padding = padding;
     updateSize();
     if (isComponentComplete()) {
+        polish();
         d->updateType = QQuickTextEditPrivate::UpdatePaintNode;
         update();
     }
@@ -3283,6 +3390,42 @@ void QQuickTextEdit::setTabStopDistance(qreal distance)
     emit tabStopDistanceChanged(distance);
 }
 
+/*!
+    \qmlproperty bool QtQuick::TextEdit::virtualized
+    \since 6.5
+
+    This property holds whether only the visible part of the document is laid out.
+
+    When \c true, and the TextEdit is \l readOnly and displays plain text, only the
+    blocks of text in and around the viewport are laid out and turned into scene graph
+    nodes. The rest of the document is estimated from the font metrics. This makes very
+    large documents, such as log files, quick to open and to scroll.
+
+    As a consequence, \l contentHeight, the implicit size and \l lineCount are estimates
+    until the whole document has been scrolled through, and are refined as more of it
+    becomes visible.
+
+    The default value is \c false.
+
+    \sa readOnly, textFormat
+*/
+bool QQuickTextEdit::isVirtualized() const
+{
+    Q_D(const QQuickTextEdit);
+    return d->virtualized;
+}
+
+void QQuickTextEdit::setVirtualized(bool virtualized)
+{
+    Q_D(QQuickTextEdit);
+    if (d->virtualized == virtualized)
+        return;
+
+    d->virtualized = virtualized;
+    d->updateDocumentLayout();
+    emit virtualizedChanged();
+}
+
 /*!
     \qmlmethod QtQuick::TextEdit::clear()
     \since 5.7
@@ -78,6 +78,7 @@ class Q_QUICK_PRIVATE_EXPORT QQuickTextEdit : public QQuickImplicitSizeItem, pub
     Q_PROPERTY(qreal bottomPadding READ bottomPadding WRITE setBottomPadding RESET resetBottomPadding NOTIFY bottomPaddingChanged REVISION(2, 6))
     Q_PROPERTY(QString preeditText READ preeditText NOTIFY preeditTextChanged REVISION(2, 7))
     Q_PROPERTY(qreal tabStopDistance READ tabStopDistance WRITE setTabStopDistance NOTIFY tabStopDistanceChanged REVISION(2, 10))
+    Q_PROPERTY(bool virtualized READ isVirtualized WRITE setVirtualized NOTIFY virtualizedChanged REVISION(6, 5))
     QML_NAMED_ELEMENT(TextEdit)
     QML_ADDED_IN_VERSION(2, 0)
 
@@ -269,6 +270,9 @@ public:
     int tabStopDistance() const;
     void setTabStopDistance(qreal distance);
 
+    bool isVirtualized() const;
+    void setVirtualized(bool virtualized);
+
     void invalidate() override;
 
 Q_SIGNALS:
@@ -316,6 +320,7 @@ Q_SIGNALS:
     Q_REVISION(2, 6) void rightPaddingChanged();
     Q_REVISION(2, 6) void bottomPaddingChanged();
     Q_REVISION(2, 10) void tabStopDistanceChanged(qreal distance);
+    Q_REVISION(6, 5) void virtualizedChanged();
 
 public Q_SLOTS:
     void selectAll();
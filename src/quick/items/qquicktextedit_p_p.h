@@ -31,6 +31,7 @@ class QQuickTextDocumentWithImageResources;
 class QQuickTextControl;
 class QQuickTextNode;
 class QQuickTextNodeEngine;
+class QQuickPlainTextDocumentLayout;
 
 class Q_QUICK_PRIVATE_EXPORT QQuickTextEditPrivate : public QQuickImplicitSizeItemPrivate
 {
@@ -91,8 +92,9 @@ public:
         , focusOnPress(true), persistentSelection(false), requireImplicitWidth(false)
         , selectByMouse(false), canPaste(false), canPasteValid(false), hAlignImplicit(true)
         , textCached(true), inLayout(false), selectByKeyboard(false), selectByKeyboardSet(false)
-        , hadSelection(false), markdownText(false)
+        , hadSelection(false), markdownText(false), virtualized(false)
     {
+        hitTestLimitedToBounds = true;
     }
 
     static QQuickTextEditPrivate *get(QQuickTextEdit *item) {
@@ -130,6 +132,11 @@ public:
     void setRightPadding(qreal value, bool reset = false);
     void setBottomPadding(qreal value, bool reset = false);
 
+    QQuickPlainTextDocumentLayout *plainTextLayout() const;
+    QRectF nodeViewport() const;
+    void updateDocumentLayout();
+    qreal documentIdealWidth() const;
+
     bool isImplicitResizeEnabled() const;
     void setImplicitResizeEnabled(bool enabled);
 
@@ -198,6 +205,7 @@ public:
     bool selectByKeyboardSet:1;
     bool hadSelection : 1;
     bool markdownText : 1;
+    bool virtualized : 1;
 
     static const int largeTextSizeThreshold;
 };
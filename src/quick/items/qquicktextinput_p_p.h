@@ -125,6 +125,7 @@ public:
         , requireImplicitWidth(false)
         , overwriteMode(false)
     {
+        hitTestLimitedToBounds = true;
     }
 
     ~QQuickTextInputPrivate()
@@ -530,6 +530,11 @@ void QQuickWindowPrivate::syncSceneGraph()
     }
     context->prepareSync(q->effectiveDevicePixelRatio(), cb, graphicsConfig);
 
+    if (frameStatisticsEnabled.load(std::memory_order_relaxed)) {
+        currentFrameStatistics = pendingFrameStatistics;
+        pendingFrameStatistics = QQuickWindow::FrameStatistics();
+    }
+
     animationController->beforeNodeSync();
 
     emit q->beforeSynchronizing();
@@ -662,8 +667,17 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size, const QSize &surfa
     renderer->setViewportRect(QRect(QPoint(0, 0), pixelSize));
     renderer->setProjectionMatrixToRect(QRectF(QPointF(0, 0), logicalSize), matrixFlags);
 
+    const bool collectStatistics = frameStatisticsEnabled.load(std::memory_order_relaxed);
+    if (collectStatistics) {
+        frameCounters = QSGFrameCounters();
+        QSGFrameCounters::setCurrent(&frameCounters);
+    }
+
     context->renderNextFrame(renderer);
 
+    if (collectStatistics)
+        QSGFrameCounters::setCurrent(nullptr);
+
     emit q->afterRendering();
     runAndClearJobs(&afterRenderingJobs);
 
@@ -677,6 +691,29 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size, const QSize &surfa
     }
 }
 
+void QQuickWindowPrivate::finishFrameStatistics(qint64 syncTime, qint64 renderTime, qint64 swapTime)
+{
+    Q_Q(QQuickWindow);
+    QQuickWindow::FrameStatistics &stats = currentFrameStatistics;
+    stats.syncTime = syncTime;
+    stats.renderTime = renderTime;
+    stats.swapTime = swapTime;
+    stats.batchCount = frameCounters.batches;
+    stats.mergedBatchCount = frameCounters.mergedBatches;
+    stats.unmergedBatchCount = frameCounters.unmergedBatches;
+    stats.vertexBytesUploaded = frameCounters.bufferBytesUploaded;
+    stats.textureUploadCount = frameCounters.textureUploads;
+    stats.pipelineCreationCount = frameCounters.pipelineCreations;
+
+    frameStatisticsMutex.lock();
+    lastFrameStatistics = stats;
+    frameStatisticsMutex.unlock();
+
+    stats = QQuickWindow::FrameStatistics();
+    frameCounters = QSGFrameCounters();
+    emit q->frameStatisticsAvailable();
+}
+
 QQuickWindowPrivate::QQuickWindowPrivate()
     : contentItem(nullptr)
     , dirtyItemList(nullptr)
@@ -2889,6 +2926,24 @@ QQmlIncubationController *QQuickWindow::incubationController() const
     \internal
 */
 
+/*!
+    \fn void QQuickWindow::frameStatisticsAvailable()
+
+    This signal is emitted when frame statistics are enabled and the scene
+    graph has finished a frame. frameStatistics() then returns the statistics
+    of that frame.
+
+    \warning This signal is emitted from the scene graph rendering thread.
+
+    \since 6.5
+    \sa setFrameStatisticsEnabled()
+*/
+
+/*!
+    \qmlsignal QtQuick.Window::Window::frameStatisticsAvailable()
+    \internal
+*/
+
 /*!
     \qmlsignal QtQuick.Window::Window::afterRenderPassRecording()
     \internal
@@ -3172,6 +3227,83 @@ const QQuickWindow::GraphicsStateInfo &QQuickWindow::graphicsStateInfo()
     return d->rhiStateInfo;
 }
 
+/*!
+    \struct QQuickWindow::FrameStatistics
+    \inmodule QtQuick
+    \since 6.5
+
+    \brief Describes the work the scene graph did for one frame.
+
+    Times are in nanoseconds. The counters cover the window's scene graph
+    and the layers, such as \l ShaderEffectSource, rendered with it.
+
+    \list
+    \li \c polishTime - time spent polishing items.
+    \li \c syncTime - time spent synchronizing the items with the scene
+    graph, including waiting for the start of the frame.
+    \li \c renderTime - time spent preparing and recording the frame.
+    \li \c swapTime - time spent submitting and presenting the frame. With
+    vsync based throttling this includes waiting for the display.
+    \li \c animationTime - time spent advancing animations on the GUI thread
+    before the frame. Only measured by the \c threaded render loop.
+    \li \c batchCount - the number of batches drawn, which is the sum of
+    \c mergedBatchCount and \c unmergedBatchCount.
+    \li \c vertexBytesUploaded - the vertex and index data uploaded for
+    batches.
+    \li \c textureUploadCount - the number of texture uploads, including
+    atlas and glyph cache updates.
+    \li \c pipelineCreationCount - the number of graphics pipelines
+    created, which is typically non-zero only while new content appears.
+    \endlist
+
+    The batch, upload and pipeline counters are only maintained by the
+    default, QRhi based, adaptation of the scene graph.
+
+    \sa QQuickWindow::frameStatistics()
+ */
+
+/*!
+    Enables the collection of frame statistics when \a enabled is \c true.
+
+    Statistics are collected by the \c basic and \c threaded render loops.
+    While disabled, which is the default, collecting them costs nothing
+    beyond checking this setting a few times per frame.
+
+    \since 6.5
+    \sa frameStatistics(), frameStatisticsAvailable()
+ */
+void QQuickWindow::setFrameStatisticsEnabled(bool enabled)
+{
+    Q_D(QQuickWindow);
+    d->frameStatisticsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/*!
+    \return \c true if frame statistics are being collected.
+
+    \since 6.5
+ */
+bool QQuickWindow::isFrameStatisticsEnabled() const
+{
+    Q_D(const QQuickWindow);
+    return d->frameStatisticsEnabled.load(std::memory_order_relaxed);
+}
+
+/*!
+    \return the statistics of the most recently finished frame.
+
+    This function can be called from any thread.
+
+    \since 6.5
+    \sa setFrameStatisticsEnabled(), frameStatisticsAvailable()
+ */
+QQuickWindow::FrameStatistics QQuickWindow::frameStatistics() const
+{
+    Q_D(const QQuickWindow);
+    QMutexLocker locker(&d->frameStatisticsMutex);
+    return d->lastFrameStatistics;
+}
+
 /*!
     When mixing raw graphics (OpenGL, Vulkan, Metal, etc.) commands with scene
     graph rendering, it is necessary to call this function before recording
@@ -4169,6 +4301,159 @@ void QQuickWindow::setTextRenderType(QQuickWindow::TextRenderType renderType)
     QQuickWindowPrivate::textRenderType = renderType;
 }
 
+/*!
+    \enum QQuickWindow::MemoryPressureLevel
+    \since 6.5
+
+    This enum describes how urgently the system asks the application to use
+    less memory.
+
+    \value ModerateMemoryPressure Memory is getting low. Caches that are cheap
+    to refill should shrink.
+    \value CriticalMemoryPressure Memory is about to run out. Everything that
+    is not in use should be released.
+
+    \sa handleMemoryPressure()
+*/
+
+/*!
+    \struct QQuickWindow::ImageCacheStatistics
+    \inmodule QtQuick
+    \since 6.5
+
+    \brief Describes the state of the cache that Qt Quick keeps of loaded images.
+
+    The cost of an image is the size of its texture, plus the size of the
+    copy of the image that is kept in memory to be able to recreate the
+    texture.
+
+    \list
+    \li \c referencedBytes - the cost of the images in use by items.
+    \li \c unreferencedBytes - the cost of the images that are no longer in
+    use, but are kept in case they are needed again.
+    \li \c unreferencedCount - the number of images that are no longer in use.
+    \li \c cachedCount - the number of cached images, in use or not.
+    \li \c hits - how often loading an image found it in the cache.
+    \li \c misses - how often loading a cacheable image had to load it.
+    \li \c evictions - how many unused images were released to keep the cache
+    within its limits.
+    \endlist
+
+    \sa QQuickWindow::imageCacheStatistics()
+ */
+
+/*!
+    \since 6.5
+
+    Sets the limits of the image cache that is shared by all windows.
+
+    Images that are no longer used by any item, such as the ones of a
+    delegate that was destroyed, are kept in the cache until their cost
+    exceeds \a unreferencedBytes. The default is 4 MB. Beyond that, the
+    least recently used ones are released.
+
+    \a totalBytes limits the cost of all images in the cache, in use or not.
+    Unused images are released, least recently used first, to stay within
+    it. Images in use are never released, so when they alone cost more than
+    \a totalBytes, no unused images are kept at all, and a warning is
+    printed. A negative \a totalBytes, which is the default, means that
+    there is no such limit.
+
+    Devices with little memory benefit from lower limits. Applications that
+    load the same large images repeatedly benefit from a higher
+    \a unreferencedBytes.
+
+    This function must be called from the GUI thread.
+
+    \sa imageCacheStatistics(), handleMemoryPressure()
+ */
+void QQuickWindow::setImageCacheLimits(qint64 totalBytes, qint64 unreferencedBytes)
+{
+    QQuickPixmap::setCacheLimits(totalBytes, unreferencedBytes);
+}
+
+/*!
+    \since 6.5
+
+    Returns the limit of the cost of all images in the cache, or a negative
+    value if there is none.
+
+    \sa setImageCacheLimits()
+ */
+qint64 QQuickWindow::totalImageCacheLimit()
+{
+    return QQuickPixmap::totalCacheLimit();
+}
+
+/*!
+    \since 6.5
+
+    Returns the limit of the cost of the unused images that are kept in the
+    cache.
+
+    \sa setImageCacheLimits()
+ */
+qint64 QQuickWindow::unreferencedImageCacheLimit()
+{
+    return QQuickPixmap::unreferencedCacheLimit();
+}
+
+/*!
+    \since 6.5
+
+    Returns the current state of the image cache shared by all windows,
+    together with hit, miss and eviction counts since the application started.
+
+    This function must be called from the GUI thread.
+
+    \sa setImageCacheLimits()
+ */
+QQuickWindow::ImageCacheStatistics QQuickWindow::imageCacheStatistics()
+{
+    const QQuickPixmap::CacheStatistics cache = QQuickPixmap::cacheStatistics();
+    ImageCacheStatistics statistics;
+    statistics.referencedBytes = cache.referencedBytes;
+    statistics.unreferencedBytes = cache.unreferencedBytes;
+    statistics.unreferencedCount = cache.unreferencedCount;
+    statistics.cachedCount = cache.cachedCount;
+    statistics.hits = cache.hits;
+    statistics.misses = cache.misses;
+    statistics.evictions = cache.evictions;
+    return statistics;
+}
+
+/*!
+    \since 6.5
+
+    Releases memory in response to a memory warning of the operating system.
+    Qt does not receive these warnings itself; applications call this
+    function from the platform specific notification, such as
+    \c onTrimMemory() on Android or \c didReceiveMemoryWarning on iOS.
+
+    With \a level ModerateMemoryPressure, unused images in the image cache
+    are released, least recently used first, until their cost is halved. With
+    CriticalMemoryPressure, all unused images are released and
+    releaseResources() is called on every QQuickWindow.
+
+    This function must be called from the GUI thread.
+
+    \sa setImageCacheLimits(), releaseResources()
+ */
+void QQuickWindow::handleMemoryPressure(MemoryPressureLevel level)
+{
+    if (level == ModerateMemoryPressure) {
+        QQuickPixmap::trimCache();
+        return;
+    }
+
+    QQuickPixmap::purgeCache();
+    const auto windows = QGuiApplication::allWindows();
+    for (QWindow *window : windows) {
+        if (QQuickWindow *quickWindow = qobject_cast<QQuickWindow *>(window))
+            quickWindow->releaseResources();
+    }
+}
+
 
 /*!
     \since 6.0
@@ -82,6 +82,12 @@ public:
     };
     Q_ENUM(TextRenderType)
 
+    enum MemoryPressureLevel {
+        ModerateMemoryPressure,
+        CriticalMemoryPressure
+    };
+    Q_ENUM(MemoryPressureLevel)
+
     explicit QQuickWindow(QWindow *parent = nullptr);
     explicit QQuickWindow(QQuickRenderControl *renderControl);
 
@@ -104,6 +110,24 @@ public:
         int framesInFlight;
     };
     const GraphicsStateInfo &graphicsStateInfo();
+
+    struct FrameStatistics {
+        qint64 polishTime = 0;
+        qint64 syncTime = 0;
+        qint64 renderTime = 0;
+        qint64 swapTime = 0;
+        qint64 animationTime = 0;
+        int batchCount = 0;
+        int mergedBatchCount = 0;
+        int unmergedBatchCount = 0;
+        qint64 vertexBytesUploaded = 0;
+        int textureUploadCount = 0;
+        int pipelineCreationCount = 0;
+    };
+    void setFrameStatisticsEnabled(bool enabled);
+    bool isFrameStatisticsEnabled() const;
+    FrameStatistics frameStatistics() const;
+
     void beginExternalCommands();
     void endExternalCommands();
     QQmlIncubationController *incubationController() const;
@@ -155,6 +179,21 @@ public:
     static TextRenderType textRenderType();
     static void setTextRenderType(TextRenderType renderType);
 
+    struct ImageCacheStatistics {
+        qint64 referencedBytes = 0;
+        qint64 unreferencedBytes = 0;
+        int unreferencedCount = 0;
+        int cachedCount = 0;
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+    static void setImageCacheLimits(qint64 totalBytes, qint64 unreferencedBytes);
+    static qint64 totalImageCacheLimit();
+    static qint64 unreferencedImageCacheLimit();
+    static ImageCacheStatistics imageCacheStatistics();
+    static void handleMemoryPressure(MemoryPressureLevel level);
+
 Q_SIGNALS:
     void frameSwapped();
     void sceneGraphInitialized();
@@ -180,6 +219,8 @@ Q_SIGNALS:
     Q_REVISION(6, 0) void beforeFrameBegin();
     Q_REVISION(6, 0) void afterFrameEnd();
 
+    Q_REVISION(6, 5) void frameStatisticsAvailable();
+
 public Q_SLOTS:
     void update();
     void releaseResources();
@@ -18,6 +18,7 @@
 #include <QtQuick/private/qquickdeliveryagent_p_p.h>
 #include <QtQuick/private/qquickevents_p_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgrenderer_p.h>
 #include <QtQuick/private/qquickpaletteproviderprivatebase_p.h>
 #include <QtQuick/private/qquickrendertarget_p.h>
 #include <QtQuick/private/qquickgraphicsdevice_p.h>
@@ -31,6 +32,8 @@
 #include <QtCore/qrunnable.h>
 #include <QtCore/qstack.h>
 
+#include <atomic>
+
 #include <QtGui/private/qevent_p.h>
 #include <QtGui/private/qpointingdevice_p.h>
 #include <QtGui/private/qwindow_p.h>
@@ -251,6 +254,17 @@ public:
     QOpenGLContext *openglContext();
 
     QQuickWindow::GraphicsStateInfo rhiStateInfo;
+
+    // Frame statistics. Polish and animation times are recorded on the GUI
+    // thread and taken over by the render thread in syncSceneGraph().
+    std::atomic<bool> frameStatisticsEnabled { false };
+    QQuickWindow::FrameStatistics pendingFrameStatistics;
+    QQuickWindow::FrameStatistics currentFrameStatistics;
+    QQuickWindow::FrameStatistics lastFrameStatistics;
+    mutable QMutex frameStatisticsMutex;
+    QSGFrameCounters frameCounters;
+    void finishFrameStatistics(qint64 syncTime, qint64 renderTime, qint64 swapTime);
+
     QRhi *rhi = nullptr;
     QRhiSwapChain *swapchain = nullptr;
     QRhiRenderBuffer *depthStencilForSwapchain = nullptr;
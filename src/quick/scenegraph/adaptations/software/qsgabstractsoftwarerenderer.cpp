@@ -9,8 +9,12 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QVarLengthArray>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
+#include <private/qsgparallel_p.h>
 
 Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
@@ -24,6 +28,9 @@ QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *conte
     // Setup special background node
     auto backgroundRenderable = new QSGSoftwareRenderableNode(QSGSoftwareRenderableNode::SimpleRect, m_background);
     addNodeMapping(m_background, backgroundRenderable);
+
+    // Tile size in device independent pixels, 0 disables tiled rendering
+    m_tileSize = qMax(0, qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDERER_TILE_SIZE"));
 }
 
 QSGAbstractSoftwareRenderer::~QSGAbstractSoftwareRenderer()
@@ -93,6 +100,9 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     if (m_renderableNodes.isEmpty())
         return dirtyRegion;
 
+    if (m_tileSize > 0 && renderNodesTiled(painter, &dirtyRegion))
+        return dirtyRegion;
+
     auto iterator = m_renderableNodes.begin();
     // First node is the background and needs to painted without blending
     auto backgroundNode = *iterator;
@@ -107,6 +117,106 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+/*
+    Splits the area to paint into tiles and paints the render list into each tile on a
+    separate thread. Every tile gets its own QPainter on a QImage that shares the memory of
+    the corresponding part of the target image, so the tiles never touch the same pixels.
+
+    Returns false, without painting anything, when the target is not a plain QImage with an
+    integer device pixel ratio, when the painter is already transformed or clipped, when
+    the render list contains render nodes, which paint through the window's painter, or
+    when the area is too small to be worth splitting.
+*/
+bool QSGAbstractSoftwareRenderer::renderNodesTiled(QPainter *painter, QRegion *dirtyRegion)
+{
+    QPaintDevice *device = painter->device();
+    if (device->devType() != QInternal::Image)
+        return false;
+    QImage *target = static_cast<QImage *>(device);
+    if (target->depth() < 8 || target->depth() % 8)
+        return false;
+
+    const qreal dpr = target->devicePixelRatio();
+    const int scale = qRound(dpr);
+    if (scale < 1 || !qFuzzyCompare(dpr, qreal(scale)))
+        return false;
+
+    if (!painter->combinedTransform().isIdentity() || painter->hasClipping())
+        return false;
+
+    QRegion paintRegion;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode)
+            return false;
+        if (node->willPaint())
+            paintRegion += node->dirtyRegion();
+    }
+
+    const QRect targetRect(0, 0, target->width() / scale, target->height() / scale);
+    const QRect bounds = paintRegion.boundingRect() & targetRect;
+    if (bounds.isEmpty())
+        return false;
+
+    QVector<QRect> tiles;
+    const int firstX = bounds.left() - bounds.left() % m_tileSize;
+    const int firstY = bounds.top() - bounds.top() % m_tileSize;
+    for (int y = firstY; y <= bounds.bottom(); y += m_tileSize) {
+        for (int x = firstX; x <= bounds.right(); x += m_tileSize) {
+            const QRect tile = QRect(x, y, m_tileSize, m_tileSize) & targetRect;
+            if (paintRegion.intersects(tile))
+                tiles.append(tile);
+        }
+    }
+    if (tiles.size() < 2)
+        return false;
+
+    struct PaintItem {
+        QSGSoftwareRenderableNode *node;
+        QRect bounds;
+    };
+    QVarLengthArray<PaintItem, 256> items;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (!node->willPaint())
+            continue;
+        node->prepareForPainting(dpr);
+        items.append({ node, node->dirtyRegion().boundingRect() });
+    }
+
+    const QPainter::RenderHints hints = painter->renderHints();
+    const int bytesPerPixel = target->depth() / 8;
+    const qsizetype bytesPerLine = target->bytesPerLine();
+    uchar *bits = target->bits();
+    QSGSoftwareRenderableNode *backgroundNode = m_renderableNodes.first();
+
+    qsg_parallelFor(tiles.size(), 1, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const QRect &tile = tiles.at(i);
+            QImage tileImage(bits + tile.y() * scale * bytesPerLine + tile.x() * scale * bytesPerPixel,
+                             tile.width() * scale, tile.height() * scale, bytesPerLine, target->format());
+            tileImage.setDevicePixelRatio(dpr);
+
+            QPainter tilePainter(&tileImage);
+            tilePainter.setRenderHints(hints);
+            tilePainter.setWindow(tile);
+            tilePainter.setViewport(0, 0, tile.width(), tile.height());
+            for (const PaintItem &item : items) {
+                if (item.bounds.intersects(tile) && item.node->dirtyRegion().intersects(tile))
+                    item.node->paint(&tilePainter, /*force opaque painting*/ item.node == backgroundNode);
+            }
+        }
+    });
+
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (node->willPaint())
+            *dirtyRegion += node->finishPainting();
+        else
+            node->renderNode(painter); // nothing to paint, only resets the dirty state
+    }
+
+    qCDebug(lc2DRender) << "rendered" << tiles.size() << "tiles of" << m_tileSize << "for" << bounds;
+    return true;
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
@@ -60,6 +60,7 @@ private:
     void nodeMaterialUpdated(QSGNode *node);
     void nodeMatrixUpdated(QSGNode *node);
     void nodeOpacityUpdated(QSGNode *node);
+    bool renderNodesTiled(QPainter *painter, QRegion *dirtyRegion);
 
     QHash<QSGNode*, QSGSoftwareRenderableNode*> m_nodes;
     QVector<QSGSoftwareRenderableNode*> m_renderableNodes;
@@ -70,6 +71,7 @@ private:
     QRegion m_obscuredRegion;
     qreal m_devicePixelRatio = 1;
     bool m_isOpaque = false;
+    int m_tileSize = 0;
 
     QSGSoftwareRenderableNodeUpdater *m_nodeUpdater;
 };
@@ -203,10 +203,7 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 {
     //We can only check for a device pixel ratio change when we know what
     //paint device is being used.
-    if (!qFuzzyCompare(painter->device()->devicePixelRatio(), m_devicePixelRatio)) {
-        m_devicePixelRatio = painter->device()->devicePixelRatio();
-        generateCornerPixmap();
-    }
+    setDevicePixelRatio(painter->device()->devicePixelRatio());
 
     if (painter->transform().isRotating()) {
         //Rotated rectangles lose the benefits of direct rendering, and have poor rendering
@@ -241,6 +238,14 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 
 }
 
+void QSGSoftwareInternalRectangleNode::setDevicePixelRatio(qreal ratio)
+{
+    if (qFuzzyCompare(ratio, m_devicePixelRatio))
+        return;
+    m_devicePixelRatio = ratio;
+    generateCornerPixmap();
+}
+
 bool QSGSoftwareInternalRectangleNode::isOpaque() const
 {
     if (m_radius > 0.0f)
@@ -41,6 +41,7 @@ public:
     void update() override;
 
     void paint(QPainter *);
+    void setDevicePixelRatio(qreal ratio);
 
     bool isOpaque() const;
     QRectF rect() const;
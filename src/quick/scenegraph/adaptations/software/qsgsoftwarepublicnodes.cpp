@@ -58,10 +58,15 @@ void QSGSoftwareImageNode::setTextureCoordinatesTransform(QSGImageNode::TextureC
     markDirty(DirtyGeometry);
 }
 
-void QSGSoftwareImageNode::paint(QPainter *painter)
+void QSGSoftwareImageNode::ensureCachedMirroredPixmap()
 {
     if (m_cachedMirroredPixmapIsDirty)
         updateCachedMirroredPixmap();
+}
+
+void QSGSoftwareImageNode::paint(QPainter *painter)
+{
+    ensureCachedMirroredPixmap();
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform, (m_filtering == QSGTexture::Linear));
     // Disable antialiased clipping. It causes transformed tiles to have gaps.
@@ -19,6 +19,7 @@
 #include <private/qsgplaintexture_p.h>
 
 #include <qmath.h>
+#include <QtCore/QMutex>
 
 Q_LOGGING_CATEGORY(lcRenderable, "qt.scenegraph.softwarecontext.renderable")
 
@@ -250,6 +251,36 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         }
     }
 
+    paint(painter, forceOpaquePainting);
+    return finishPainting();
+}
+
+bool QSGSoftwareRenderableNode::willPaint() const
+{
+    if (m_nodeType == RenderNode)
+        return m_isDirty && !qFuzzyIsNull(m_opacity);
+    return m_isDirty && !qFuzzyIsNull(m_opacity) && !m_dirtyRegion.isEmpty();
+}
+
+void QSGSoftwareRenderableNode::prepareForPainting(qreal devicePixelRatio)
+{
+    // Update the state the nodes would otherwise compute lazily in paint()
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+        m_handle.rectangleNode->setDevicePixelRatio(devicePixelRatio);
+        break;
+    case QSGSoftwareRenderableNode::SimpleImage:
+        static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->ensureCachedMirroredPixmap();
+        break;
+    default:
+        break;
+    }
+}
+
+void QSGSoftwareRenderableNode::paint(QPainter *painter, bool forceOpaquePainting) const
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+
     painter->save();
     painter->setOpacity(m_opacity);
 
@@ -289,7 +320,13 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         m_handle.rectangleNode->paint(painter);
         break;
     case QSGSoftwareRenderableNode::Glyph:
+    {
+        // Glyph runs share their font engine and its glyph cache, which must not be
+        // used by several threads at once when rendering tiles in parallel.
+        static QBasicMutex glyphMutex;
+        QMutexLocker locker(&glyphMutex);
         m_handle.glpyhNode->paint(painter);
+    }
         break;
     case QSGSoftwareRenderableNode::NinePatch:
         m_handle.ninePatchNode->paint(painter);
@@ -310,7 +347,10 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     }
 
     painter->restore();
+}
 
+QRegion QSGSoftwareRenderableNode::finishPainting()
+{
     QRegion areaToBeFlushed = m_dirtyRegion;
     m_previousDirtyRegion = QRegion(m_boundingRectMax);
     m_isDirty = false;
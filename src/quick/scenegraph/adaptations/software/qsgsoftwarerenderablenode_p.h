@@ -62,6 +62,14 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+
+    // Tiled rendering: prepareForPainting() and finishPainting() are called on the rendering
+    // thread, paint() may run for several tiles concurrently in between.
+    bool willPaint() const;
+    void prepareForPainting(qreal devicePixelRatio);
+    void paint(QPainter *painter, bool forceOpaquePainting = false) const;
+    QRegion finishPainting();
+
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
@@ -16,6 +16,7 @@
 #include <private/qqmlglobal_p.h>
 #include <private/qquickprofiler_p.h>
 #include <private/qsgtexture_p.h>
+#include <private/qsgrenderer_p.h>
 #include <private/qsgcompressedtexture_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -80,6 +81,7 @@ void Atlas::enqueueTextureUpload(QSGRhiAtlasTexture::TextureBase *t, QRhiResourc
 
     QRhiTextureUploadDescription desc(QRhiTextureUploadEntry(0, 0, subresDesc));
     rcub->uploadTexture(m_texture, desc);
+    QSGFrameCounters::countTextureUpload();
 
     qCDebug(QSG_LOG_TEXTUREIO, "compressed atlastexture upload, size %dx%d format 0x%x",
             t->textureSize().width(), t->textureSize().height(), m_format);
@@ -6,6 +6,7 @@
 #include <QDebug>
 #include <QtQuick/private/qquickwindow_p.h>
 #include <QtQuick/private/qquickitem_p.h>
+#include <QtQuick/private/qsgrenderer_p.h>
 #include <QtGui/private/qrhi_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -367,6 +368,7 @@ void QSGCompressedTexture::commitTextureOperations(QRhi *rhi, QRhiResourceUpdate
             QRhiTextureUploadEntry(0, 0,
                                    QRhiTextureSubresourceUploadDescription(
                                            m_textureData.getDataView().toByteArray())));
+    QSGFrameCounters::countTextureUpload();
 
     m_textureData = QTextureFileData(); // Release this memory, not needed anymore
 }
@@ -17,6 +17,12 @@
 
 #include "qsgrhivisualizer_p.h"
 
+#include <private/qsgparallel_p.h>
+#include <QtQuick/qsgflatcolormaterial.h>
+#include <QtQuick/qsgtexturematerial.h>
+#include <QtQuick/qsgvertexcolormaterial.h>
+#include <private/qsimd_p.h>
+
 #include <algorithm>
 
 QT_BEGIN_NAMESPACE
@@ -77,6 +83,8 @@ QSGMaterial::Flag QSGMaterial_FullMatrix = (QSGMaterial::Flag) (QSGMaterial::Req
 static bool isTranslate(const QMatrix4x4 &m) { return m.flags() <= QMatrix4x4::Translation; }
 static bool isScale(const QMatrix4x4 &m) { return m.flags() <= QMatrix4x4::Scale; }
 static bool is2DSafe(const QMatrix4x4 &m) { return m.flags() < QMatrix4x4::Rotation; }
+static bool isAxisAligned(const QMatrix4x4 &m) { return m.flags() < QMatrix4x4::Rotation2D; }
+static bool isAffine(const QMatrix4x4 &m) { return m.flags() < QMatrix4x4::Perspective; }
 
 const float OPAQUE_LIMIT                = 0.999f;
 
@@ -843,6 +851,7 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     , m_renderOrderRebuildLower(-1)
     , m_renderOrderRebuildUpper(-1)
 #endif
+    , m_damagedElements(64)
     , m_currentMaterial(nullptr)
     , m_currentShader(nullptr)
     , m_vertexUploadPool(256)
@@ -875,10 +884,15 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     m_batchNodeThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_NODE_THRESHOLD", 64);
     m_batchVertexThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_VERTEX_THRESHOLD", 1024);
     m_srbPoolThreshold = qt_sg_envInt("QSG_RENDERER_SRB_POOL_THRESHOLD", 1024);
+    m_parallelUploadThreshold = qt_sg_envInt("QSG_RENDERER_PARALLEL_UPLOAD_THRESHOLD", 16384);
+    m_occlusionCulling = qt_sg_envInt("QSG_RENDERER_OCCLUSION_CULLING", 1) != 0;
+    m_partialUpdate = qt_sg_envInt("QSG_RENDERER_PARTIAL_UPDATE", 0) != 0;
+    m_removedDamage.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
 
     if (Q_UNLIKELY(debug_build() || debug_render())) {
-        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d",
-               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold);
+        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d parallel upload: %d",
+               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold,
+               m_parallelUploadThreshold);
     }
 }
 
@@ -892,6 +906,7 @@ static void qsg_wipeBuffer(Buffer *buffer)
     // 2. We're using dedicated buffers because of visualization or IBO workaround
     //    and the data something we malloced and must be freed.
     free(buffer->data);
+    free(buffer->shadow);
 }
 
 static void qsg_wipeBatch(Batch *batch)
@@ -937,6 +952,7 @@ void Renderer::destroyGraphicsResources()
 
     qDeleteAll(m_samplers);
     m_stencilClipCommon.reset();
+    m_damageClear.reset();
     delete m_dummyTexture;
     m_visualizer->releaseResources();
 }
@@ -965,15 +981,15 @@ void Renderer::invalidateAndRecycleBatch(Batch *b)
     m_batchPool.add(b);
 }
 
-void Renderer::map(Buffer *buffer, int byteSize, bool isIndexBuf)
+void Renderer::map(Buffer *buffer, int byteSize, bool isIndexBuf, int poolOffset)
 {
     if (m_visualizer->mode() == Visualizer::VisualizeNothing) {
         // Common case, use a shared memory pool for uploading vertex data to avoid
         // excessive reevaluation
         QDataBuffer<char> &pool = isIndexBuf ? m_indexUploadPool : m_vertexUploadPool;
-        if (byteSize > pool.size())
-            pool.resize(byteSize);
-        buffer->data = pool.data();
+        if (poolOffset + byteSize > pool.size())
+            pool.resize(poolOffset + byteSize);
+        buffer->data = pool.data() + poolOffset;
     } else if (buffer->size != byteSize) {
         free(buffer->data);
         buffer->data = (char *) malloc(byteSize);
@@ -996,41 +1012,108 @@ void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
             delete buffer->buf;
             buffer->buf = nullptr;
         }
-    } else {
-        bool needsRebuild = false;
-        if (buffer->buf->size() < buffer->size) {
-            buffer->buf->setSize(buffer->size);
-            needsRebuild = true;
-        }
-        if (buffer->buf->type() != QRhiBuffer::Dynamic
-                && buffer->nonDynamicChangeCount > DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD)
-        {
-            buffer->buf->setType(QRhiBuffer::Dynamic);
-            buffer->nonDynamicChangeCount = 0;
-            needsRebuild = true;
-        }
-        if (needsRebuild) {
-            if (!buffer->buf->create()) {
-                qWarning("Failed to (re)build vertex/index buffer of size %d", buffer->size);
-                delete buffer->buf;
-                buffer->buf = nullptr;
-            }
+    }
+    bool needsRebuild = false;
+    if (buffer->buf && buffer->buf->size() < buffer->size) {
+        // Dynamic buffers belong to content that keeps changing, and that
+        // often grows a little at a time. Leave room for that instead of
+        // recreating the buffer every frame.
+        const bool dynamic = buffer->buf->type() == QRhiBuffer::Dynamic
+                || buffer->nonDynamicChangeCount > DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD;
+        buffer->buf->setSize(dynamic ? buffer->size + buffer->size / 2 : buffer->size);
+        needsRebuild = true;
+    }
+    if (buffer->buf && buffer->buf->type() != QRhiBuffer::Dynamic
+            && buffer->nonDynamicChangeCount > DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD)
+    {
+        buffer->buf->setType(QRhiBuffer::Dynamic);
+        buffer->nonDynamicChangeCount = 0;
+        needsRebuild = true;
+    }
+    if (needsRebuild) {
+        if (!buffer->buf->create()) {
+            qWarning("Failed to (re)build vertex/index buffer of size %d", buffer->size);
+            delete buffer->buf;
+            buffer->buf = nullptr;
         }
     }
     if (buffer->buf) {
+        int uploadedBytes = buffer->size;
         if (buffer->buf->type() != QRhiBuffer::Dynamic) {
             m_resourceUpdates->uploadStaticBuffer(buffer->buf,
                                                  0, buffer->size, buffer->data);
             buffer->nonDynamicChangeCount += 1;
         } else {
-            m_resourceUpdates->updateDynamicBuffer(buffer->buf, 0, buffer->size,
-                                                   buffer->data);
+            uploadedBytes = updateDynamicBuffer(buffer, needsRebuild);
         }
+        m_uploadedBufferBytes += uploadedBytes;
+        if (QSGFrameCounters *counters = QSGFrameCounters::current())
+            counters->bufferBytesUploaded += uploadedBytes;
     }
     if (m_visualizer->mode() == Visualizer::VisualizeNothing)
         buffer->data = nullptr;
 }
 
+/*
+    Uploads the contents of a dynamic vertex or index buffer, limited to the
+    ranges that differ from what the buffer already holds. When a few
+    elements of a large merged batch animate, this is a small part of the
+    batch. Indices typically do not change at all.
+
+    QRhi keeps a copy of dynamic buffers per frame in flight and applies
+    updates to each of them, so partial updates are safe regardless of how
+    many frames are in flight. Returns the number of bytes uploaded.
+ */
+int Renderer::updateDynamicBuffer(Buffer *buffer, bool rebuilt)
+{
+    const int size = buffer->size;
+    if (rebuilt || buffer->shadowSize != size) {
+        // The contents are unknown, or the layout changed, upload everything.
+        m_resourceUpdates->updateDynamicBuffer(buffer->buf, 0, size, buffer->data);
+        if (buffer->shadowSize != size) {
+            free(buffer->shadow);
+            buffer->shadow = (char *) malloc(size);
+            Q_CHECK_PTR(buffer->shadow);
+            buffer->shadowSize = size;
+        }
+        memcpy(buffer->shadow, buffer->data, size);
+        return size;
+    }
+
+    // Compare in blocks and merge ranges separated by short unchanged gaps,
+    // to keep the number of updates down.
+    const int blockSize = 256;
+    const int maxGap = 4 * blockSize;
+    int uploaded = 0;
+    int rangeStart = -1;
+    int rangeEnd = -1;
+    auto flush = [&]() {
+        const int length = rangeEnd - rangeStart;
+        m_resourceUpdates->updateDynamicBuffer(buffer->buf, rangeStart, length, buffer->data + rangeStart);
+        memcpy(buffer->shadow + rangeStart, buffer->data + rangeStart, length);
+        uploaded += length;
+    };
+    for (int offset = 0; offset < size; offset += blockSize) {
+        const int length = qMin(blockSize, size - offset);
+        if (memcmp(buffer->data + offset, buffer->shadow + offset, length) == 0)
+            continue;
+        if (rangeStart >= 0 && offset - rangeEnd > maxGap) {
+            flush();
+            rangeStart = -1;
+        }
+        if (rangeStart < 0)
+            rangeStart = offset;
+        rangeEnd = offset + length;
+    }
+    if (rangeStart >= 0)
+        flush();
+
+    if (Q_UNLIKELY(debug_upload()))
+        qDebug() << "  --- dynamic buffer" << buffer->buf << "updated" << uploaded << "of" << size << "bytes";
+
+    return uploaded;
+}
+
 BatchRootInfo *Renderer::batchRootInfo(Node *node)
 {
     BatchRootInfo *info = node->rootInfo();
@@ -1319,6 +1402,9 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
 
     shadowNode->dirtyState |= state;
 
+    if (m_partialUpdate)
+        nodeDamaged(shadowNode, state);
+
     if (state & QSGNode::DirtyMatrix && !shadowNode->isBatchRoot) {
         Q_ASSERT(node->type() == QSGNode::TransformNodeType);
         if (node->m_subtreeRenderableCount > m_batchNodeThreshold) {
@@ -1391,6 +1477,68 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
     QSGRenderer::nodeChanged(node, state);
 }
 
+/*
+ * Damage tracking for partial updates. Elements that change are collected in
+ * m_damagedElements and their area, both where they were in the last frame and where they
+ * are now, is added to the damage in updateDamage(). Removed elements add their last area
+ * right away, as they are gone by the time the frame is prepared. Render nodes can draw
+ * anywhere, so they damage everything.
+ */
+void Renderer::markDamaged(Element *e)
+{
+    if (!e || e->damaged)
+        return;
+    e->damaged = true;
+    m_damagedElements.add(e);
+}
+
+void Renderer::markSubtreeDamaged(Node *node)
+{
+    if (node->type() == QSGNode::GeometryNodeType)
+        markDamaged(node->element());
+    else if (node->type() == QSGNode::RenderNodeType)
+        m_fullDamage = true;
+
+    SHADOWNODE_TRAVERSE(node)
+        markSubtreeDamaged(child);
+}
+
+void Renderer::addRemovedSubtreeToDamage(Node *node)
+{
+    if (node->type() == QSGNode::GeometryNodeType) {
+        Element *e = node->element();
+        if (e && e->damageBoundsValid)
+            m_removedDamage |= e->damageBounds;
+    } else if (node->type() == QSGNode::RenderNodeType) {
+        m_fullDamage = true;
+    }
+
+    SHADOWNODE_TRAVERSE(node)
+        addRemovedSubtreeToDamage(child);
+}
+
+void Renderer::nodeDamaged(Node *node, QSGNode::DirtyState state)
+{
+    if (state & QSGNode::DirtyNodeRemoved) {
+        addRemovedSubtreeToDamage(node);
+        return;
+    }
+
+    const QSGNode::DirtyState changes = QSGNode::DirtyNodeAdded
+            | QSGNode::DirtyMatrix
+            | QSGNode::DirtyOpacity
+            | QSGNode::DirtyGeometry
+            | QSGNode::DirtyMaterial;
+    if (!(state & changes))
+        return;
+
+    // Transforms, opacity and clips affect everything below them.
+    if (node->type() == QSGNode::GeometryNodeType)
+        markDamaged(node->element());
+    else
+        markSubtreeDamaged(node);
+}
+
 /*
  * Traverses the tree and builds two list of geometry nodes. One for
  * the opaque and one for the translucent. These are populated
@@ -1700,6 +1848,190 @@ bool Renderer::checkOverlap(int first, int last, const Rect &bounds)
     return false;
 }
 
+QMatrix4x4 qsg_matrixForRoot(Node *node);
+
+/*
+ * Only the built-in materials are known to write every pixel they cover, custom ones may
+ * discard fragments even when they do not blend.
+ */
+static bool qsg_isOccludingMaterial(QSGMaterial *material)
+{
+    if (material->flags() & QSGMaterial::Blending)
+        return false;
+
+    static QSGMaterialType *const flatColorType = QSGFlatColorMaterial().type();
+    static QSGMaterialType *const vertexColorType = QSGVertexColorMaterial().type();
+    static QSGMaterialType *const opaqueTextureType = QSGOpaqueTextureMaterial().type();
+    static QSGMaterialType *const textureType = QSGTextureMaterial().type();
+
+    QSGMaterialType *type = material->type();
+    return type == flatColorType || type == vertexColorType
+            || type == opaqueTextureType || type == textureType;
+}
+
+/*
+ * Returns true for a strip of four vertices that fills the rectangle spanned by them, which is
+ * what plain rectangles and images produce. The triangles (0, 1, 2) and (1, 2, 3) fill the
+ * rectangle if 0-3 and 1-2 are its two diagonals.
+ */
+static bool qsg_isFilledRectangle(QSGGeometry *g)
+{
+    if (g->drawingMode() != QSGGeometry::DrawTriangleStrip || g->vertexCount() != 4)
+        return false;
+
+    const int positionOffset = qsg_positionAttribute(g);
+    if (positionOffset < 0)
+        return false;
+
+    int indices[4] = { 0, 1, 2, 3 };
+    if (g->indexCount() != 0) {
+        if (g->indexCount() != 4 || g->indexType() != QSGGeometry::UnsignedShortType)
+            return false;
+        const quint16 *indexData = g->indexDataAsUShort();
+        for (int i = 0; i < 4; ++i) {
+            if (indexData[i] > 3)
+                return false;
+            indices[i] = indexData[i];
+        }
+    }
+
+    Pt p[4];
+    const char *vd = static_cast<const char *>(g->vertexData()) + positionOffset;
+    for (int i = 0; i < 4; ++i)
+        p[i] = *reinterpret_cast<const Pt *>(vd + indices[i] * g->sizeOfVertex());
+
+    const auto isDiagonal = [](const Pt &a, const Pt &b) {
+        return a.x != b.x && a.y != b.y;
+    };
+    if (!isDiagonal(p[0], p[3]) || !isDiagonal(p[1], p[2]))
+        return false;
+
+    // Both diagonals must share their bounding box, and must not be the same diagonal.
+    const bool sameXRange = qMin(p[0].x, p[3].x) == qMin(p[1].x, p[2].x)
+            && qMax(p[0].x, p[3].x) == qMax(p[1].x, p[2].x);
+    const bool sameYRange = qMin(p[0].y, p[3].y) == qMin(p[1].y, p[2].y)
+            && qMax(p[0].y, p[3].y) == qMax(p[1].y, p[2].y);
+    const bool sameDiagonal = (p[1].x == p[0].x && p[1].y == p[0].y)
+            || (p[1].x == p[3].x && p[1].y == p[3].y);
+    return sameXRange && sameYRange && !sameDiagonal;
+}
+
+/*
+ * Occluders are opaque, unclipped rectangles that are not rotated. Only the largest few are
+ * kept, so that testing a batch against them stays cheap.
+ */
+void Renderer::collectOccluders(const QDataBuffer<Element *> &renderList)
+{
+    const int maxOccluders = 8;
+
+    for (int i = 0; i < renderList.size(); ++i) {
+        Element *e = renderList.at(i);
+        if (!e || e->removed || e->isRenderNode || !e->batch)
+            continue;
+
+        QSGGeometryNode *gn = e->node;
+        if (gn->clipList()
+                || gn->inheritedOpacity() <= OPAQUE_LIMIT
+                || !qsg_isOccludingMaterial(gn->activeMaterial())
+                || !isAxisAligned(*gn->matrix())
+                || !qsg_isFilledRectangle(gn->geometry())) {
+            continue;
+        }
+
+        Occluder occluder = { e, Rect() };
+        e->ensureBoundsValid();
+        if (e->boundsOutsideFloatRange)
+            continue;
+        occluder.bounds = e->bounds;
+        if (e->root) {
+            const QMatrix4x4 rootMatrix = qsg_matrixForRoot(e->root);
+            if (!isAxisAligned(rootMatrix))
+                continue;
+            occluder.bounds.map(rootMatrix);
+        }
+
+        const float area = occluder.bounds.area();
+        int pos = m_occluders.size();
+        while (pos > 0 && m_occluders.at(pos - 1).bounds.area() < area)
+            --pos;
+        if (pos >= maxOccluders)
+            continue;
+        m_occluders.insert(pos, occluder);
+        if (m_occluders.size() > maxOccluders)
+            m_occluders.removeLast();
+    }
+}
+
+/*
+ * A batch is occluded when each of its elements lies within an occluder which is rendered after
+ * it. All elements of a batch share the same root.
+ */
+bool Renderer::isBatchOccluded(Batch *batch) const
+{
+    if (batch->isRenderNode || !batch->first)
+        return false;
+
+    QMatrix4x4 rootMatrix;
+    if (batch->root) {
+        rootMatrix = qsg_matrixForRoot(batch->root);
+        if (!isAffine(rootMatrix))
+            return false;
+    }
+
+    for (Element *e = batch->first; e; e = e->nextInBatch) {
+        if (e->removed)
+            continue;
+        e->ensureBoundsValid();
+        if (e->boundsOutsideFloatRange)
+            return false;
+        Rect bounds = e->bounds;
+        if (batch->root)
+            bounds.map(rootMatrix);
+
+        bool covered = false;
+        for (const Occluder &occluder : m_occluders) {
+            if (occluder.element->order > e->order && occluder.bounds.contains(bounds)) {
+                covered = true;
+                break;
+            }
+        }
+        if (!covered)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Conservative occlusion culling: batches that are entirely hidden behind opaque rectangles
+ * drawn later are neither uploaded nor rendered. They keep their needsUpload state, so they
+ * are uploaded once they become visible again.
+ */
+void Renderer::cullOccludedBatches()
+{
+    m_occluders.clear();
+    m_culledBatchCount = 0;
+    m_culledElementCount = 0;
+
+    const Visualizer::VisualizeMode mode = m_visualizer->mode();
+    if (m_occlusionCulling
+            && m_renderMode != QSGRendererInterface::RenderMode3D
+            && (mode == Visualizer::VisualizeNothing || mode == Visualizer::VisualizeOcclusion)) {
+        collectOccluders(m_opaqueRenderList);
+        collectOccluders(m_alphaRenderList);
+    }
+
+    for (QDataBuffer<Batch *> *batches : { &m_opaqueBatches, &m_alphaBatches }) {
+        for (int i = 0; i < batches->size(); ++i) {
+            Batch *b = batches->at(i);
+            b->isCulled = !m_occluders.isEmpty() && isBatchOccluded(b);
+            if (b->isCulled) {
+                ++m_culledBatchCount;
+                m_culledElementCount += qsg_countNodesInBatch(b);
+            }
+        }
+    }
+}
+
 /*
  *
  * To avoid the O(n^2) checkOverlap check in most cases, we have the
@@ -1842,6 +2174,63 @@ static inline int qsg_fixIndexCount(int iCount, int drawMode)
  * iBase: The starting index for this element in the batch
  */
 
+/*
+ * The positions of merged vertices are transformed two at a time with SSE2. The operations are
+ * the same, and in the same order, as in Pt::map(), so the result does not depend on whether
+ * the vectorized or the scalar code path handled a vertex.
+ */
+static void qsg_translateVertices(char *vdata, int count, int stride, float dx, float dy)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128 t = _mm_setr_ps(dx, dy, dx, dy);
+    for (; i + 1 < count; i += 2) {
+        __m64 *p0 = reinterpret_cast<__m64 *>(vdata);
+        __m64 *p1 = reinterpret_cast<__m64 *>(vdata + stride);
+        __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), p0), p1);
+        v = _mm_add_ps(v, t);
+        _mm_storel_pi(p0, v);
+        _mm_storeh_pi(p1, v);
+        vdata += 2 * stride;
+    }
+#endif
+    for (; i < count; ++i) {
+        Pt *p = (Pt *) vdata;
+        p->x += dx;
+        p->y += dy;
+        vdata += stride;
+    }
+}
+
+static void qsg_transformVertices(char *vdata, int count, int stride, const float *m)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128 m0 = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+    const __m128 m1 = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+    const __m128 t = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+    for (; i + 1 < count; i += 2) {
+        __m64 *p0 = reinterpret_cast<__m64 *>(vdata);
+        __m64 *p1 = reinterpret_cast<__m64 *>(vdata + stride);
+        const __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), p0), p1);
+        const __m128 xs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 ys = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, m0), _mm_mul_ps(ys, m1)), t);
+        _mm_storel_pi(p0, r);
+        _mm_storeh_pi(p1, r);
+        vdata += 2 * stride;
+    }
+#endif
+    for (; i < count; ++i) {
+        Pt *p = (Pt *) vdata;
+        const float x = p->x;
+        const float y = p->y;
+        p->x = x * m[0] + y * m[4] + m[12];
+        p->y = x * m[1] + y * m[5] + m[13];
+        vdata += stride;
+    }
+}
+
 void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount)
 {
     if (Q_UNLIKELY(debug_upload())) qDebug() << "  - uploading element:" << e << e->node << (void *) *vertexData << (qintptr) (*zData - *vertexData) << (qintptr) (*indexData - *vertexData);
@@ -1856,19 +2245,10 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
 
     // apply vertex transform..
     char *vdata = *vertexData + vaOffset;
-    if (localx.flags() == QMatrix4x4::Translation) {
-        for (int i=0; i<vCount; ++i) {
-            Pt *p = (Pt *) vdata;
-            p->x += localxdata[12];
-            p->y += localxdata[13];
-            vdata += vSize;
-        }
-    } else if (localx.flags() > QMatrix4x4::Translation) {
-        for (int i=0; i<vCount; ++i) {
-            ((Pt *) vdata)->map(localx);
-            vdata += vSize;
-        }
-    }
+    if (localx.flags() == QMatrix4x4::Translation)
+        qsg_translateVertices(vdata, vCount, vSize, localxdata[12], localxdata[13]);
+    else if (localx.flags() > QMatrix4x4::Translation)
+        qsg_transformVertices(vdata, vCount, vSize, localxdata);
 
     if (useDepthBuffer()) {
         float *vzorder = (float *) *zData;
@@ -1952,22 +2332,121 @@ QMatrix4x4 qsg_matrixForRoot(Node *node)
     return *c->matrix();
 }
 
+/*
+ * Batches are uploaded in three steps. prepareBatchUpload() decides whether the batch is merged
+ * and how much memory its buffers need. fillBatchBuffers() then writes the vertex and index
+ * data. It only reads the scene graph and writes to the batch, so different batches can be
+ * filled concurrently. finishBatchUpload() hands the data over to the QRhi.
+ */
+
+void Renderer::uploadBatches(const QDataBuffer<Batch *> &batches, int *largestVBO, int *largestIBO)
+{
+    struct PendingUpload {
+        Batch *batch;
+        int vertexBufferSize;
+        int indexBufferSize;
+        int vertexPoolOffset;
+        int indexPoolOffset;
+    };
+
+    QVarLengthArray<PendingUpload, 64> pending;
+    int vertexCount = 0;
+    for (int i = 0; i < batches.size(); ++i) {
+        PendingUpload upload = { batches.at(i), 0, 0, 0, 0 };
+        if (prepareBatchUpload(upload.batch, &upload.vertexBufferSize, &upload.indexBufferSize)) {
+            pending.append(upload);
+            vertexCount += upload.batch->vertexCount;
+        }
+    }
+
+    const bool parallel = m_parallelUploadThreshold > 0
+            && vertexCount >= m_parallelUploadThreshold
+            && pending.size() > 1
+            && !debug_upload();
+
+    if (!parallel) {
+        for (const PendingUpload &upload : pending) {
+            map(&upload.batch->ibo, upload.indexBufferSize, true);
+            map(&upload.batch->vbo, upload.vertexBufferSize);
+            fillBatchBuffers(upload.batch);
+            finishBatchUpload(upload.batch);
+        }
+    } else {
+        // Give every batch its own range of the upload pools, so that the pools are not
+        // reallocated while the batches are being filled.
+        int vertexPoolSize = 0;
+        int indexPoolSize = 0;
+        for (PendingUpload &upload : pending) {
+            upload.vertexPoolOffset = vertexPoolSize;
+            upload.indexPoolOffset = indexPoolSize;
+            vertexPoolSize += (upload.vertexBufferSize + 15) & ~15;
+            indexPoolSize += (upload.indexBufferSize + 15) & ~15;
+        }
+        if (vertexPoolSize > m_vertexUploadPool.size())
+            m_vertexUploadPool.resize(vertexPoolSize);
+        if (indexPoolSize > m_indexUploadPool.size())
+            m_indexUploadPool.resize(indexPoolSize);
+
+        for (const PendingUpload &upload : pending) {
+            map(&upload.batch->ibo, upload.indexBufferSize, true, upload.indexPoolOffset);
+            map(&upload.batch->vbo, upload.vertexBufferSize, false, upload.vertexPoolOffset);
+        }
+
+        qsg_parallelFor(int(pending.size()), 1, [this, &pending](int begin, int end) {
+            for (int i = begin; i < end; ++i)
+                fillBatchBuffers(pending.at(i).batch);
+        });
+
+        // Recording the uploads stays in order, so the resource updates are the same as
+        // when uploading serially.
+        for (const PendingUpload &upload : pending)
+            finishBatchUpload(upload.batch);
+
+        *largestVBO = qMax(vertexPoolSize, *largestVBO);
+        *largestIBO = qMax(indexPoolSize, *largestIBO);
+    }
+
+    for (int i = 0; i < batches.size(); ++i) {
+        const Batch *b = batches.at(i);
+        *largestVBO = qMax(b->vbo.size, *largestVBO);
+        *largestIBO = qMax(b->ibo.size, *largestIBO);
+    }
+}
+
 void Renderer::uploadBatch(Batch *b)
+{
+    int vertexBufferSize = 0;
+    int indexBufferSize = 0;
+    if (!prepareBatchUpload(b, &vertexBufferSize, &indexBufferSize))
+        return;
+
+    map(&b->ibo, indexBufferSize, true);
+    map(&b->vbo, vertexBufferSize);
+    fillBatchBuffers(b);
+    finishBatchUpload(b);
+}
+
+bool Renderer::prepareBatchUpload(Batch *b, int *vertexBufferSize, int *indexBufferSize)
 {
     // Early out if nothing has changed in this batch..
     if (!b->needsUpload) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
-        return;
+        return false;
     }
 
     if (!b->first) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "is invalid...";
-        return;
+        return false;
+    }
+
+    if (b->isCulled) {
+        if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "is occluded...";
+        return false;
     }
 
     if (b->isRenderNode) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch: " << b << "is a render node...";
-        return;
+        return false;
     }
 
     // Figure out if we can merge or not, if not, then just render the batch as is..
@@ -2012,7 +2491,7 @@ void Renderer::uploadBatch(Batch *b)
     // Abort if there are no vertices in this batch.. We abort this late as
     // this is a broken usecase which we do not care to optimize for...
     if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
-        return;
+        return false;
 
     /* Allocate memory for this batch. Merged batches are divided into three separate blocks
            1. Vertex data for all elements, as they were in the QSGGeometry object, but
@@ -2036,14 +2515,21 @@ void Renderer::uploadBatch(Batch *b)
         ibufferSize = unmergedIndexSize;
     }
 
-    map(&b->ibo, ibufferSize, true);
-    map(&b->vbo, bufferSize);
+    *vertexBufferSize = bufferSize;
+    *indexBufferSize = ibufferSize;
+    return true;
+}
+
+void Renderer::fillBatchBuffers(Batch *b)
+{
+    QSGGeometry *g = b->first->node->geometry();
 
     if (Q_UNLIKELY(debug_upload())) qDebug() << " - batch" << b << " first:" << b->first << " root:"
                                              << b->root << " merged:" << b->merged << " positionAttribute" << b->positionAttribute
                                              << " vbo:" << b->vbo.buf << ":" << b->vbo.size;
 
     if (b->merged) {
+        Element *e;
         char *vertexData = b->vbo.data;
         char *zData = vertexData + b->vertexCount * g->sizeOfVertex();
         char *indexData = b->ibo.data;
@@ -2121,8 +2607,13 @@ void Renderer::uploadBatch(Batch *b)
             e = e->nextInBatch;
         }
     }
+}
+
+void Renderer::finishBatchUpload(Batch *b)
+{
 #ifndef QT_NO_DEBUG_OUTPUT
     if (Q_UNLIKELY(debug_upload())) {
+        QSGGeometry *g = b->first->node->geometry();
         const char *vd = b->vbo.data;
         qDebug() << "  -- Vertex Data, count:" << b->vertexCount << " - " << g->sizeOfVertex() << "bytes/vertex";
         for (int i=0; i<b->vertexCount; ++i) {
@@ -2240,6 +2731,8 @@ QRhiGraphicsPipeline *Renderer::buildStencilPipeline(const Batch *batch, bool fi
         delete ps;
         return nullptr;
     }
+    if (QSGFrameCounters *counters = QSGFrameCounters::current())
+        ++counters->pipelineCreations;
 
     return ps;
 }
@@ -2267,6 +2760,10 @@ void Renderer::updateClipState(const QSGClipNode *clipList, Batch *batch)
 
     ClipState::ClipType clipType = ClipState::NoClip;
     QRect scissorRect;
+    if (m_mainRenderPassContext.partialUpdate) {
+        clipType |= ClipState::ScissorClip;
+        scissorRect = m_damageScissor;
+    }
     QVarLengthArray<const QSGClipNode *, 4> stencilClipNodes;
     const QSGClipNode *clip = clipList;
 
@@ -2656,6 +3153,8 @@ bool Renderer::ensurePipelineState(Element *e, const ShaderManager::Shader *sms,
         delete ps;
         return false;
     }
+    if (QSGFrameCounters *counters = QSGFrameCounters::current())
+        ++counters->pipelineCreations;
 
     m_shaderManager->pipelineCache.insert(k, ps);
     if (depthPostPass)
@@ -3508,6 +4007,7 @@ void Renderer::render()
     if (!renderTarget().rt)
         return;
 
+    m_mainRenderPassContext.ownsRenderPass = true;
     prepareRenderPass(&m_mainRenderPassContext);
     beginRenderPass(&m_mainRenderPassContext);
     recordRenderPass(&m_mainRenderPassContext);
@@ -3522,6 +4022,7 @@ void Renderer::render()
 
 void Renderer::prepareInline()
 {
+    m_mainRenderPassContext.ownsRenderPass = false;
     prepareRenderPass(&m_mainRenderPassContext);
 }
 
@@ -3530,6 +4031,227 @@ void Renderer::renderInline()
     recordRenderPass(&m_mainRenderPassContext);
 }
 
+/*
+ * Maps a rectangle in scene coordinates to pixels the same way rectangular clips are mapped
+ * to scissor rectangles. The result has its origin at the bottom-left, like QRhiScissor.
+ */
+static QRect qsg_sceneRectToPixels(const Rect &r, const QMatrix4x4 &m, const QSize &deviceSize)
+{
+    const float invW = 1.0f / m(3, 3);
+    float fx1 = (r.tl.x * m(0, 0) + m(0, 3)) * invW;
+    float fy1 = (r.br.y * m(1, 1) + m(1, 3)) * invW;
+    float fx2 = (r.br.x * m(0, 0) + m(0, 3)) * invW;
+    float fy2 = (r.tl.y * m(1, 1) + m(1, 3)) * invW;
+    if (fx1 > fx2)
+        qSwap(fx1, fx2);
+    if (fy1 > fy2)
+        qSwap(fy1, fy2);
+
+    // One pixel of padding for antialiasing and rounding.
+    const int ix1 = qFloor((fx1 + 1) * deviceSize.width() * 0.5f) - 1;
+    const int iy1 = qFloor((fy1 + 1) * deviceSize.height() * 0.5f) - 1;
+    const int ix2 = qCeil((fx2 + 1) * deviceSize.width() * 0.5f) + 1;
+    const int iy2 = qCeil((fy2 + 1) * deviceSize.height() * 0.5f) + 1;
+    return QRect(ix1, iy1, ix2 - ix1, iy2 - iy1) & QRect(QPoint(), deviceSize);
+}
+
+static bool qsg_preservesColorContents(QRhiRenderTarget *rt)
+{
+    if (rt->resourceType() != QRhiResource::TextureRenderTarget)
+        return false;
+    return static_cast<QRhiTextureRenderTarget *>(rt)->flags()
+            .testFlag(QRhiTextureRenderTarget::PreserveColorContents);
+}
+
+/*
+ * Decides whether this frame can be a partial update and computes the damaged area. That
+ * needs the previous frame to still be in the render target, which is only the case for
+ * textures with preserved contents that we rendered the last frame into, with the same
+ * projection and clear color.
+ */
+void Renderer::updateDamage(RenderPassContext *ctx)
+{
+    ctx->partialUpdate = false;
+    m_damageScissor = QRect();
+
+    QRhiRenderTarget *rt = renderTarget().rt;
+
+    DamageState state;
+    state.rt = rt;
+    state.pixelSize = rt->pixelSize();
+    state.viewport = viewportRect();
+    state.projection = projectionMatrix();
+    state.clearColor = clearColor();
+
+    bool fullDamage = m_fullDamage
+            || !ctx->ownsRenderPass
+            || state.rt != m_lastDamageState.rt
+            || state.pixelSize != m_lastDamageState.pixelSize
+            || state.viewport != m_lastDamageState.viewport
+            || state.projection != m_lastDamageState.projection
+            || state.clearColor != m_lastDamageState.clearColor
+            || !m_renderNodeElements.isEmpty()
+            || m_visualizer->mode() != Visualizer::VisualizeNothing
+            || m_renderMode == QSGRendererInterface::RenderMode3D
+            || rt->sampleCount() > 1
+            || !qsg_preservesColorContents(rt);
+    m_fullDamage = false;
+    m_lastDamageState = state;
+
+    Rect damage = m_removedDamage;
+    m_removedDamage.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    for (int i = 0; i < m_damagedElements.size(); ++i) {
+        Element *e = m_damagedElements.at(i);
+        e->damaged = false;
+        if (e->removed)
+            continue;
+
+        if (e->damageBoundsValid)
+            damage |= e->damageBounds;
+        e->damageBoundsValid = false;
+
+        if (!e->node->geometry()->vertexCount())
+            continue;
+
+        e->ensureBoundsValid();
+        if (e->boundsOutsideFloatRange) {
+            fullDamage = true;
+            continue;
+        }
+        Rect bounds = e->bounds;
+        if (e->root) {
+            const QMatrix4x4 rootMatrix = qsg_matrixForRoot(e->root);
+            if (!isAffine(rootMatrix)) {
+                fullDamage = true;
+                continue;
+            }
+            bounds.map(rootMatrix);
+        }
+        e->damageBounds = bounds;
+        e->damageBoundsValid = true;
+        damage |= bounds;
+    }
+    m_damagedElements.reset();
+
+    const QRect targetRect(QPoint(), state.pixelSize);
+    if (fullDamage) {
+        m_damageRegion = targetRect;
+        return;
+    }
+
+    ctx->partialUpdate = true;
+    if (damage.tl.x > damage.br.x || damage.tl.y > damage.br.y) {
+        m_damageRegion = QRegion();
+        return;
+    }
+
+    const QSize deviceSize = deviceRect().size();
+    m_damageScissor = qsg_sceneRectToPixels(damage, projectionMatrixWithNativeNDC(), deviceSize);
+
+    // Report the damage with a top-left origin.
+    const QRect r = qsg_sceneRectToPixels(damage, projectionMatrix(), deviceSize);
+    m_damageRegion = QRect(r.x(), deviceSize.height() - r.y() - r.height(), r.width(), r.height())
+            & targetRect;
+}
+
+/*
+ * With preserved contents the render pass does not clear the target, so the damaged area is
+ * cleared by drawing a quad in the clear color, reusing the visualizer's shaders.
+ */
+void Renderer::prepareDamageClear()
+{
+    DamageClearData &d(m_damageClear);
+
+    if (!d.vs.isValid()) {
+        d.vs = QSGMaterialShaderPrivate::loadShader(
+                    QLatin1String(":/qt-project.org/scenegraph/shaders_ng/visualization.vert.qsb"));
+        d.fs = QSGMaterialShaderPrivate::loadShader(
+                    QLatin1String(":/qt-project.org/scenegraph/shaders_ng/visualization.frag.qsb"));
+    }
+
+    if (!d.vbuf) {
+        const float v[] = { -1, 1,   1, 1,   -1, -1,   1, -1 };
+        d.vbuf = m_rhi->newBuffer(QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, sizeof(v));
+        if (!d.vbuf->create())
+            return;
+        m_resourceUpdates->uploadStaticBuffer(d.vbuf, v);
+    }
+
+    const int UbufSize = 152; // see visualization.vert
+    if (!d.ubuf) {
+        d.ubuf = m_rhi->newBuffer(QRhiBuffer::Dynamic, QRhiBuffer::UniformBuffer, UbufSize);
+        if (!d.ubuf->create())
+            return;
+    }
+
+    const QMatrix4x4 ident;
+    m_resourceUpdates->updateDynamicBuffer(d.ubuf, 0, 64, ident.constData()); // matrix
+    m_resourceUpdates->updateDynamicBuffer(d.ubuf, 64, 64, ident.constData()); // rotation
+    const QColor c = clearColor();
+    const float color[4] = { float(c.redF()), float(c.greenF()), float(c.blueF()), float(c.alphaF()) };
+    m_resourceUpdates->updateDynamicBuffer(d.ubuf, 128, 16, color);
+    const float pattern = 0.0f;
+    m_resourceUpdates->updateDynamicBuffer(d.ubuf, 144, 4, &pattern);
+    const qint32 projection = 0;
+    m_resourceUpdates->updateDynamicBuffer(d.ubuf, 148, 4, &projection);
+
+    if (!d.srb) {
+        d.srb = m_rhi->newShaderResourceBindings();
+        d.srb->setBindings({ QRhiShaderResourceBinding::uniformBuffer(
+                                 0, QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
+                                 d.ubuf) });
+        if (!d.srb->create())
+            return;
+    }
+
+    if (d.ps && d.rpDesc != renderPassDescriptor()) {
+        delete d.ps;
+        d.ps = nullptr;
+    }
+
+    if (!d.ps) {
+        d.ps = m_rhi->newGraphicsPipeline();
+        d.ps->setFlags(QRhiGraphicsPipeline::UsesScissor);
+        d.ps->setTopology(QRhiGraphicsPipeline::TriangleStrip);
+        d.ps->setSampleCount(renderTarget().rt->sampleCount());
+        d.ps->setShaderStages({ { QRhiShaderStage::Vertex, d.vs },
+                                { QRhiShaderStage::Fragment, d.fs } });
+        QRhiVertexInputLayout inputLayout;
+        inputLayout.setBindings({ { 2 * sizeof(float) } });
+        inputLayout.setAttributes({ { 0, 0, QRhiVertexInputAttribute::Float2, 0 } });
+        d.ps->setVertexInputLayout(inputLayout);
+        d.ps->setShaderResourceBindings(d.srb);
+        d.ps->setRenderPassDescriptor(renderPassDescriptor());
+        if (!d.ps->create()) {
+            qWarning("Failed to build damage clear pipeline");
+            delete d.ps;
+            d.ps = nullptr;
+            return;
+        }
+        d.rpDesc = renderPassDescriptor();
+    }
+}
+
+void Renderer::recordDamageClear()
+{
+    const DamageClearData &d(m_damageClear);
+    if (!d.ps)
+        return;
+
+    QRhiCommandBuffer *cb = commandBuffer();
+    cb->setGraphicsPipeline(d.ps);
+    cb->setViewport(m_pstate.viewport);
+    m_pstate.viewportSet = true;
+    cb->setScissor(QRhiScissor(m_damageScissor.x(), m_damageScissor.y(),
+                               m_damageScissor.width(), m_damageScissor.height()));
+    m_pstate.scissorSet = true;
+    cb->setShaderResources(d.srb);
+    QRhiCommandBuffer::VertexInput vb(d.vbuf, 0);
+    cb->setVertexInput(0, 1, &vb);
+    cb->draw(4);
+}
+
 void Renderer::prepareRenderPass(RenderPassContext *ctx)
 {
     if (ctx->valid)
@@ -3570,6 +4292,12 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
 
     m_resourceUpdates = m_rhi->nextResourceUpdateBatch();
 
+    // Must happen before removed elements are deleted.
+    if (m_partialUpdate)
+        updateDamage(ctx);
+    else
+        ctx->partialUpdate = false;
+
     if (m_rebuild & (BuildRenderLists | BuildRenderListsForTaggedRoots)) {
         bool complete = (m_rebuild & BuildRenderLists) != 0;
         if (complete)
@@ -3648,27 +4376,22 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
                  : 0;
     }
 
+    // Element bounds and root matrices may have changed without a rebuild, so do this for
+    // every frame.
+    cullOccludedBatches();
+
     if (Q_UNLIKELY(debug_render())) ctx->timeSorting = ctx->timer.restart();
 
     int largestVBO = 0;
     int largestIBO = 0;
+    m_uploadedBufferBytes = 0;
 
     if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque Batches:");
-    for (int i=0; i<m_opaqueBatches.size(); ++i) {
-        Batch *b = m_opaqueBatches.at(i);
-        largestVBO = qMax(b->vbo.size, largestVBO);
-        largestIBO = qMax(b->ibo.size, largestIBO);
-        uploadBatch(b);
-    }
+    uploadBatches(m_opaqueBatches, &largestVBO, &largestIBO);
     if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
 
     if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Alpha Batches:");
-    for (int i=0; i<m_alphaBatches.size(); ++i) {
-        Batch *b = m_alphaBatches.at(i);
-        uploadBatch(b);
-        largestVBO = qMax(b->vbo.size, largestVBO);
-        largestIBO = qMax(b->ibo.size, largestIBO);
-    }
+    uploadBatches(m_alphaBatches, &largestVBO, &largestIBO);
     if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
 
     if (largestVBO * 2 < m_vertexUploadPool.size())
@@ -3678,8 +4401,10 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
 
     if (Q_UNLIKELY(debug_render())) {
         qDebug().nospace() << "Rendering:" << Qt::endl
+                           << " -> Uploaded: " << m_uploadedBufferBytes << " bytes of vertex and index data" << Qt::endl
                            << " -> Opaque: " << qsg_countNodesInBatches(m_opaqueBatches) << " nodes in " << m_opaqueBatches.size() << " batches..." << Qt::endl
-                           << " -> Alpha: " << qsg_countNodesInBatches(m_alphaBatches) << " nodes in " << m_alphaBatches.size() << " batches...";
+                           << " -> Alpha: " << qsg_countNodesInBatches(m_alphaBatches) << " nodes in " << m_alphaBatches.size() << " batches..." << Qt::endl
+                           << " -> Culled: " << m_culledElementCount << " nodes in " << m_culledBatchCount << " batches...";
     }
 
     m_current_opacity = 1;
@@ -3693,6 +4418,22 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     bool renderOpaque = !debug_noopaque();
     bool renderAlpha = !debug_noalpha();
 
+    if (ctx->partialUpdate) {
+        if (Q_UNLIKELY(debug_render()))
+            qDebug() << " -> Partial update:" << m_damageRegion;
+        if (m_damageScissor.isEmpty()) {
+            // Nothing changed, the target already has the right contents.
+            renderOpaque = false;
+            renderAlpha = false;
+        } else {
+            prepareDamageClear();
+            // Everything is scissored to the damaged area, on top of any clipping.
+            m_currentClipState.type = ClipState::ScissorClip;
+            m_currentClipState.scissor = QRhiScissor(m_damageScissor.x(), m_damageScissor.y(),
+                                                     m_damageScissor.width(), m_damageScissor.height());
+        }
+    }
+
     m_pstate.viewport = QRhiViewport(viewport.x(), deviceRect().bottom() - viewport.bottom(), viewport.width(), viewport.height());
     m_pstate.clearColor = clearColor();
     m_pstate.dsClear = QRhiDepthStencilClearValue(1.0f, 0);
@@ -3719,6 +4460,8 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     if (Q_LIKELY(renderOpaque)) {
         for (int i = 0, ie = m_opaqueBatches.size(); i != ie; ++i) {
             Batch *b = m_opaqueBatches.at(i);
+            if (b->isCulled)
+                continue;
             PreparedRenderBatch renderBatch;
             bool ok;
             if (b->merged)
@@ -3749,6 +4492,8 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     if (Q_LIKELY(renderAlpha)) {
         for (int i = 0, ie = m_alphaBatches.size(); i != ie; ++i) {
             Batch *b = m_alphaBatches.at(i);
+            if (b->isCulled)
+                continue;
             PreparedRenderBatch renderBatch;
             bool ok;
             if (b->merged)
@@ -3762,6 +4507,18 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
         }
     }
 
+    if (QSGFrameCounters *counters = QSGFrameCounters::current()) {
+        for (const auto *batches : { &ctx->opaqueRenderBatches, &ctx->alphaRenderBatches }) {
+            for (const PreparedRenderBatch &renderBatch : *batches) {
+                ++counters->batches;
+                if (renderBatch.batch->merged)
+                    ++counters->mergedBatches;
+                else
+                    ++counters->unmergedBatches;
+            }
+        }
+    }
+
     m_rebuild = 0;
 
 #if defined(QSGBATCHRENDERER_INVALIDATE_WEDGED_NODES)
@@ -3809,6 +4566,9 @@ void Renderer::recordRenderPass(RenderPassContext *ctx)
     QRhiCommandBuffer *cb = commandBuffer();
     cb->debugMarkBegin(QByteArrayLiteral("Qt Quick scene render"));
 
+    if (ctx->partialUpdate && !m_damageScissor.isEmpty())
+        recordDamageClear();
+
     for (int i = 0, ie = ctx->opaqueRenderBatches.count(); i != ie; ++i) {
         PreparedRenderBatch *renderBatch = &ctx->opaqueRenderBatches[i];
         if (renderBatch->batch->merged)
@@ -4000,6 +4760,8 @@ void Renderer::setVisualizationMode(const QByteArray &mode)
         m_visualizer->setMode(Visualizer::VisualizeBatches);
     else if (mode == "changes")
         m_visualizer->setMode(Visualizer::VisualizeChanges);
+    else if (mode == "occlusion")
+        m_visualizer->setMode(Visualizer::VisualizeOcclusion);
 }
 
 bool Renderer::hasVisualizationModeWithContinuousUpdate() const
@@ -245,6 +245,14 @@ struct Rect {
         return xOverlap && yOverlap;
     }
 
+    bool contains(const Rect &r) const {
+        return r.tl.x >= tl.x && r.tl.y >= tl.y && r.br.x <= br.x && r.br.y <= br.y;
+    }
+
+    float area() const {
+        return (br.x - tl.x) * (br.y - tl.y);
+    }
+
     bool isOutsideFloatRange() const {
         return tl.x < -QSG_RENDERER_COORD_LIMIT
                 || tl.y < -QSG_RENDERER_COORD_LIMIT
@@ -265,6 +273,10 @@ struct Buffer {
     char *data;
     QRhiBuffer *buf;
     uint nonDynamicChangeCount;
+    // What a dynamic buffer currently holds, so that only the ranges that
+    // changed need to be uploaded. Malloced, shadowSize bytes.
+    char *shadow;
+    int shadowSize;
 };
 
 struct Element {
@@ -276,6 +288,8 @@ struct Element {
         , orphaned(false)
         , isRenderNode(false)
         , isMaterialBlended(false)
+        , damaged(false)
+        , damageBoundsValid(false)
     {
     }
 
@@ -296,6 +310,7 @@ struct Element {
     Node *root = nullptr;
 
     Rect bounds; // in device coordinates
+    Rect damageBounds; // in scene coordinates, as of the last frame
 
     int order = 0;
     QRhiShaderResourceBindings *srb = nullptr;
@@ -309,6 +324,8 @@ struct Element {
     uint orphaned : 1;
     uint isRenderNode : 1;
     uint isMaterialBlended : 1;
+    uint damaged : 1;
+    uint damageBoundsValid : 1;
 };
 
 struct RenderNodeElement : public Element {
@@ -425,6 +442,7 @@ struct Batch
         isRenderNode = false;
         ubufDataValid = false;
         needsPurge = false;
+        isCulled = false;
         clipState.reset();
         blendConstant = QColor();
     }
@@ -445,6 +463,7 @@ struct Batch
     uint isRenderNode : 1;
     uint ubufDataValid : 1;
     uint needsPurge : 1;
+    uint isCulled : 1; // hidden behind opaque content, neither uploaded nor rendered
 
     mutable uint uploadedThisFrame : 1; // solely for debugging purposes
 
@@ -704,7 +723,8 @@ public:
         VisualizeBatches,
         VisualizeClipping,
         VisualizeChanges,
-        VisualizeOverdraw
+        VisualizeOverdraw,
+        VisualizeOcclusion
     };
 
     Visualizer(Renderer *renderer);
@@ -731,6 +751,8 @@ public:
     Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMode renderMode = QSGRendererInterface::RenderMode2D);
     ~Renderer();
 
+    QRegion damageRegion() const override { return m_damageRegion; }
+
 protected:
     void nodeChanged(QSGNode *node, QSGNode::DirtyState state) override;
     void render() override;
@@ -745,6 +767,8 @@ protected:
 
     struct RenderPassContext {
         bool valid = false;
+        bool ownsRenderPass = false; // begin/endRenderPass() are called with it
+        bool partialUpdate = false; // only the damaged area is redrawn
         QVarLengthArray<PreparedRenderBatch, 64> opaqueRenderBatches;
         QVarLengthArray<PreparedRenderBatch, 64> alphaRenderBatches;
         QElapsedTimer timer;
@@ -779,8 +803,9 @@ private:
     friend class RhiVisualizer;
 
     void destroyGraphicsResources();
-    void map(Buffer *buffer, int size, bool isIndexBuf = false);
+    void map(Buffer *buffer, int size, bool isIndexBuf = false, int poolOffset = 0);
     void unmap(Buffer *buffer, bool isIndexBuf = false);
+    int updateDynamicBuffer(Buffer *buffer, bool rebuilt);
 
     void buildRenderListsFromScratch();
     void buildRenderListsForTaggedRoots();
@@ -793,8 +818,15 @@ private:
     bool checkOverlap(int first, int last, const Rect &bounds);
     void prepareAlphaBatches();
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
+    void collectOccluders(const QDataBuffer<Element *> &renderList);
+    bool isBatchOccluded(Batch *batch) const;
+    void cullOccludedBatches();
 
+    void uploadBatches(const QDataBuffer<Batch *> &batches, int *largestVBO, int *largestIBO);
     void uploadBatch(Batch *b);
+    bool prepareBatchUpload(Batch *b, int *vertexBufferSize, int *indexBufferSize);
+    void fillBatchBuffers(Batch *b);
+    void finishBatchUpload(Batch *b);
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount);
 
     bool ensurePipelineState(Element *e, const ShaderManager::Shader *sms, bool depthPostPass = false);
@@ -840,6 +872,14 @@ private:
     void setVisualizationMode(const QByteArray &mode) override;
     bool hasVisualizationModeWithContinuousUpdate() const override;
 
+    void markDamaged(Element *e);
+    void markSubtreeDamaged(Node *node);
+    void addRemovedSubtreeToDamage(Node *node);
+    void nodeDamaged(Node *node, QSGNode::DirtyState state);
+    void updateDamage(RenderPassContext *ctx);
+    void prepareDamageClear();
+    void recordDamageClear();
+
     QSGDefaultRenderContext *m_context;
     QSGRendererInterface::RenderMode m_renderMode;
     QSet<Node *> m_taggedRoots;
@@ -870,6 +910,31 @@ private:
     int m_batchNodeThreshold;
     int m_batchVertexThreshold;
     int m_srbPoolThreshold;
+    int m_parallelUploadThreshold;
+    qint64 m_uploadedBufferBytes = 0; // for debug_render()
+    bool m_occlusionCulling;
+    bool m_partialUpdate;
+
+    struct Occluder {
+        Element *element;
+        Rect bounds; // in scene coordinates
+    };
+    QVarLengthArray<Occluder, 8> m_occluders;
+    int m_culledBatchCount = 0;
+    int m_culledElementCount = 0;
+
+    QDataBuffer<Element *> m_damagedElements;
+    Rect m_removedDamage; // in scene coordinates
+    bool m_fullDamage = true;
+    QRect m_damageScissor;
+    QRegion m_damageRegion;
+    struct DamageState {
+        QRhiRenderTarget *rt = nullptr;
+        QSize pixelSize;
+        QRect viewport;
+        QMatrix4x4 projection;
+        QColor clearColor;
+    } m_lastDamageState;
 
     Visualizer *m_visualizer;
 
@@ -905,6 +970,17 @@ private:
         inline void reset();
     } m_stencilClipCommon;
 
+    struct DamageClearData {
+        QRhiGraphicsPipeline *ps = nullptr;
+        QRhiRenderPassDescriptor *rpDesc = nullptr;
+        QRhiShaderResourceBindings *srb = nullptr;
+        QRhiBuffer *vbuf = nullptr;
+        QRhiBuffer *ubuf = nullptr;
+        QShader vs;
+        QShader fs;
+        inline void reset();
+    } m_damageClear;
+
     inline int mergedIndexElemSize() const;
     inline bool useDepthBuffer() const;
     inline void setStateForDepthPostPass();
@@ -966,6 +1042,25 @@ void Renderer::StencilClipCommonData::reset()
     fs = QShader();
 }
 
+void Renderer::DamageClearData::reset()
+{
+    delete ps;
+    ps = nullptr;
+    rpDesc = nullptr;
+
+    delete srb;
+    srb = nullptr;
+
+    delete vbuf;
+    vbuf = nullptr;
+
+    delete ubuf;
+    ubuf = nullptr;
+
+    vs = QShader();
+    fs = QShader();
+}
+
 void ClipState::reset()
 {
     clipList = nullptr;
@@ -23,6 +23,18 @@ int qt_sg_envInt(const char *name, int defaultValue)
     return ok ? value : defaultValue;
 }
 
+static thread_local QSGFrameCounters *qsg_currentFrameCounters = nullptr;
+
+QSGFrameCounters *QSGFrameCounters::current()
+{
+    return qsg_currentFrameCounters;
+}
+
+void QSGFrameCounters::setCurrent(QSGFrameCounters *counters)
+{
+    qsg_currentFrameCounters = counters;
+}
+
 /*!
     \class QSGRenderer
     \brief The renderer class is the abstract baseclass used for rendering the
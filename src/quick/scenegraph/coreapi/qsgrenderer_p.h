@@ -20,6 +20,7 @@
 #include "qsgmaterial.h"
 
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtGui/qregion.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -32,6 +33,28 @@ class QRhiResourceUpdateBatch;
 Q_QUICK_PRIVATE_EXPORT bool qsg_test_and_clear_fatal_render_error();
 Q_QUICK_PRIVATE_EXPORT void qsg_set_fatal_renderer_error();
 
+// Per-frame counters behind QQuickWindow::frameStatistics(). current() is
+// only non-null on a render thread while it renders the scene graph of a
+// window that collects statistics, so counting is a no-op otherwise.
+struct Q_QUICK_PRIVATE_EXPORT QSGFrameCounters
+{
+    int batches = 0;
+    int mergedBatches = 0;
+    int unmergedBatches = 0;
+    qint64 bufferBytesUploaded = 0;
+    int textureUploads = 0;
+    int pipelineCreations = 0;
+
+    static QSGFrameCounters *current();
+    static void setCurrent(QSGFrameCounters *counters);
+
+    static void countTextureUpload()
+    {
+        if (QSGFrameCounters *counters = current())
+            ++counters->textureUploads;
+    }
+};
+
 class Q_QUICK_PRIVATE_EXPORT QSGRenderTarget
 {
 public:
@@ -74,6 +97,10 @@ public:
     virtual bool hasVisualizationModeWithContinuousUpdate() const { return false; }
     virtual void releaseCachedResources() { }
 
+    // The area of the render target, in pixels with the origin at the top-left, that
+    // changed in the last frame. Renderers that do not track damage report everything.
+    virtual QRegion damageRegion() const { return QRegion(deviceRect()); }
+
     void clearChangedFlag() { m_changed_emitted = false; }
 
     // Accessed by QSGMaterialShader::RenderState.
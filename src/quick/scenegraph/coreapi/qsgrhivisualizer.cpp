@@ -44,6 +44,7 @@ void RhiVisualizer::releaseResources()
     m_batchVis.releaseResources();
     m_clipVis.releaseResources();
     m_overdrawVis.releaseResources();
+    m_occlusionVis.releaseResources();
 }
 
 void RhiVisualizer::prepareVisualize()
@@ -88,6 +89,10 @@ void RhiVisualizer::prepareVisualize()
                               this,
                               m_renderer->m_rhi, m_renderer->m_resourceUpdates);
         break;
+    case VisualizeOcclusion:
+        m_occlusionVis.prepare(m_renderer, this,
+                               m_renderer->m_rhi, m_renderer->m_resourceUpdates);
+        break;
     default:
         Q_UNREACHABLE();
         break;
@@ -115,6 +120,9 @@ void RhiVisualizer::visualize()
     case VisualizeOverdraw:
         m_overdrawVis.render(cb);
         break;
+    case VisualizeOcclusion:
+        m_occlusionVis.render(cb);
+        break;
     default:
         Q_UNREACHABLE();
         break;
@@ -886,6 +894,124 @@ void RhiVisualizer::OverdrawVis::render(QRhiCommandBuffer *cb)
     visualizer->recordDrawCalls(drawCalls, cb, srb, true);
 }
 
+void RhiVisualizer::OcclusionVis::gather(Element *e, const QColor &color, float pattern)
+{
+    QSGGeometryNode *gn = e->node;
+    QSGGeometry *g = gn->geometry();
+    if (g->attributeCount() < 1)
+        return;
+
+    QMatrix4x4 matrix = visualizer->m_renderer->m_current_projection_matrix;
+    if (e->root)
+        matrix = matrix * qsg_matrixForRoot(e->root);
+    matrix = matrix * *gn->matrix();
+
+    const float alpha = 0.5f;
+
+    DrawCall dc;
+    memcpy(dc.uniforms.data, matrix.constData(), 64);
+    QMatrix4x4 rotation;
+    memcpy(dc.uniforms.data + 64, rotation.constData(), 64);
+    float c[4] = {
+        float(color.redF()) * alpha,
+        float(color.greenF()) * alpha,
+        float(color.blueF()) * alpha,
+        alpha
+    };
+    memcpy(dc.uniforms.data + 128, c, 16);
+    memcpy(dc.uniforms.data + 144, &pattern, 4);
+    qint32 projection = 0;
+    memcpy(dc.uniforms.data + 148, &projection, 4);
+
+    // Culled batches are not necessarily uploaded, so always use the node's own data.
+    fillVertexIndex(&dc, g, true, false);
+    drawCalls.append(dc);
+}
+
+void RhiVisualizer::OcclusionVis::prepare(Renderer *renderer, RhiVisualizer *visualizer,
+                                          QRhi *rhi, QRhiResourceUpdateBatch *u)
+{
+    this->visualizer = visualizer;
+
+    drawCalls.clear();
+
+    // Occluders in green, the content they hide in red on top of them.
+    for (const Renderer::Occluder &occluder : renderer->m_occluders)
+        gather(occluder.element, Qt::green, 0.0f);
+    for (const QDataBuffer<Batch *> *batches : { &renderer->m_opaqueBatches, &renderer->m_alphaBatches }) {
+        for (int i = 0; i < batches->size(); ++i) {
+            const Batch *b = batches->at(i);
+            if (!b->isCulled)
+                continue;
+            for (Element *e = b->first; e; e = e->nextInBatch) {
+                if (!e->removed)
+                    gather(e, Qt::red, 0.5f);
+            }
+        }
+    }
+
+    if (drawCalls.isEmpty())
+        return;
+
+    const int ubufAlign = rhi->ubufAlignment();
+    int vbufOffset = 0;
+    int ibufOffset = 0;
+    int ubufOffset = 0;
+    for (RhiVisualizer::DrawCall &dc : drawCalls) {
+        dc.buf.vbufOffset = aligned(vbufOffset, 4);
+        vbufOffset = dc.buf.vbufOffset + dc.vertex.count * dc.vertex.stride;
+
+        dc.buf.ibufOffset = aligned(ibufOffset, 4);
+        ibufOffset = dc.buf.ibufOffset + dc.index.count * dc.index.stride;
+
+        dc.buf.ubufOffset = aligned(ubufOffset, ubufAlign);
+        ubufOffset = dc.buf.ubufOffset + DrawCall::UBUF_SIZE;
+    }
+
+    ensureBuffer(rhi, &vbuf, QRhiBuffer::VertexBuffer, vbufOffset);
+    if (ibufOffset)
+        ensureBuffer(rhi, &ibuf, QRhiBuffer::IndexBuffer, ibufOffset);
+    const int ubufSize = ubufOffset;
+    ensureBuffer(rhi, &ubuf, QRhiBuffer::UniformBuffer, ubufSize);
+
+    for (RhiVisualizer::DrawCall &dc : drawCalls) {
+        u->updateDynamicBuffer(vbuf, dc.buf.vbufOffset, dc.vertex.count * dc.vertex.stride, dc.vertex.data);
+        dc.buf.vbuf = vbuf;
+        if (dc.index.count) {
+            u->updateDynamicBuffer(ibuf, dc.buf.ibufOffset, dc.index.count * dc.index.stride, dc.index.data);
+            dc.buf.ibuf = ibuf;
+        }
+        u->updateDynamicBuffer(ubuf, dc.buf.ubufOffset, DrawCall::UBUF_SIZE, dc.uniforms.data);
+    }
+
+    if (!srb) {
+        srb = rhi->newShaderResourceBindings();
+        srb->setBindings({ QRhiShaderResourceBinding::uniformBufferWithDynamicOffset(0, ubufVisibility, ubuf, DrawCall::UBUF_SIZE) });
+        if (!srb->create())
+            return;
+    }
+}
+
+void RhiVisualizer::OcclusionVis::releaseResources()
+{
+    delete srb;
+    srb = nullptr;
+
+    delete ubuf;
+    ubuf = nullptr;
+
+    delete ibuf;
+    ibuf = nullptr;
+
+    delete vbuf;
+    vbuf = nullptr;
+}
+
+void RhiVisualizer::OcclusionVis::render(QRhiCommandBuffer *cb)
+{
+    visualizer->recordDrawCalls(drawCalls, cb, srb);
+}
+
 }
 
 QT_END_NAMESPACE
@@ -183,11 +183,28 @@ private:
         } box;
     } m_overdrawVis;
 
+    class OcclusionVis {
+    public:
+        void prepare(Renderer *renderer, RhiVisualizer *visualizer,
+                     QRhi *rhi, QRhiResourceUpdateBatch *u);
+        void releaseResources();
+        void render(QRhiCommandBuffer *cb);
+    private:
+        void gather(Element *e, const QColor &color, float pattern);
+        RhiVisualizer *visualizer;
+        QVector<DrawCall> drawCalls;
+        QRhiBuffer *vbuf = nullptr;
+        QRhiBuffer *ibuf = nullptr;
+        QRhiBuffer *ubuf = nullptr;
+        QRhiShaderResourceBindings *srb = nullptr;
+    } m_occlusionVis;
+
     friend class Fade;
     friend class PipelineCache;
     friend class ChangeVis;
     friend class ClipVis;
     friend class OverdrawVis;
+    friend class OcclusionVis;
 };
 
 } // namespace QSGBatchRenderer
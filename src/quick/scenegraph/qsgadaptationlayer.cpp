@@ -13,6 +13,7 @@
 
 #include <private/qquickprofiler_p.h>
 #include <QElapsedTimer>
+#include <private/qsgparallel_p.h>
 
 #include <qtquick_tracepoints_p.h>
 
@@ -154,17 +155,27 @@ void QSGDistanceFieldGlyphCache::update()
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphRender_entry);
 
-    QList<QDistanceField> distanceFields;
+    // Looking up the glyph data may modify m_glyphsData, so collect the paths up front. Only
+    // the rendering itself may run on other threads.
     const int pendingGlyphsSize = m_pendingGlyphs.size();
-    distanceFields.reserve(pendingGlyphsSize);
+    QList<QPainterPath> paths(pendingGlyphsSize);
     for (int i = 0; i < pendingGlyphsSize; ++i) {
         GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
-        distanceFields.append(QDistanceField(gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
-        gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
+        paths[i] = std::exchange(gd.path, QPainterPath()); // no longer needed by the glyph data
     }
 
+    // Rendering the distance fields dominates the cost of large batches, for example when a
+    // screen full of CJK text first appears, and is independent for each glyph.
+    QList<QDistanceField> distanceFields(pendingGlyphsSize);
+    QDistanceField *results = distanceFields.data();
+    const glyph_t *glyphs = m_pendingGlyphs.data();
+    const bool doubleResolution = m_doubleGlyphResolution;
+    qsg_parallelFor(pendingGlyphsSize, 16, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            results[i] = QDistanceField(paths.at(i), glyphs[i], doubleResolution);
+    });
+    paths.clear(); // release memory used by the painter paths
+
     qint64 renderTime = 0;
     int count = m_pendingGlyphs.size();
     if (profileFrames)
@@ -100,6 +100,8 @@ public:
         return m_currentDevicePixelRatio;
     }
 
+    QSGRhiAtlasTexture::Manager *atlasManager() const { return m_rhiAtlasManager; }
+
     QRhiResourceUpdateBatch *maybeGlyphCacheResourceUpdates();
     QRhiResourceUpdateBatch *glyphCacheResourceUpdates();
     void releaseGlyphCacheResourceUpdates();
@@ -0,0 +1,265 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgdistancefielddiskcache_p.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qlockfile.h>
+#include <QtCore/qsavefile.h>
+#include <QtQuick/private/qsgcontext_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// The file is only ever read by the machine that wrote it, so everything is stored in native
+// byte order. The byte order mark rejects files copied from elsewhere.
+static const char Magic[8] = { 'Q', 'S', 'G', 'D', 'F', 'C', 'A', 'C' };
+static const quint32 Version = 1;
+static const quint32 ByteOrderMark = 0x01020304;
+static const int MaxGlyphSize = 4096;
+
+struct Header {
+    char magic[8];
+    quint32 version;
+    quint32 byteOrderMark;
+    char key[20];
+    quint32 reserved;
+};
+
+struct Record {
+    quint32 glyph;
+    quint32 width;
+    quint32 height;
+    quint32 reserved;
+    double boundingRect[4];
+};
+
+static_assert(sizeof(Header) % 8 == 0);
+static_assert(sizeof(Record) % 8 == 0);
+
+static qint64 alignedSize(qint64 size)
+{
+    return (size + 7) & ~qint64(7);
+}
+
+}
+
+QSGDistanceFieldDiskCache::QSGDistanceFieldDiskCache(const QString &fileName,
+                                                     const QByteArray &key)
+    : m_fileName(fileName)
+    , m_key(key)
+{
+    Q_ASSERT(m_key.size() == sizeof(Header::key));
+}
+
+QSGDistanceFieldDiskCache::~QSGDistanceFieldDiskCache()
+{
+    flush();
+    if (m_data)
+        m_file.unmap(m_data);
+}
+
+QSGDistanceFieldDiskCache *QSGDistanceFieldDiskCache::create(const QRawFont &referenceFont,
+                                                             bool doubleResolution, int padding)
+{
+    static const QString directory = qEnvironmentVariable("QSG_DISTANCEFIELD_CACHE_DIR");
+    if (directory.isEmpty())
+        return nullptr;
+
+    // The head table contains a checksum over the complete font file, so it identifies the
+    // file even if the same family is installed in different versions. The pixel size of the
+    // reference font is the size class the glyphs are rendered at.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(referenceFont.fontTable("head"));
+    hash.addData(referenceFont.familyName().toUtf8());
+    hash.addData(referenceFont.styleName().toUtf8());
+    const int parameters[] = {
+        referenceFont.weight(),
+        int(referenceFont.style()),
+        qRound(referenceFont.pixelSize()),
+        QT_DISTANCEFIELD_RADIUS(doubleResolution),
+        QT_DISTANCEFIELD_SCALE(doubleResolution),
+        padding
+    };
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(parameters), sizeof(parameters)));
+    const QByteArray key = hash.result();
+
+    const QString fileName = QDir(directory).filePath(QString::fromLatin1(key.toHex())
+                                                      + QLatin1String(".qsgdf"));
+    QSGDistanceFieldDiskCache *cache = new QSGDistanceFieldDiskCache(fileName, key);
+    cache->load();
+
+    qCDebug(QSG_LOG_INFO, "distancefield: %d cached glyphs for '%s' in '%s'",
+            int(cache->m_glyphs.size()), qPrintable(referenceFont.familyName()),
+            qPrintable(fileName));
+    return cache;
+}
+
+bool QSGDistanceFieldDiskCache::hasValidHeader(const uchar *data, qint64 size) const
+{
+    if (size < qint64(sizeof(Header)))
+        return false;
+
+    Header header;
+    memcpy(&header, data, sizeof(Header));
+    return memcmp(header.magic, Magic, sizeof(Magic)) == 0
+            && header.version == Version
+            && header.byteOrderMark == ByteOrderMark
+            && memcmp(header.key, m_key.constData(), sizeof(header.key)) == 0;
+}
+
+/*
+    Returns the size of the part of the file at data that holds complete records. The
+    glyphs in it are added to glyphs, unless that is null.
+*/
+qint64 QSGDistanceFieldDiskCache::readRecords(const uchar *data, qint64 size,
+                                              QHash<glyph_t, Glyph> *glyphs)
+{
+    qint64 offset = sizeof(Header);
+    while (size - offset >= qint64(sizeof(Record))) {
+        Record record;
+        memcpy(&record, data + offset, sizeof(Record));
+
+        const qint64 dataSize = qint64(record.width) * record.height;
+        if (record.width == 0 || record.width > MaxGlyphSize
+                || record.height == 0 || record.height > MaxGlyphSize
+                || size - offset - qint64(sizeof(Record)) < dataSize) {
+            break;
+        }
+
+        if (glyphs) {
+            Glyph &glyph = (*glyphs)[record.glyph];
+            glyph.boundingRect = QRectF(record.boundingRect[0], record.boundingRect[1],
+                                        record.boundingRect[2], record.boundingRect[3]);
+            glyph.width = int(record.width);
+            glyph.height = int(record.height);
+            glyph.bits = data + offset + sizeof(Record);
+        }
+
+        offset += sizeof(Record) + alignedSize(dataSize);
+    }
+    return qMin(offset, size);
+}
+
+void QSGDistanceFieldDiskCache::load()
+{
+    // flush() writes complete records under the lock, so a partial record that is found
+    // under the lock was left behind by a writer that crashed. It is dropped when the file
+    // is rewritten by the next flush().
+    QLockFile lock(m_fileName + QLatin1String(".lck"));
+    if (!QFileInfo::exists(m_fileName) || !lock.lock())
+        return;
+
+    m_file.setFileName(m_fileName);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return;
+
+    const qint64 size = m_file.size();
+    m_data = size > 0 ? m_file.map(0, size) : nullptr;
+    if (!m_data)
+        return;
+
+    if (hasValidHeader(m_data, size))
+        readRecords(m_data, size, &m_glyphs);
+}
+
+const QSGDistanceFieldDiskCache::Glyph *QSGDistanceFieldDiskCache::glyph(glyph_t glyph) const
+{
+    const auto it = m_glyphs.constFind(glyph);
+    return it == m_glyphs.constEnd() ? nullptr : &*it;
+}
+
+void QSGDistanceFieldDiskCache::insert(glyph_t glyph, const QRectF &boundingRect,
+                                       const QDistanceField &field)
+{
+    if (field.isNull() || field.width() > MaxGlyphSize || field.height() > MaxGlyphSize)
+        return;
+    if (m_glyphs.contains(glyph) || m_written.contains(glyph))
+        return;
+    m_written.insert(glyph);
+
+    Record record = {};
+    record.glyph = glyph;
+    record.width = quint32(field.width());
+    record.height = quint32(field.height());
+    record.boundingRect[0] = boundingRect.x();
+    record.boundingRect[1] = boundingRect.y();
+    record.boundingRect[2] = boundingRect.width();
+    record.boundingRect[3] = boundingRect.height();
+
+    const qint64 dataSize = qint64(field.width()) * field.height();
+    m_pending.append(reinterpret_cast<const char *>(&record), sizeof(Record));
+    m_pending.append(reinterpret_cast<const char *>(field.constBits()), dataSize);
+    m_pending.append(alignedSize(dataSize) - dataSize, '\0');
+}
+
+void QSGDistanceFieldDiskCache::flush()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    const QByteArray pending = m_pending;
+    m_pending.clear();
+    if (!QDir().mkpath(QFileInfo(m_fileName).absolutePath()))
+        return;
+
+    // Other processes using the same font may be reading or appending to the file at the
+    // same time.
+    QLockFile lock(m_fileName + QLatin1String(".lck"));
+    if (!lock.lock()) {
+        qWarning("Could not create distance field cache lock file '%s'",
+                 qPrintable(lock.fileName()));
+        return;
+    }
+
+    QFile file(m_fileName);
+    qint64 validSize = 0;
+    if (file.open(QIODevice::ReadOnly)) {
+        const qint64 size = file.size();
+        if (const uchar *data = size > 0 ? file.map(0, size) : nullptr) {
+            if (hasValidHeader(data, size))
+                validSize = readRecords(data, size, nullptr);
+            file.unmap(const_cast<uchar *>(data));
+        }
+    }
+
+    if (validSize > 0 && validSize == file.size()) {
+        file.close();
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)
+                || file.write(pending) != pending.size()) {
+            qWarning("Could not write distance field cache file '%s'", qPrintable(m_fileName));
+        }
+        return;
+    }
+
+    // The file is missing, was written by something else, or ends in a partial record.
+    // Other processes may have it mapped, and would crash if it shrank under them, so the
+    // complete records are copied into a new file that replaces it instead.
+    QByteArray contents;
+    if (validSize > 0) {
+        file.seek(0);
+        contents = file.read(validSize);
+    }
+    file.close();
+    if (contents.size() != validSize || validSize == 0) {
+        Header header = {};
+        memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.byteOrderMark = ByteOrderMark;
+        memcpy(header.key, m_key.constData(), sizeof(header.key));
+        contents = QByteArray(reinterpret_cast<const char *>(&header), sizeof(Header));
+    }
+
+    QSaveFile newFile(m_fileName);
+    if (!newFile.open(QIODevice::WriteOnly)
+            || newFile.write(contents) != contents.size()
+            || newFile.write(pending) != pending.size()
+            || !newFile.commit()) {
+        qWarning("Could not write distance field cache file '%s'", qPrintable(m_fileName));
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,76 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGDISTANCEFIELDDISKCACHE_P_H
+#define QSGDISTANCEFIELDDISKCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qrect.h>
+#include <QtCore/qset.h>
+#include <QtGui/qrawfont.h>
+#include <private/qdistancefield_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Persistent store of rendered distance-field glyphs, enabled by setting
+    QSG_DISTANCEFIELD_CACHE_DIR to a directory.
+
+    There is one file per font and size class. The file is memory mapped when the
+    cache is created. Glyphs rendered later on are appended to it by flush(). As
+    other processes can have the file mapped, it never shrinks. A file that can't
+    be appended to is replaced by a new one instead.
+*/
+class Q_QUICK_PRIVATE_EXPORT QSGDistanceFieldDiskCache
+{
+public:
+    struct Glyph {
+        QRectF boundingRect;
+        int width = 0;
+        int height = 0;
+        const uchar *bits = nullptr;
+    };
+
+    ~QSGDistanceFieldDiskCache();
+
+    static QSGDistanceFieldDiskCache *create(const QRawFont &referenceFont,
+                                             bool doubleResolution, int padding);
+
+    const QHash<glyph_t, Glyph> &glyphs() const { return m_glyphs; }
+    const Glyph *glyph(glyph_t glyph) const;
+
+    void insert(glyph_t glyph, const QRectF &boundingRect, const QDistanceField &field);
+    void flush();
+
+private:
+    QSGDistanceFieldDiskCache(const QString &fileName, const QByteArray &key);
+
+    void load();
+    bool hasValidHeader(const uchar *data, qint64 size) const;
+    static qint64 readRecords(const uchar *data, qint64 size, QHash<glyph_t, Glyph> *glyphs);
+
+    QString m_fileName;
+    QByteArray m_key;
+    QFile m_file;
+    uchar *m_data = nullptr;
+    QHash<glyph_t, Glyph> m_glyphs;
+    QSet<glyph_t> m_written;
+    QByteArray m_pending;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGDISTANCEFIELDDISKCACHE_P_H
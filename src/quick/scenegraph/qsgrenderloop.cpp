@@ -546,7 +546,8 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     QElapsedTimer renderTimer;
     qint64 renderTime = 0, syncTime = 0, polishTime = 0;
     const bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
-    if (profileFrames)
+    const bool collectStatistics = cd->frameStatisticsEnabled.load(std::memory_order_relaxed);
+    if (profileFrames || collectStatistics)
         renderTimer.start();
     Q_TRACE(QSG_polishItems_entry);
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
@@ -555,8 +556,10 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     cd->polishItems();
     m_inPolish = false;
 
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         polishTime = renderTimer.nsecsElapsed();
+    if (collectStatistics)
+        cd->pendingFrameStatistics.polishTime = polishTime;
 
     Q_TRACE(QSG_polishItems_exit);
     Q_QUICK_SG_PROFILE_SWITCH(QQuickProfiler::SceneGraphPolishFrame,
@@ -622,7 +625,7 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     if (lastDirtyWindow)
         rc->endSync();
 
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         syncTime = renderTimer.nsecsElapsed();
 
     Q_TRACE(QSG_sync_exit);
@@ -632,7 +635,7 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
 
     cd->renderSceneGraph(window->size(), effectiveOutputSize);
 
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         renderTime = renderTimer.nsecsElapsed();
     Q_TRACE(QSG_render_exit);
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
@@ -658,8 +661,10 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     emit window->afterFrameEnd();
 
     qint64 swapTime = 0;
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         swapTime = renderTimer.nsecsElapsed();
+    if (collectStatistics)
+        cd->finishFrameStatistics(syncTime - polishTime, renderTime - syncTime, swapTime - renderTime);
 
     Q_TRACE(QSG_swap_exit);
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphRenderLoopFrame,
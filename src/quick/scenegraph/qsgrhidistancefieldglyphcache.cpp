@@ -4,6 +4,7 @@
 #include "qsgrhidistancefieldglyphcache_p.h"
 #include "qsgcontext_p.h"
 #include "qsgdefaultrendercontext_p.h"
+#include "qsgrenderer_p.h"
 #include <QtGui/private/qdistancefield_p.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtQml/private/qqmlglobal_p.h>
@@ -27,7 +28,8 @@ QSGRhiDistanceFieldGlyphCache::QSGRhiDistanceFieldGlyphCache(QSGDefaultRenderCon
     , m_rhi(rc->rhi())
 {
     // Load a pregenerated cache if the font contains one
-    loadPregeneratedCache(font);
+    if (!loadPregeneratedCache(font))
+        loadDiskCache();
 }
 
 QSGRhiDistanceFieldGlyphCache::~QSGRhiDistanceFieldGlyphCache()
@@ -51,6 +53,7 @@ void QSGRhiDistanceFieldGlyphCache::requestGlyphs(const QSet<glyph_t> &glyphs)
 {
     QList<GlyphPosition> glyphPositions;
     QVector<glyph_t> glyphsToRender;
+    QVector<glyph_t> cachedGlyphs;
 
     if (m_areaAllocator == nullptr)
         m_areaAllocator = new QSGAreaAllocator(QSize(maxTextureSize(), m_maxTextureCount * maxTextureSize()));
@@ -94,6 +97,19 @@ void QSGRhiDistanceFieldGlyphCache::requestGlyphs(const QSet<glyph_t> &glyphs)
         TextureInfo *tex = textureInfo(alloc.y() / maxTextureSize());
         alloc = QRect(alloc.x(), alloc.y() % maxTextureSize(), alloc.width(), alloc.height());
 
+        // Glyphs from the disk cache are uploaded right away, they don't need to be rendered.
+        // The metrics of cached glyphs are seeded without an outline, so extract it if the
+        // cached glyph turns out to be unusable.
+        const QSGDistanceFieldDiskCache::Glyph *cached =
+                m_diskCache ? m_diskCache->glyph(glyphIndex) : nullptr;
+        const bool useCached = cached && cached->width == glyphSize.width()
+                && cached->height <= glyphSize.height();
+        if (cached && !useCached) {
+            GlyphData &gd = glyphData(glyphIndex);
+            if (gd.path.isEmpty())
+                gd.path = m_referenceFont.pathForGlyph(glyphIndex);
+        }
+
         tex->allocatedArea |= alloc;
         Q_ASSERT(tex->padding == padding || tex->padding < 0);
         tex->padding = padding;
@@ -103,12 +119,17 @@ void QSGRhiDistanceFieldGlyphCache::requestGlyphs(const QSet<glyph_t> &glyphs)
         p.position = alloc.topLeft() + QPoint(padding, padding);
 
         glyphPositions.append(p);
-        glyphsToRender.append(glyphIndex);
+        if (useCached)
+            cachedGlyphs.append(glyphIndex);
+        else
+            glyphsToRender.append(glyphIndex);
         m_glyphsTexture.insert(glyphIndex, tex);
     }
 
     setGlyphsPosition(glyphPositions);
     markGlyphsToRender(glyphsToRender);
+    if (!cachedGlyphs.isEmpty())
+        storeCachedGlyphs(cachedGlyphs);
 }
 
 bool QSGRhiDistanceFieldGlyphCache::isActive() const
@@ -116,14 +137,52 @@ bool QSGRhiDistanceFieldGlyphCache::isActive() const
     return m_unusedGlyphs.size() != m_glyphsTexture.size();
 }
 
-void QSGRhiDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField> &glyphs)
+void QSGRhiDistanceFieldGlyphCache::uploadGlyph(TextureInfo *texInfo, const TexCoord &c,
+                                                const uchar *bits, int width, int height)
 {
-    typedef QHash<TextureInfo *, QVector<glyph_t> > GlyphTextureHash;
-    typedef GlyphTextureHash::const_iterator GlyphTextureHashConstIt;
+    const int padding = texInfo->padding;
+    if (useTextureResizeWorkaround()) {
+        const uchar *inBits = bits;
+        uchar *outBits = texInfo->image.scanLine(int(c.y) - padding) + int(c.x) - padding;
+        for (int y = 0; y < height; ++y) {
+            memcpy(outBits, inBits, width);
+            inBits += width;
+            outBits += texInfo->image.width();
+        }
+    }
+
+    QRhiTextureSubresourceUploadDescription subresDesc(bits, width * height);
+    subresDesc.setSourceSize(QSize(width, height));
+    subresDesc.setDestinationTopLeft(QPoint(c.x - padding, c.y - padding));
+    texInfo->uploads.append(QRhiTextureUploadEntry(0, 0, subresDesc));
+}
+
+void QSGRhiDistanceFieldGlyphCache::commitGlyphUploads(const GlyphTextureHash &glyphTextures)
+{
+    QRhiResourceUpdateBatch *resourceUpdates = m_rc->glyphCacheResourceUpdates();
+    for (auto i = glyphTextures.constBegin(), cend = glyphTextures.constEnd(); i != cend; ++i) {
+        TextureInfo *texInfo = i.key();
+        if (!texInfo->uploads.isEmpty()) {
+            QRhiTextureUploadDescription desc;
+            desc.setEntries(texInfo->uploads.cbegin(), texInfo->uploads.cend());
+            resourceUpdates->uploadTexture(texInfo->texture, desc);
+            QSGFrameCounters::countTextureUpload();
+            texInfo->uploads.clear();
+        }
+    }
 
+    for (auto i = glyphTextures.constBegin(), cend = glyphTextures.constEnd(); i != cend; ++i) {
+        Texture t;
+        t.texture = i.key()->texture;
+        t.size = i.key()->size;
+        setGlyphsTexture(i.value(), t);
+    }
+}
+
+void QSGRhiDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField> &glyphs)
+{
     GlyphTextureHash glyphTextures;
 
-    QVarLengthArray<QRhiTextureUploadEntry, 32> uploads;
     for (int i = 0; i < glyphs.size(); ++i) {
         QDistanceField glyph = glyphs.at(i);
         glyph_t glyphIndex = glyph.glyph();
@@ -139,39 +198,33 @@ void QSGRhiDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField> &gly
         glyph = glyph.copy(-padding, -padding,
                            expectedWidth + padding  * 2, glyph.height() + padding * 2);
 
-        if (useTextureResizeWorkaround()) {
-            uchar *inBits = glyph.scanLine(0);
-            uchar *outBits = texInfo->image.scanLine(int(c.y) - padding) + int(c.x) - padding;
-            for (int y = 0; y < glyph.height(); ++y) {
-                memcpy(outBits, inBits, glyph.width());
-                inBits += glyph.width();
-                outBits += texInfo->image.width();
-            }
-        }
+        uploadGlyph(texInfo, c, glyph.constBits(), glyph.width(), glyph.height());
 
-        QRhiTextureSubresourceUploadDescription subresDesc(glyph.constBits(), glyph.width() * glyph.height());
-        subresDesc.setSourceSize(QSize(glyph.width(), glyph.height()));
-        subresDesc.setDestinationTopLeft(QPoint(c.x - padding, c.y - padding));
-        texInfo->uploads.append(QRhiTextureUploadEntry(0, 0, subresDesc));
+        if (m_diskCache)
+            m_diskCache->insert(glyphIndex, glyphData(glyphIndex).boundingRect, glyph);
     }
 
-    QRhiResourceUpdateBatch *resourceUpdates = m_rc->glyphCacheResourceUpdates();
-    for (int i = 0; i < glyphs.size(); ++i) {
-        TextureInfo *texInfo = m_glyphsTexture.value(glyphs.at(i).glyph());
-        if (!texInfo->uploads.isEmpty()) {
-            QRhiTextureUploadDescription desc;
-            desc.setEntries(texInfo->uploads.cbegin(), texInfo->uploads.cend());
-            resourceUpdates->uploadTexture(texInfo->texture, desc);
-            texInfo->uploads.clear();
-        }
-    }
+    commitGlyphUploads(glyphTextures);
 
-    for (GlyphTextureHashConstIt i = glyphTextures.constBegin(), cend = glyphTextures.constEnd(); i != cend; ++i) {
-        Texture t;
-        t.texture = i.key()->texture;
-        t.size = i.key()->size;
-        setGlyphsTexture(i.value(), t);
+    if (m_diskCache)
+        m_diskCache->flush();
+}
+
+void QSGRhiDistanceFieldGlyphCache::storeCachedGlyphs(const QVector<glyph_t> &glyphs)
+{
+    GlyphTextureHash glyphTextures;
+
+    for (glyph_t glyphIndex : glyphs) {
+        const QSGDistanceFieldDiskCache::Glyph *cached = m_diskCache->glyph(glyphIndex);
+        TextureInfo *texInfo = m_glyphsTexture.value(glyphIndex);
+
+        resizeTexture(texInfo, texInfo->allocatedArea.width(), texInfo->allocatedArea.height());
+
+        glyphTextures[texInfo].append(glyphIndex);
+        uploadGlyph(texInfo, glyphTexCoord(glyphIndex), cached->bits, cached->width, cached->height);
     }
+
+    commitGlyphUploads(glyphTextures);
 }
 
 void QSGRhiDistanceFieldGlyphCache::referenceGlyphs(const QSet<glyph_t> &glyphs)
@@ -319,6 +372,23 @@ namespace {
     };
 }
 
+void QSGRhiDistanceFieldGlyphCache::loadDiskCache()
+{
+    m_diskCache.reset(QSGDistanceFieldDiskCache::create(m_referenceFont, m_doubleGlyphResolution,
+                                                        QSG_RHI_DISTANCEFIELD_GLYPH_CACHE_PADDING));
+    if (!m_diskCache)
+        return;
+
+    // Seed the metrics of the cached glyphs, so that their outlines never have to be
+    // extracted from the font.
+    const auto &cachedGlyphs = m_diskCache->glyphs();
+    for (auto it = cachedGlyphs.constBegin(), end = cachedGlyphs.constEnd(); it != end; ++it) {
+        if (glyphCount() > 0 && int(it.key()) >= glyphCount())
+            continue;
+        emptyData(it.key()).boundingRect = it->boundingRect;
+    }
+}
+
 bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
 {
     // The pregenerated data must be loaded first, otherwise the area allocator
@@ -17,6 +17,7 @@
 
 #include "qsgadaptationlayer_p.h"
 #include <private/qsgareaallocator_p.h>
+#include <private/qsgdistancefielddiskcache_p.h>
 #include <QtGui/private/qrhi_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -53,6 +54,7 @@ public:
 
 private:
     bool loadPregeneratedCache(const QRawFont &font);
+    void loadDiskCache();
 
     struct TextureInfo {
         QRhiTexture *texture;
@@ -65,6 +67,13 @@ private:
         TextureInfo(const QRect &preallocRect = QRect()) : texture(nullptr), allocatedArea(preallocRect) { }
     };
 
+    typedef QHash<TextureInfo *, QVector<glyph_t> > GlyphTextureHash;
+
+    void uploadGlyph(TextureInfo *texInfo, const TexCoord &c, const uchar *bits,
+                     int width, int height);
+    void commitGlyphUploads(const GlyphTextureHash &glyphTextures);
+    void storeCachedGlyphs(const QVector<glyph_t> &glyphs);
+
     void createTexture(TextureInfo *texInfo, int width, int height, const void *pixels);
     void createTexture(TextureInfo *texInfo, int width, int height);
     void resizeTexture(TextureInfo *texInfo, int width, int height);
@@ -90,6 +99,7 @@ private:
     QHash<glyph_t, TextureInfo *> m_glyphsTexture;
     QSet<glyph_t> m_unusedGlyphs;
     QSet<QRhiTexture *> m_pendingDispose;
+    QScopedPointer<QSGDistanceFieldDiskCache> m_diskCache;
 };
 
 QT_END_NAMESPACE
@@ -3,6 +3,7 @@
 
 #include "qsgrhitextureglyphcache_p.h"
 #include "qsgdefaultrendercontext_p.h"
+#include "qsgrenderer_p.h"
 #include <qrgb.h>
 #include <private/qdrawhelper_p.h>
 
@@ -192,6 +193,7 @@ void QSGRhiTextureGlyphCache::endFillTexture()
     QRhiTextureUploadDescription desc;
     desc.setEntries(m_uploads.cbegin(), m_uploads.cend());
     resourceUpdates->uploadTexture(m_texture, desc);
+    QSGFrameCounters::countTextureUpload();
     m_uploads.clear();
 }
 
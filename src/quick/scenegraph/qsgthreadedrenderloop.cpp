@@ -61,6 +61,13 @@
 
    There is one thread per window and one QRhi instance per thread.
 
+   Unless QSG_RENDER_THREADS is set: then windows are distributed over at
+   most that many threads, each with one QRhi and one render context
+   shared by all its windows. The thread keeps the state of each of its
+   exposed windows and renders them one at a time, giving priority to the
+   window the GUI thread is blocked on in polishAndSync(), and taking the
+   others in turn.
+
    ---
 
    The render thread has affinity to the GUI thread until a window
@@ -88,6 +95,10 @@ extern Q_GUI_EXPORT QImage qt_gl_read_framebuffer(const QSize &size, bool alpha_
 // RL: Render Loop
 // RT: Render Thread
 
+// The WM_ events are only ever delivered through the render thread's own
+// event queue to QSGRenderThread::event(), so their values only need to be
+// unique among themselves.
+
 // Passed from the RL to the RT when a window is removed obscured and
 // should be removed from the render loop.
 const QEvent::Type WM_Obscure           = QEvent::Type(QEvent::User + 1);
@@ -111,6 +122,10 @@ const QEvent::Type WM_PostJob           = QEvent::Type(QEvent::User + 6);
 // the event filter installed on the QQuickWindow.
 const QEvent::Type WM_ReleaseSwapchain  = QEvent::Type(QEvent::User + 7);
 
+// Passed from the RL to the RT when a window is exposed and should be
+// rendered by the thread.
+const QEvent::Type WM_Expose            = QEvent::Type(QEvent::User + 8);
+
 template <typename T> T *windowFor(const QList<T> &list, QQuickWindow *window)
 {
     for (int i=0; i<list.size(); ++i) {
@@ -132,14 +147,16 @@ public:
 class WMTryReleaseEvent : public WMWindowEvent
 {
 public:
-    WMTryReleaseEvent(QQuickWindow *win, bool destroy, bool needsFallbackSurface)
+    WMTryReleaseEvent(QQuickWindow *win, bool destroy, bool needsFallbackSurface, bool shared)
         : WMWindowEvent(win, WM_TryRelease)
         , inDestructor(destroy)
         , needsFallback(needsFallbackSurface)
+        , sharedRenderContext(shared)
     {}
 
     bool inDestructor;
     bool needsFallback;
+    bool sharedRenderContext;
 };
 
 class WMSyncEvent : public WMWindowEvent
@@ -238,6 +255,7 @@ public:
         , syncResultedInChanges(false)
         , active(false)
         , window(nullptr)
+        , nextWindow(0)
         , stopEventProcessing(false)
     {
         sgrc = static_cast<QSGDefaultRenderContext *>(renderContext);
@@ -253,7 +271,7 @@ public:
         delete offscreenSurface;
     }
 
-    void invalidateGraphics(QQuickWindow *window, bool inDestructor);
+    void invalidateGraphics(QQuickWindow *window, bool inDestructor, bool sharedRenderContext);
 
     bool event(QEvent *) override;
     void run() override;
@@ -261,12 +279,14 @@ public:
     void syncAndRender();
     void sync(bool inExpose);
 
-    void requestRepaint()
+    void requestRepaint(QQuickWindow *w)
     {
         if (sleeping)
             stopEventProcessing = true;
-        if (window)
+        if (w == window)
             pendingUpdate |= RepaintRequest;
+        else if (ExposedWindow *ew = exposedWindow(w))
+            ew->pendingUpdate |= RepaintRequest;
     }
 
     void processEventsAndWaitForMore();
@@ -308,9 +328,26 @@ public:
 
     QElapsedTimer m_threadTimeBetweenRenders;
 
-    QQuickWindow *window; // Will be 0 when window is not exposed
+    // The exposed windows rendered by this thread. Only accessed on the
+    // render thread. With one thread per window there is at most one.
+    struct ExposedWindow {
+        QQuickWindow *window;
+        QSize size;
+        float dpr;
+        uint pendingUpdate;
+        bool renderedThisRound;
+    };
+    QList<ExposedWindow> exposedWindows;
+
+    ExposedWindow *exposedWindow(QQuickWindow *w);
+    int takeNextWindow();
+    void advanceAnimators();
+
+    QQuickWindow *window; // The window being rendered, 0 in between frames
     QSize windowSize;
     float dpr = 1;
+    int nextWindow;
+    bool animatorsAdvanced = false;
     int rhiSampleCount = 1;
     bool rhiDeviceLost = false;
     bool rhiDoomed = false;
@@ -325,17 +362,31 @@ bool QSGRenderThread::event(QEvent *e)
 {
     switch ((int) e->type()) {
 
+    case WM_Expose: {
+        qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "WM_Expose");
+        QQuickWindow *w = static_cast<WMWindowEvent *>(e)->window;
+        if (!exposedWindow(w))
+            exposedWindows.append({ w, QSize(), 1.0f, 0, false }); // size comes with the first sync
+        return true; }
+
     case WM_Obscure: {
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "WM_Obscure");
 
-        Q_ASSERT(!window || window == static_cast<WMWindowEvent *>(e)->window);
+        QQuickWindow *w = static_cast<WMWindowEvent *>(e)->window;
 
         mutex.lock();
-        if (window) {
-            QQuickWindowPrivate::get(window)->fireAboutToStop();
-            qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- window removed");
-            window = nullptr;
+        for (int i = 0; i < exposedWindows.size(); ++i) {
+            if (exposedWindows.at(i).window == w) {
+                QQuickWindowPrivate::get(w)->fireAboutToStop();
+                qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- window removed");
+                exposedWindows.removeAt(i);
+                if (nextWindow > i)
+                    --nextWindow;
+                break;
+            }
         }
+        if (window == w)
+            window = nullptr;
         waitCondition.wakeOne();
         mutex.unlock();
 
@@ -346,18 +397,22 @@ bool QSGRenderThread::event(QEvent *e)
         WMSyncEvent *se = static_cast<WMSyncEvent *>(e);
         if (sleeping)
             stopEventProcessing = true;
-        window = se->window;
-        windowSize = se->size;
-        dpr = se->dpr;
+        ExposedWindow *ew = exposedWindow(se->window);
+        if (!ew) {
+            exposedWindows.append({ se->window, se->size, se->dpr, 0, false });
+            ew = &exposedWindows.last();
+        }
+        ew->size = se->size;
+        ew->dpr = se->dpr;
 
-        pendingUpdate |= SyncRequest;
+        ew->pendingUpdate |= SyncRequest;
         if (se->syncInExpose) {
             qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- triggered from expose");
-            pendingUpdate |= ExposeRequest;
+            ew->pendingUpdate |= ExposeRequest;
         }
         if (se->forceRenderPass) {
             qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- repaint regardless");
-            pendingUpdate |= RepaintRequest;
+            ew->pendingUpdate |= RepaintRequest;
         }
         return true; }
 
@@ -366,17 +421,18 @@ bool QSGRenderThread::event(QEvent *e)
         mutex.lock();
         wm->m_lockedForSync = true;
         WMTryReleaseEvent *wme = static_cast<WMTryReleaseEvent *>(e);
-        if (!window || wme->inDestructor) {
+        if (!exposedWindow(wme->window) || wme->inDestructor) {
             qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- setting exit flag and invalidating");
-            invalidateGraphics(wme->window, wme->inDestructor);
+            invalidateGraphics(wme->window, wme->inDestructor, wme->sharedRenderContext);
             active = rhi != nullptr;
-            Q_ASSERT_X(!wme->inDestructor || !active, "QSGRenderThread::invalidateGraphics()", "Thread's active state is not set to false when shutting down");
+            Q_ASSERT_X(!wme->inDestructor || !active || wme->sharedRenderContext,
+                       "QSGRenderThread::invalidateGraphics()", "Thread's active state is not set to false when shutting down");
             if (sleeping)
                 stopEventProcessing = true;
         } else {
             qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- not releasing because window is still active");
-            if (window) {
-                QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
+            if (wme->window) {
+                QQuickWindowPrivate *d = QQuickWindowPrivate::get(wme->window);
                 if (d->renderer) {
                     qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- requesting renderer to release cached resources");
                     d->renderer->releaseCachedResources();
@@ -393,7 +449,6 @@ bool QSGRenderThread::event(QEvent *e)
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "WM_Grab");
         WMGrabEvent *ce = static_cast<WMGrabEvent *>(e);
         Q_ASSERT(ce->window);
-        Q_ASSERT(ce->window == window || !window);
         mutex.lock();
         if (ce->window) {
             if (rhi) {
@@ -420,8 +475,7 @@ bool QSGRenderThread::event(QEvent *e)
     case WM_PostJob: {
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "WM_PostJob");
         WMJobEvent *ce = static_cast<WMJobEvent *>(e);
-        Q_ASSERT(ce->window == window);
-        if (window) {
+        if (exposedWindow(ce->window)) {
             if (rhi)
                 rhi->makeThreadLocalNativeContextCurrent();
             ce->job->run();
@@ -453,7 +507,7 @@ bool QSGRenderThread::event(QEvent *e)
     return QThread::event(e);
 }
 
-void QSGRenderThread::invalidateGraphics(QQuickWindow *window, bool inDestructor)
+void QSGRenderThread::invalidateGraphics(QQuickWindow *window, bool inDestructor, bool sharedRenderContext)
 {
     qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "invalidateGraphics()");
 
@@ -475,14 +529,25 @@ void QSGRenderThread::invalidateGraphics(QQuickWindow *window, bool inDestructor
     // The canvas nodes must be cleaned up regardless if we are in the destructor..
     if (wipeSG) {
         dd->cleanupNodesOnShutdown();
-#if QT_CONFIG(quick_shadereffect)
-        QSGRhiShaderEffectNode::cleanupMaterialTypeCache();
-#endif
     } else {
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- persistent SG, avoiding cleanup");
         return;
     }
 
+    // The render context and the QRhi stay as long as other windows use them.
+    if (sharedRenderContext) {
+        qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- render context shared with other windows, avoiding cleanup");
+        if (inDestructor)
+            dd->animationController.reset();
+        if (wipeGraphics && dd->swapchain && window->handle())
+            wm->releaseSwapchain(window);
+        return;
+    }
+
+#if QT_CONFIG(quick_shadereffect)
+    QSGRhiShaderEffectNode::cleanupMaterialTypeCache();
+#endif
+
     sgrc->invalidate();
     QCoreApplication::processEvents();
     QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
@@ -580,9 +645,15 @@ void QSGRenderThread::handleDeviceLoss()
         return;
 
     qWarning("Graphics device lost, cleaning up scenegraph and releasing RHI");
-    QQuickWindowPrivate::get(window)->cleanupNodesOnShutdown();
+    for (const ExposedWindow &ew : std::as_const(exposedWindows))
+        QQuickWindowPrivate::get(ew.window)->cleanupNodesOnShutdown();
     sgrc->invalidate();
-    wm->releaseSwapchain(window);
+    for (const ExposedWindow &ew : std::as_const(exposedWindows)) {
+        wm->releaseSwapchain(ew.window);
+        // The caller takes care of the current window
+        if (ew.window != window)
+            QCoreApplication::postEvent(ew.window, new QEvent(QEvent::Type(QQuickWindowPrivate::FullUpdateRequest)));
+    }
     rhiDeviceLost = true;
     if (ownRhi)
         QSGRhiSupport::instance()->destroyRhi(rhi);
@@ -592,9 +663,10 @@ void QSGRenderThread::handleDeviceLoss()
 void QSGRenderThread::syncAndRender()
 {
     const bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
+    const bool collectStatistics = QQuickWindowPrivate::get(window)->frameStatisticsEnabled.load(std::memory_order_relaxed);
     QElapsedTimer threadTimer;
     qint64 syncTime = 0, renderTime = 0;
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         threadTimer.start();
     Q_TRACE_SCOPE(QSG_syncAndRender);
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphRenderLoopFrame);
@@ -685,7 +757,7 @@ void QSGRenderThread::syncAndRender()
         sync(exposeRequested);
     }
 #ifndef QSG_NO_RENDER_TIMING
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         syncTime = threadTimer.nsecsElapsed();
 #endif
     Q_TRACE(QSG_sync_exit);
@@ -714,10 +786,11 @@ void QSGRenderThread::syncAndRender()
     pendingUpdate = 0;
 
     // Advance render thread animations (from the QQuickAnimator subclasses).
-    if (animatorDriver->isRunning()) {
-        d->animationController->lock();
-        animatorDriver->advance();
-        d->animationController->unlock();
+    // They are shared by all windows of the thread, so only the first window
+    // rendered in a round advances them.
+    if (animatorDriver->isRunning() && !animatorsAdvanced) {
+        animatorsAdvanced = true;
+        advanceAnimators();
     }
 
     // Zero size windows do not initialize a swapchain and
@@ -730,7 +803,7 @@ void QSGRenderThread::syncAndRender()
 
         d->renderSceneGraph(windowSize, cd->swapchain->currentPixelSize());
 
-        if (profileFrames)
+        if (profileFrames || collectStatistics)
             renderTime = threadTimer.nsecsElapsed();
         Q_TRACE(QSG_render_exit);
         Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
@@ -747,6 +820,8 @@ void QSGRenderThread::syncAndRender()
                 QCoreApplication::postEvent(window, new QEvent(QEvent::Type(QQuickWindowPrivate::FullUpdateRequest)));
         }
         d->fireFrameSwapped();
+        if (collectStatistics)
+            d->finishFrameStatistics(syncTime, renderTime - syncTime, threadTimer.nsecsElapsed() - renderTime);
     } else {
         Q_TRACE(QSG_render_exit);
         Q_QUICK_SG_PROFILE_SKIP(QQuickProfiler::SceneGraphRenderLoopFrame,
@@ -809,6 +884,60 @@ void QSGRenderThread::postEvent(QEvent *e)
     eventQueue.addEvent(e);
 }
 
+QSGRenderThread::ExposedWindow *QSGRenderThread::exposedWindow(QQuickWindow *w)
+{
+    for (ExposedWindow &ew : exposedWindows) {
+        if (ew.window == w)
+            return &ew;
+    }
+    return nullptr;
+}
+
+/*
+    Picks the exposed window to render next, or returns -1 if none has
+    pending updates. A window the GUI thread waits on for sync goes first,
+    the others take turns so that a continuously animating window cannot
+    starve the rest.
+ */
+int QSGRenderThread::takeNextWindow()
+{
+    const int count = exposedWindows.size();
+    int picked = -1;
+    for (int i = 0; i < count; ++i) {
+        if (exposedWindows.at(i).pendingUpdate & SyncRequest) {
+            picked = i;
+            break;
+        }
+    }
+    for (int i = 0; picked < 0 && i < count; ++i) {
+        const int index = (nextWindow + i) % count;
+        if (exposedWindows.at(index).pendingUpdate)
+            picked = index;
+    }
+    if (picked < 0)
+        return -1;
+
+    nextWindow = (picked + 1) % count;
+
+    // A window coming up again starts a new round
+    if (exposedWindows.at(picked).renderedThisRound) {
+        for (ExposedWindow &ew : exposedWindows)
+            ew.renderedThisRound = false;
+        animatorsAdvanced = false;
+    }
+    exposedWindows[picked].renderedThisRound = true;
+    return picked;
+}
+
+void QSGRenderThread::advanceAnimators()
+{
+    for (const ExposedWindow &ew : std::as_const(exposedWindows))
+        QQuickWindowPrivate::get(ew.window)->animationController->lock();
+    animatorDriver->advance();
+    for (const ExposedWindow &ew : std::as_const(exposedWindows))
+        QQuickWindowPrivate::get(ew.window)->animationController->unlock();
+}
+
 
 
 void QSGRenderThread::processEvents()
@@ -923,7 +1052,15 @@ void QSGRenderThread::run()
         QMacAutoReleasePool frameReleasePool;
 #endif
 
-        if (window) {
+        const int index = takeNextWindow();
+        if (index >= 0) {
+            ExposedWindow &ew = exposedWindows[index];
+            window = ew.window;
+            windowSize = ew.size;
+            dpr = ew.dpr;
+            pendingUpdate = ew.pendingUpdate;
+            ew.pendingUpdate = 0;
+
             ensureRhi();
 
             // We absolutely have to syncAndRender() here, even when QRhi
@@ -933,6 +1070,12 @@ void QSGRenderThread::run()
 
             syncAndRender();
 
+            // Keep what got requested while rendering, e.g. by render
+            // thread animators, for the next round.
+            if (ExposedWindow *current = exposedWindow(window))
+                current->pendingUpdate |= pendingUpdate;
+            pendingUpdate = 0;
+
             // Now we can do something about rhi init failures. (reinit
             // failure after device reset does not count)
             if (rhiDoomed && !guiNotifiedAboutRhiFailure) {
@@ -940,12 +1083,16 @@ void QSGRenderThread::run()
                 QEvent *e = new QEvent(QEvent::Type(QQuickWindowPrivate::TriggerContextCreationFailure));
                 QCoreApplication::postEvent(window, e);
             }
+            window = nullptr;
         }
 
         processEvents();
         QCoreApplication::processEvents();
 
-        if (active && (pendingUpdate == 0 || !window)) {
+        bool pending = false;
+        for (const ExposedWindow &ew : std::as_const(exposedWindows))
+            pending |= ew.pendingUpdate != 0;
+        if (active && !pending) {
             qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "done drawing, sleep...");
             sleeping = true;
             processEventsAndWaitForMore();
@@ -966,6 +1113,7 @@ void QSGRenderThread::run()
 
 QSGThreadedRenderLoop::QSGThreadedRenderLoop()
     : sg(QSGContext::createDefaultContext())
+    , m_maxRenderThreads(qMax(0, qEnvironmentVariableIntValue("QSG_RENDER_THREADS")))
     , m_animation_timer(0)
 {
     m_animation_driver = sg->createAnimationDriver(this);
@@ -984,11 +1132,54 @@ QSGThreadedRenderLoop::~QSGThreadedRenderLoop()
 
 QSGRenderContext *QSGThreadedRenderLoop::createRenderContext(QSGContext *sg) const
 {
+    if (m_maxRenderThreads > 0) {
+        // Windows are assigned to a thread, by means of its render context,
+        // when they are created. Use a new thread while there are less than
+        // the maximum, otherwise the one with the fewest windows.
+        SharedThread *shared = nullptr;
+        if (m_sharedThreads.size() < m_maxRenderThreads) {
+            auto context = sg->createRenderContext();
+            pendingRenderContexts.insert(context);
+            m_sharedThreads.append({ context, nullptr, 0 });
+            shared = &m_sharedThreads.last();
+        } else {
+            shared = &m_sharedThreads.first();
+            for (SharedThread &candidate : m_sharedThreads) {
+                if (candidate.windowCount < shared->windowCount)
+                    shared = &candidate;
+            }
+        }
+        ++shared->windowCount;
+        qCDebug(QSG_LOG_RENDERLOOP) << "- render context" << shared->renderContext
+                                    << "now shared by" << shared->windowCount << "windows";
+        return shared->renderContext;
+    }
+
     auto context = sg->createRenderContext();
     pendingRenderContexts.insert(context);
     return context;
 }
 
+QSGThreadedRenderLoop::SharedThread *QSGThreadedRenderLoop::sharedThreadFor(QSGRenderContext *renderContext)
+{
+    return const_cast<SharedThread *>(std::as_const(*this).sharedThreadFor(renderContext));
+}
+
+const QSGThreadedRenderLoop::SharedThread *QSGThreadedRenderLoop::sharedThreadFor(QSGRenderContext *renderContext) const
+{
+    for (const SharedThread &shared : m_sharedThreads) {
+        if (shared.renderContext == renderContext)
+            return &shared;
+    }
+    return nullptr;
+}
+
+int QSGThreadedRenderLoop::windowsSharingRenderContext(QSGRenderContext *renderContext) const
+{
+    const SharedThread *shared = sharedThreadFor(renderContext);
+    return shared ? shared->windowCount : 1;
+}
+
 void QSGThreadedRenderLoop::postUpdateRequest(Window *w)
 {
     w->window->requestUpdate();
@@ -1132,18 +1323,47 @@ void QSGThreadedRenderLoop::windowDestroyed(QQuickWindow *window)
 {
     qCDebug(QSG_LOG_RENDERLOOP) << "begin windowDestroyed()" << window;
 
+    SharedThread *shared = sharedThreadFor(QQuickWindowPrivate::get(window)->context);
+
     Window *w = windowFor(m_windows, window);
-    if (!w)
-        return;
+    Window neverExposed;
+    if (!w) {
+        if (!shared)
+            return;
+        if (shared->windowCount > 1 || !shared->thread) {
+            // Only gives up its share of the render context, which has no
+            // thread yet if no window using it was ever exposed.
+            if (--shared->windowCount == 0) {
+                QSGRenderContext *renderContext = shared->renderContext;
+                pendingRenderContexts.remove(renderContext);
+                m_sharedThreads.removeIf([renderContext](const SharedThread &t) { return t.renderContext == renderContext; });
+                delete renderContext;
+            }
+            return;
+        }
+        // The last window of a shared thread takes the thread down, even
+        // if it was never exposed itself.
+        neverExposed.window = window;
+        neverExposed.thread = shared->thread;
+        neverExposed.exposed = false;
+        w = &neverExposed;
+    } else {
+        handleObscurity(w);
+    }
 
-    handleObscurity(w);
     releaseResources(w, true);
 
     QSGRenderThread *thread = w->thread;
-    while (thread->isRunning())
-        QThread::yieldCurrentThread();
-    Q_ASSERT(thread->thread() == QThread::currentThread());
-    delete thread;
+    if (shared)
+        --shared->windowCount;
+    if (!shared || shared->windowCount == 0) {
+        while (thread->isRunning())
+            QThread::yieldCurrentThread();
+        Q_ASSERT(thread->thread() == QThread::currentThread());
+        delete thread;
+        if (shared)
+            m_sharedThreads.removeIf([thread](const SharedThread &t) { return t.thread == thread; });
+    }
 
     for (int i=0; i<m_windows.size(); ++i) {
         if (m_windows.at(i).window == window) {
@@ -1224,12 +1444,21 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
         win.window = window;
         win.actualWindowFormat = window->format();
         auto renderContext = QQuickWindowPrivate::get(window)->context;
-        // The thread assumes ownership, so we don't need to delete it later.
-        pendingRenderContexts.remove(renderContext);
-        win.thread = new QSGRenderThread(this, renderContext);
+        SharedThread *shared = sharedThreadFor(renderContext);
+        if (shared && shared->thread) {
+            qCDebug(QSG_LOG_RENDERLOOP, "- sharing render thread");
+            win.thread = shared->thread;
+        } else {
+            // The thread assumes ownership, so we don't need to delete it later.
+            pendingRenderContexts.remove(renderContext);
+            win.thread = new QSGRenderThread(this, renderContext);
+            if (shared)
+                shared->thread = win.thread;
+        }
         win.updateDuringSync = false;
         win.forceRenderPass = true; // also covered by polishAndSync(inExpose=true), but doesn't hurt
         win.badVSync = false;
+        win.exposed = false;
         win.timeBetweenPolishAndSyncs.start();
         win.psTimeAccumulator = 0.0f;
         win.psTimeSampleCount = 0;
@@ -1239,7 +1468,8 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
 
     // set this early as we'll be rendering shortly anyway and this avoids
     // specialcasing exposure in polishAndSync.
-    w->thread->window = window;
+    w->exposed = true;
+    w->thread->postEvent(new WMWindowEvent(window, WM_Expose));
 
 #ifndef QT_NO_DEBUG
     if (w->window->width() <= 0 || w->window->height() <= 0
@@ -1263,14 +1493,8 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
             QSGRhiSupport *rhiSupport = QSGRhiSupport::instance();
             if (!w->thread->offscreenSurface)
                 w->thread->offscreenSurface = rhiSupport->maybeCreateOffscreenSurface(window);
-            window->installEventFilter(this);
         }
 
-        QQuickAnimatorController *controller
-                = QQuickWindowPrivate::get(w->window)->animationController.get();
-        if (controller->thread() != w->thread)
-            controller->moveToThread(w->thread);
-
         w->thread->active = true;
         if (w->thread->thread() == QThread::currentThread()) {
             w->thread->sgrc->moveToThread(w->thread);
@@ -1284,6 +1508,13 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
         qCDebug(QSG_LOG_RENDERLOOP, "- render thread already running");
     }
 
+    // With a shared thread this may be a window that joins a running thread
+    window->installEventFilter(this);
+    QQuickAnimatorController *controller
+            = QQuickWindowPrivate::get(w->window)->animationController.get();
+    if (controller->thread() != w->thread)
+        controller->moveToThread(w->thread);
+
     polishAndSync(w, true);
     qCDebug(QSG_LOG_RENDERLOOP, "- done with handleExposure()");
 
@@ -1306,6 +1537,7 @@ void QSGThreadedRenderLoop::handleObscurity(Window *w)
         w->thread->waitCondition.wait(&w->thread->mutex);
         w->thread->mutex.unlock();
     }
+    w->exposed = false;
     startOrStopAnimationTimer();
 }
 
@@ -1403,7 +1635,7 @@ void QSGThreadedRenderLoop::update(QQuickWindow *window)
 
     if (w->thread == QThread::currentThread()) {
         qCDebug(QSG_LOG_RENDERLOOP) << "update on window - on render thread" << w->window;
-        w->thread->requestRepaint();
+        w->thread->requestRepaint(window);
         return;
     }
 
@@ -1440,7 +1672,11 @@ void QSGThreadedRenderLoop::releaseResources(Window *w, bool inDestructor)
         // RHI resources.
 
         qCDebug(QSG_LOG_RENDERLOOP, "- posting release request to render thread");
-        w->thread->postEvent(new WMTryReleaseEvent(window, inDestructor, window->handle() == nullptr));
+        // The render thread must not look at m_sharedThreads, which only the
+        // GUI thread changes, so it is told whether other windows still use
+        // the render context.
+        const bool shared = windowsSharingRenderContext(QQuickWindowPrivate::get(window)->context) > 1;
+        w->thread->postEvent(new WMTryReleaseEvent(window, inDestructor, window->handle() == nullptr, shared));
         w->thread->waitCondition.wait(&w->thread->mutex);
 
         // Avoid a shutdown race condition.
@@ -1467,7 +1703,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     qCDebug(QSG_LOG_RENDERLOOP) << "polishAndSync" << (inExpose ? "(in expose)" : "(normal)") << w->window;
 
     QQuickWindow *window = w->window;
-    if (!w->thread || !w->thread->window) {
+    if (!w->thread || !w->exposed) {
         qCDebug(QSG_LOG_RENDERLOOP, "- not exposed, abort");
         return;
     }
@@ -1476,7 +1712,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     QQuickWindowPrivate::get(window)->flushFrameSynchronousEvents();
     // The delivery of the event might have caused the window to stop rendering
     w = windowFor(m_windows, window);
-    if (!w || !w->thread || !w->thread->window) {
+    if (!w || !w->thread || !w->exposed) {
         qCDebug(QSG_LOG_RENDERLOOP, "- removed after event flushing, abort");
         return;
     }
@@ -1542,8 +1778,10 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     }
 
     const bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
-    if (profileFrames) {
+    const bool collectStatistics = QQuickWindowPrivate::get(window)->frameStatisticsEnabled.load(std::memory_order_relaxed);
+    if (profileFrames || collectStatistics)
         timer.start();
+    if (profileFrames) {
         qCDebug(QSG_LOG_TIME_RENDERLOOP, "[window %p][gui thread] polishAndSync: start, elapsed since last call: %d ms",
                 window,
                 int(elapsedSinceLastMs));
@@ -1556,8 +1794,10 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     d->polishItems();
     m_inPolish = false;
 
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         polishTime = timer.nsecsElapsed();
+    if (collectStatistics)
+        d->pendingFrameStatistics.polishTime = polishTime;
     Q_TRACE(QSG_polishItems_exit);
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncPolish);
@@ -1574,7 +1814,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     w->forceRenderPass = false;
 
     qCDebug(QSG_LOG_RENDERLOOP, "- wait for sync");
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         waitTime = timer.nsecsElapsed();
     Q_TRACE(QSG_wait_exit);
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
@@ -1586,7 +1826,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     w->thread->mutex.unlock();
     qCDebug(QSG_LOG_RENDERLOOP, "- unlock after sync");
 
-    if (profileFrames)
+    if (profileFrames || collectStatistics)
         syncTime = timer.nsecsElapsed();
     Q_TRACE(QSG_sync_exit);
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
@@ -1601,6 +1841,9 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
         qCDebug(QSG_LOG_RENDERLOOP, "- advancing animations");
         m_animation_driver->advance();
         qCDebug(QSG_LOG_RENDERLOOP, "- animations done..");
+        // Reported with the next frame, as this one is synced already
+        if (collectStatistics)
+            d->pendingFrameStatistics.animationTime = timer.nsecsElapsed() - syncTime;
 
         // We need to trigger another update round to keep all animations
         // running correctly. For animations that lead to a visual change (a
@@ -1708,7 +1951,7 @@ QImage QSGThreadedRenderLoop::grab(QQuickWindow *window)
 void QSGThreadedRenderLoop::postJob(QQuickWindow *window, QRunnable *job)
 {
     Window *w = windowFor(m_windows, window);
-    if (w && w->thread && w->thread->window)
+    if (w && w->thread && w->exposed)
         w->thread->postEvent(new WMJobEvent(window, job));
     else
         delete job;
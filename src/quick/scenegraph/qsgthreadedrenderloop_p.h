@@ -72,11 +72,24 @@ private:
         uint updateDuringSync : 1;
         uint forceRenderPass : 1;
         uint badVSync : 1;
+        uint exposed : 1;
+    };
+
+    // A render thread serving several windows with one render context, see
+    // QSG_RENDER_THREADS. windowCount includes windows that were never exposed.
+    // Only used on the GUI thread.
+    struct SharedThread {
+        QSGRenderContext *renderContext;
+        QSGRenderThread *thread;
+        int windowCount;
     };
 
     friend class QSGRenderThread;
 
     void releaseResources(Window *window, bool inDestructor);
+    SharedThread *sharedThreadFor(QSGRenderContext *renderContext);
+    const SharedThread *sharedThreadFor(QSGRenderContext *renderContext) const;
+    int windowsSharingRenderContext(QSGRenderContext *renderContext) const;
     bool checkAndResetForceUpdate(QQuickWindow *window);
 
     bool anyoneShowing() const;
@@ -100,6 +113,8 @@ private:
     mutable QSet<QSGRenderContext*> pendingRenderContexts;
     QAnimationDriver *m_animation_driver;
     QList<Window> m_windows;
+    mutable QList<SharedThread> m_sharedThreads;
+    int m_maxRenderThreads;
 
     int m_animation_timer;
 
@@ -0,0 +1,73 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgparallel_p.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+void qsg_parallelFor(int count, int chunkSize, const std::function<void(int, int)> &work)
+{
+    Q_ASSERT(chunkSize > 0);
+    if (count <= 0)
+        return;
+
+    const int chunkCount = (count + chunkSize - 1) / chunkSize;
+    const int helperCount = qMin(QThread::idealThreadCount(), chunkCount) - 1;
+    if (helperCount <= 0) {
+        work(0, count);
+        return;
+    }
+
+    struct Job {
+        std::function<void(int, int)> work;
+        int count;
+        int chunkSize;
+        QAtomicInt next;
+        QAtomicInt remaining;
+        QMutex mutex;
+        QWaitCondition done;
+    };
+
+    // Helpers that only start after all ranges are taken still access the job, so it has to
+    // outlive this function. They never call the work function in that case.
+    auto job = std::make_shared<Job>();
+    job->work = work;
+    job->count = count;
+    job->chunkSize = chunkSize;
+    job->remaining.storeRelaxed(count);
+
+    const auto run = [job]() {
+        for (;;) {
+            const int begin = job->next.fetchAndAddRelaxed(job->chunkSize);
+            if (begin >= job->count)
+                return;
+            const int end = qMin(begin + job->chunkSize, job->count);
+            job->work(begin, end);
+            if (job->remaining.fetchAndSubOrdered(end - begin) == end - begin) {
+                QMutexLocker locker(&job->mutex);
+                job->done.wakeAll();
+            }
+        }
+    };
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    for (int i = 0; i < helperCount; ++i) {
+        if (!pool->tryStart(run))
+            break;
+    }
+
+    run();
+
+    QMutexLocker locker(&job->mutex);
+    while (job->remaining.loadAcquire() > 0)
+        job->done.wait(&job->mutex);
+}
+
+QT_END_NAMESPACE
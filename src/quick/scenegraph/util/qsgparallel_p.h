@@ -0,0 +1,32 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGPARALLEL_P_H
+#define QSGPARALLEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+// Calls work(begin, end) for consecutive ranges of at most chunkSize items, covering [0, count).
+// Ranges are handed out to idle threads of the global thread pool and to the calling thread,
+// which does not return before all of them are done. Work is never queued behind other tasks
+// in the pool, so a busy pool degrades to running everything on the calling thread.
+void qsg_parallelFor(int count, int chunkSize, const std::function<void(int, int)> &work);
+
+QT_END_NAMESPACE
+
+#endif // QSGPARALLEL_P_H
@@ -10,6 +10,7 @@
 #include <QtGui/qpa/qplatformnativeinterface.h>
 #include <QtGui/private/qrhi_p.h>
 #include <QtQuick/private/qsgrhisupport_p.h>
+#include <QtQuick/private/qsgrenderer_p.h>
 
 #include <qtquick_tracepoints_p.h>
 
@@ -241,6 +242,7 @@ void QSGPlainTexture::commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch
         tmp = tmp.copy();
 
     resourceUpdates->uploadTexture(m_texture, tmp);
+    QSGFrameCounters::countTextureUpload();
 
     if (hasMipMaps) {
         resourceUpdates->generateMips(m_texture);
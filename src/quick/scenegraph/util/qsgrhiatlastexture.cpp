@@ -12,6 +12,7 @@
 #include <private/qqmlglobal_p.h>
 #include <private/qsgdefaultrendercontext_p.h>
 #include <private/qsgtexture_p.h>
+#include <private/qsgrenderer_p.h>
 #include <private/qsgcompressedtexture_p.h>
 #include <private/qsgcompressedatlastexture_p.h>
 
@@ -23,6 +24,9 @@ static QElapsedTimer qsg_renderer_timer;
 
 DEFINE_BOOL_CONFIG_OPTION(qsgEnableCompressedAtlas, QSG_ENABLE_COMPRESSED_ATLAS)
 
+// Area, in pixels, that full atlases of any window have asked to be freed.
+static QBasicAtomicInteger<qint64> qsg_atlas_eviction_request = Q_BASIC_ATOMIC_INITIALIZER(0);
+
 namespace QSGRhiAtlasTexture
 {
 
@@ -51,22 +55,29 @@ Manager::Manager(QSGDefaultRenderContext *rc, const QSize &surfacePixelSize, QSu
     m_atlas_size_limit = qt_sg_envInt("QSG_ATLAS_SIZE_LIMIT", qMax(w, h) / 2);
     m_atlas_size = QSize(w, h);
 
-    qCDebug(QSG_LOG_INFO, "rhi texture atlas dimensions: %dx%d", w, h);
+    // When a page is full, further pages of the same size are added up to
+    // this limit. Beyond that, images become standalone textures.
+    m_max_pages = qMax(1, qt_sg_envInt("QSG_ATLAS_MAX_PAGES", 4));
+
+    qCDebug(QSG_LOG_INFO, "rhi texture atlas dimensions: %dx%d, up to %d pages", w, h, m_max_pages);
 }
 
 Manager::~Manager()
 {
-    Q_ASSERT(m_atlas == nullptr);
+    Q_ASSERT(m_pages.isEmpty());
     Q_ASSERT(m_atlases.isEmpty());
 }
 
 void Manager::invalidate()
 {
-    if (m_atlas) {
-        m_atlas->invalidate();
-        m_atlas->deleteLater();
-        m_atlas = nullptr;
+    for (Atlas *page : std::as_const(m_pages)) {
+        // Textures still alive remove themselves from the page later on,
+        // which must no longer reach the manager.
+        page->detachFromManager();
+        page->invalidate();
+        page->deleteLater();
     }
+    m_pages.clear();
 
     QHash<unsigned int, QSGCompressedAtlasTexture::Atlas*>::iterator i = m_atlases.begin();
     while (i != m_atlases.end()) {
@@ -81,15 +92,77 @@ QSGTexture *Manager::create(const QImage &image, bool hasAlphaChannel)
 {
     Texture *t = nullptr;
     if (image.width() < m_atlas_size_limit && image.height() < m_atlas_size_limit) {
-        if (!m_atlas)
-            m_atlas = new Atlas(m_rc, m_atlas_size);
-        t = m_atlas->create(image);
+        // Earlier pages are preferred, so that later ones drain over time
+        // and can be released.
+        for (Atlas *page : std::as_const(m_pages)) {
+            t = page->create(image);
+            if (t)
+                break;
+        }
+        if (!t) {
+            if (m_pages.size() < m_max_pages) {
+                m_pages.append(new Atlas(this, m_rc, m_atlas_size));
+                t = m_pages.last()->create(image);
+                logStatistics("page added");
+            } else {
+                requestEviction(image.size());
+            }
+        }
         if (t && !hasAlphaChannel && t->hasAlphaChannel())
             t->setHasAlphaChannel(false);
     }
     return t;
 }
 
+void Manager::removedFromPage(Atlas *page)
+{
+    // There is space again, so a full atlas is worth another eviction.
+    m_eviction_requested = false;
+
+    if (page->isEmpty() && page != m_pages.first()) {
+        m_pages.removeOne(page);
+        page->detachFromManager();
+        page->invalidate();
+        page->deleteLater();
+        logStatistics("page released");
+    }
+}
+
+/*
+    All pages are full. The pixmap cache keeps the textures of unreferenced
+    pixmaps alive until it expires them, so record how much room is missing.
+    The cache picks this up from the GUI thread with takeEvictionRequest()
+    and releases unreferenced pixmaps that live in an atlas. Their textures
+    then leave the atlas through the regular cleanup of texture factories.
+ */
+void Manager::requestEviction(const QSize &size)
+{
+    qsg_atlas_eviction_request.fetchAndAddRelaxed(qint64(size.width()) * size.height());
+    if (m_eviction_requested)
+        return;
+    m_eviction_requested = true;
+    logStatistics("full, requesting eviction");
+}
+
+qint64 Manager::takeEvictionRequest()
+{
+    return qsg_atlas_eviction_request.fetchAndStoreRelaxed(0);
+}
+
+void Manager::logStatistics(const char *reason) const
+{
+    if (!QSG_LOG_INFO().isDebugEnabled())
+        return;
+
+    const qint64 pageArea = qint64(m_atlas_size.width()) * m_atlas_size.height();
+    qCDebug(QSG_LOG_INFO, "rhi texture atlas %s: %d page(s)", reason, int(m_pages.size()));
+    for (int i = 0; i < m_pages.size(); ++i) {
+        const Atlas *page = m_pages.at(i);
+        qCDebug(QSG_LOG_INFO, " - page %d: %d textures, %.1f%% used", i,
+                page->textureCount(), 100.0 * page->usedArea() / pageArea);
+    }
+}
+
 QSGTexture *Manager::create(const QSGCompressedTextureFactory *factory)
 {
     QSGTexture *t = nullptr;
@@ -157,8 +230,9 @@ void AtlasBase::remove(TextureBase *t)
     m_pending_uploads.removeOne(t);
 }
 
-Atlas::Atlas(QSGDefaultRenderContext *rc, const QSize &size)
+Atlas::Atlas(Manager *manager, QSGDefaultRenderContext *rc, const QSize &size)
     : AtlasBase(rc, size)
+    , m_manager(manager)
 {
     // use RGBA texture internally as that is the only one guaranteed to be always supported
     m_format = QRhiTexture::RGBA8;
@@ -182,11 +256,23 @@ Texture *Atlas::create(const QImage &image)
     if (rect.width() > 0 && rect.height() > 0) {
         Texture *t = new Texture(this, rect, image);
         m_pending_uploads << t;
+        ++m_texture_count;
+        m_used_area += qint64(rect.width()) * rect.height();
         return t;
     }
     return nullptr;
 }
 
+void Atlas::remove(TextureBase *t)
+{
+    const QRect atlasRect = t->atlasSubRect();
+    AtlasBase::remove(t);
+    --m_texture_count;
+    m_used_area -= qint64(atlasRect.width()) * atlasRect.height();
+    if (m_manager)
+        m_manager->removedFromPage(this);
+}
+
 bool Atlas::generateTexture()
 {
     m_texture = m_rhi->newTexture(m_format, m_size, 1, QRhiTexture::UsedAsTransferSource);
@@ -295,6 +381,7 @@ void Atlas::enqueueTextureUpload(TextureBase *t, QRhiResourceUpdateBatch *resour
     QRhiTextureUploadDescription desc;
     desc.setEntries(entries.cbegin(), entries.cend());
     resourceUpdates->uploadTexture(m_texture, desc);
+    QSGFrameCounters::countTextureUpload();
 
     const QSize textureSize = t->textureSize();
     if (textureSize.width() > m_atlas_transient_image_threshold || textureSize.height() > m_atlas_transient_image_threshold)
@@ -49,10 +49,23 @@ public:
     QSGTexture *create(const QSGCompressedTextureFactory *factory);
     void invalidate();
 
+    void removedFromPage(Atlas *page);
+
+    QSize atlasSize() const { return m_atlas_size; }
+    int pageCount() const { return m_pages.size(); }
+
+    static qint64 takeEvictionRequest();
+
 private:
+    void requestEviction(const QSize &size);
+    void logStatistics(const char *reason) const;
+
     QSGDefaultRenderContext *m_rc;
     QRhi *m_rhi;
-    Atlas *m_atlas = nullptr;
+    // The first page is kept, additional ones are released once empty
+    QVector<Atlas *> m_pages;
+    int m_max_pages;
+    bool m_eviction_requested = false;
     // set of atlases for different compressed formats
     QHash<unsigned int, QSGCompressedAtlasTexture::Atlas*> m_atlases;
 
@@ -69,7 +82,7 @@ public:
 
     void invalidate();
     void commitTextureOperations(QRhiResourceUpdateBatch *resourceUpdates);
-    void remove(TextureBase *t);
+    virtual void remove(TextureBase *t);
 
     QSGDefaultRenderContext *renderContext() const { return m_rc; }
     QRhi *rhi() const { return m_rhi; }
@@ -97,18 +110,27 @@ private:
 class Atlas : public AtlasBase
 {
 public:
-    Atlas(QSGDefaultRenderContext *rc, const QSize &size);
+    Atlas(Manager *manager, QSGDefaultRenderContext *rc, const QSize &size);
     ~Atlas();
 
     bool generateTexture() override;
     void enqueueTextureUpload(TextureBase *t, QRhiResourceUpdateBatch *resourceUpdates) override;
+    void remove(TextureBase *t) override;
 
     Texture *create(const QImage &image);
 
     QRhiTexture::Format format() const { return m_format; }
 
+    bool isEmpty() const { return m_texture_count == 0; }
+    int textureCount() const { return m_texture_count; }
+    qint64 usedArea() const { return m_used_area; }
+    void detachFromManager() { m_manager = nullptr; }
+
 private:
+    Manager *m_manager;
     QRhiTexture::Format m_format;
+    int m_texture_count = 0;
+    qint64 m_used_area = 0;
     int m_atlas_transient_image_threshold = 0;
 
     uint m_debug_overlay : 1;
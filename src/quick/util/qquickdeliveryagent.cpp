@@ -1030,8 +1030,8 @@ bool QQuickDeliveryAgentPrivate::deliverHoverEventRecursive(
         Qt::KeyboardModifiers modifiers, ulong timestamp)
 {
 
-    const QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
-    const QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    const QList<QQuickItem *> children = itemPrivate->childItemsAt(scenePos);
 
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QQuickItem *child = children.at(ii);
@@ -1808,7 +1808,7 @@ QVector<QQuickItem *> QQuickDeliveryAgentPrivate::pointerTargets(QQuickItem *ite
             relevant = false;
     }
 
-    QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
+    QList<QQuickItem *> children = itemPrivate->childItemsAt(point.scenePosition());
     if (relevant) {
         auto it = std::lower_bound(children.begin(), children.end(), 0,
            [](auto lhs, auto rhs) -> bool { return lhs->z() < rhs; });
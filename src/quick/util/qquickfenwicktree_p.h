@@ -0,0 +1,120 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKFENWICKTREE_P_H
+#define QQUICKFENWICKTREE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qlist.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    A list of non-negative values, such as the sizes of a sequence of items, that finds
+    the sum of any prefix and the index at which the running sum passes a given value in
+    logarithmic time, while still allowing single values to be changed in logarithmic time.
+
+    This is what lays out long sequences of items whose sizes are only known, or change,
+    one at a time: the position of item i is sum(i), and the item at position p is
+    indexOf(p).
+*/
+template <typename T>
+class QQuickFenwickTree
+{
+public:
+    qsizetype size() const { return m_values.size(); }
+    bool isEmpty() const { return m_values.isEmpty(); }
+
+    void clear()
+    {
+        m_values.clear();
+        m_tree.clear();
+    }
+
+    // Replaces the contents with values, in linear time.
+    void assign(const QList<T> &values)
+    {
+        m_values = values;
+        m_tree = values;
+        const qsizetype count = m_tree.size();
+        for (qsizetype i = 0; i < count; ++i) {
+            const qsizetype parent = i | (i + 1);
+            if (parent < count)
+                m_tree[parent] += m_tree.at(i);
+        }
+    }
+
+    T value(qsizetype index) const { return m_values.at(index); }
+    const QList<T> &values() const { return m_values; }
+
+    void setValue(qsizetype index, T value)
+    {
+        const T delta = value - m_values.at(index);
+        if (delta == T())
+            return;
+        m_values[index] = value;
+        for (qsizetype i = index; i < m_tree.size(); i |= i + 1)
+            m_tree[i] += delta;
+    }
+
+    // The sum of the first count values.
+    T sum(qsizetype count) const
+    {
+        T result = T();
+        for (qsizetype i = qMin(count, m_tree.size()) - 1; i >= 0; i = (i & (i + 1)) - 1)
+            result += m_tree.at(i);
+        return result;
+    }
+
+    T total() const { return sum(m_tree.size()); }
+
+    // The index of the value that covers position, that is the largest index for which
+    // sum(index) <= position. Positions past the end give size().
+    qsizetype indexOf(T position) const
+    {
+        return indexOf(position, [](const T &sum, qsizetype) { return sum; });
+    }
+
+    // Like indexOf(), for sequences in which the position of an index is not just the sum
+    // of the values before it, but extent(sum, count) of that sum and the number of values
+    // in it. extent has to be additive, and must not decrease as either of them grows.
+    template <typename Position, typename Extent>
+    qsizetype indexOf(Position position, Extent extent) const
+    {
+        qsizetype index = 0;
+        qsizetype step = 1;
+        while (step * 2 <= m_tree.size())
+            step *= 2;
+        for (; step > 0; step /= 2) {
+            const qsizetype next = index + step;
+            if (next > m_tree.size())
+                continue;
+            // The node at next - 1 holds the sum of the step values before next.
+            const Position nodeExtent = extent(m_tree.at(next - 1), step);
+            if (!(position < nodeExtent)) {
+                position -= nodeExtent;
+                index = next;
+            }
+        }
+        return index;
+    }
+
+private:
+    QList<T> m_values;
+    QList<T> m_tree;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKFENWICKTREE_P_H
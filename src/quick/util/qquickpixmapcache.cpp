@@ -2,9 +2,11 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include <QtQuick/private/qquickpixmapcache_p.h>
+#include <QtQuick/private/qquickpixmapdiskcache_p.h>
 #include <QtQuick/private/qquickimageprovider_p.h>
 #include <QtQuick/private/qquickprofiler_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgrhiatlastexture_p.h>
 #include <QtQuick/private/qsgtexturereader_p.h>
 #include <QtQuick/qquickwindow.h>
 
@@ -23,10 +25,12 @@
 #include <QtCore/qhash.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qbuffer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qmetaobject.h>
+#include <QtCore/qset.h>
 
 #if QT_CONFIG(qml_network)
 #include <QtQml/qqmlnetworkaccessmanagerfactory.h>
@@ -51,9 +55,6 @@ Q_LOGGING_CATEGORY(lcImg, "qt.quick.image")
 static const bool qsg_leak_check = !qEnvironmentVariableIsEmpty("QML_LEAK_CHECK");
 #endif
 
-// The cache limit describes the maximum "junk" in the cache.
-static int cache_limit = 2048 * 1024; // 2048 KB cache limit for embedded in qpixmapcache.cpp
-
 static inline QString imageProviderId(const QUrl &url)
 {
     return url.host();
@@ -79,6 +80,8 @@ QQuickDefaultTextureFactory::QQuickDefaultTextureFactory(const QImage &image)
 QSGTexture *QQuickDefaultTextureFactory::createTexture(QQuickWindow *window) const
 {
     QSGTexture *t = window->createTextureFromImage(im, QQuickWindow::TextureCanUseAtlas);
+    if (t && t->isAtlasTexture())
+        atlasBacked.storeRelaxed(1);
     static bool transient = qEnvironmentVariableIsSet("QSG_TRANSIENT_IMAGES");
     if (transient)
         const_cast<QQuickDefaultTextureFactory *>(this)->im = QImage();
@@ -105,6 +108,7 @@ public:
     bool loading;
     QQuickImageProviderOptions providerOptions;
     int redirectCount;
+    int priority; // QQuickPixmap::LoadPriority, access inside the reader's mutex
 
     class Event : public QEvent {
     public:
@@ -159,6 +163,7 @@ public:
 
     QQuickPixmapReply *getImage(QQuickPixmapData *);
     void cancel(QQuickPixmapReply *rep);
+    void setPriority(QQuickPixmapReply *rep, int priority);
 
     static QQuickPixmapReader *instance(QQmlEngine *engine);
     static QQuickPixmapReader *existingInstance(QQmlEngine *engine);
@@ -169,7 +174,9 @@ protected:
 private:
     friend class QQuickPixmapReaderThreadObject;
     void processJobs();
+    bool canStartJob(QQuickPixmapReply *) const;
     void processJob(QQuickPixmapReply *, const QUrl &, const QString &, QQuickImageProvider::ImageType, const QSharedPointer<QQuickImageProvider> &);
+    void decodeJob(QQuickPixmapReply *, const QUrl &, const QString &);
 #if QT_CONFIG(qml_network)
     void networkRequestDone(QNetworkReply *);
 #endif
@@ -177,6 +184,9 @@ private:
 
     QList<QQuickPixmapReply*> jobs;
     QList<QQuickPixmapReply*> cancelled;
+    QSet<QQuickPixmapReply*> decoding; // local files currently read in decoderPool
+    QThreadPool decoderPool;
+    int decoderThreadCount; // 0 means local files are read on the reader thread itself
     QQmlEngine *engine;
     QObject *eventLoopQuitHack;
 
@@ -244,6 +254,7 @@ public:
 #endif
     {
         declarativePixmaps.insert(pixmap);
+        addReferencedCost();
     }
 
     QQuickPixmapData(QQuickPixmap *pixmap, QQuickTextureFactory *texture)
@@ -258,6 +269,7 @@ public:
         if (texture)
             requestSize = implicitSize = texture->textureSize();
         declarativePixmaps.insert(pixmap);
+        addReferencedCost();
     }
 
     ~QQuickPixmapData()
@@ -271,6 +283,7 @@ public:
     }
 
     int cost() const;
+    void addReferencedCost();
     void addref();
     void release(QQuickPixmapStore *store = nullptr);
     void addToCache();
@@ -302,6 +315,9 @@ public:
     QQuickPixmapData**prevUnreferencedPtr;
     QQuickPixmapData *nextUnreferenced;
 
+    // the cost the store currently counts for this pixmap, as referenced or unreferenced
+    int accountedCost = 0;
+
 #ifdef Q_OS_WEBOS
     bool storeToCache;
 #endif
@@ -388,17 +404,38 @@ static bool readImage(const QUrl& url, QIODevice *dev, QImage *image, QString *e
                       QQuickImageProviderOptions::AutoTransform *appliedTransform = nullptr, int frame = 0,
                       qreal devicePixelRatio = 1.0)
 {
+    QQuickPixmapDiskCache *diskCache = QQuickPixmapDiskCache::instance();
+    QByteArray diskCacheKey;
+    if (diskCache) {
+        diskCacheKey = diskCache->key(dev, requestRegion, requestSize, providerOptions, frame, devicePixelRatio);
+        QQuickPixmapDiskCache::Entry entry;
+        if (!diskCacheKey.isEmpty() && diskCache->load(diskCacheKey, &entry)) {
+            *image = entry.image;
+            if (impsize)
+                *impsize = entry.implicitSize;
+            if (frameCount)
+                *frameCount = entry.frameCount;
+            if (appliedTransform && providerOptions.autoTransform() == QQuickImageProviderOptions::UsePluginDefaultTransform)
+                *appliedTransform = entry.appliedTransform;
+            return true;
+        }
+    }
+
     QImageReader imgio(dev);
+    QQuickImageProviderOptions::AutoTransform transform = QQuickImageProviderOptions::UsePluginDefaultTransform;
     if (providerOptions.autoTransform() != QQuickImageProviderOptions::UsePluginDefaultTransform)
         imgio.setAutoTransform(providerOptions.autoTransform() == QQuickImageProviderOptions::ApplyTransform);
-    else if (appliedTransform)
-        *appliedTransform = imgio.autoTransform() ? QQuickImageProviderOptions::ApplyTransform : QQuickImageProviderOptions::DoNotApplyTransform;
+    else
+        transform = imgio.autoTransform() ? QQuickImageProviderOptions::ApplyTransform : QQuickImageProviderOptions::DoNotApplyTransform;
+    if (appliedTransform && transform != QQuickImageProviderOptions::UsePluginDefaultTransform)
+        *appliedTransform = transform;
 
     if (frame < imgio.imageCount())
         imgio.jumpToImage(frame);
 
+    const int imageCount = imgio.imageCount();
     if (frameCount)
-        *frameCount = imgio.imageCount();
+        *frameCount = imageCount;
 
     QSize scSize = QQuickImageProviderWithOptions::loadSize(imgio.size(), requestSize, imgio.format(), providerOptions, devicePixelRatio);
     if (scSize.isValid())
@@ -422,6 +459,14 @@ static bool readImage(const QUrl& url, QIODevice *dev, QImage *image, QString *e
             else
                 image->setColorSpace(providerOptions.targetColorSpace());
         }
+        if (!diskCacheKey.isEmpty()) {
+            QQuickPixmapDiskCache::Entry entry;
+            entry.image = *image;
+            entry.implicitSize = originalSize.width() < 0 ? image->size() : originalSize;
+            entry.frameCount = imageCount;
+            entry.appliedTransform = transform;
+            diskCache->store(diskCacheKey, entry);
+        }
         return true;
     } else {
         if (errorString)
@@ -475,12 +520,29 @@ static QString existingImageFileForPath(const QString &localFile)
     return localFile;
 }
 
+static int imageDecoderThreadCount()
+{
+#if QT_CONFIG(thread)
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("QML_IMAGE_DECODER_THREADS", &ok);
+    if (ok && count >= 0)
+        return count;
+    return qBound(1, QThread::idealThreadCount() / 2, 8);
+#else
+    return 0;
+#endif
+}
+
 QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
-: QThread(eng), engine(eng), threadObject(nullptr)
+: QThread(eng), decoderThreadCount(imageDecoderThreadCount()), engine(eng), threadObject(nullptr)
 #if QT_CONFIG(qml_network)
 , accessManager(nullptr)
 #endif
 {
+    if (decoderThreadCount > 0) {
+        decoderPool.setMaxThreadCount(decoderThreadCount);
+        decoderPool.setThreadPriority(QThread::LowestPriority);
+    }
     eventLoopQuitHack = new QObject;
     eventLoopQuitHack->moveToThread(this);
     connect(eventLoopQuitHack, SIGNAL(destroyed(QObject*)), SLOT(quit()), Qt::DirectConnection);
@@ -520,11 +582,26 @@ QQuickPixmapReader::~QQuickPixmapReader()
     for (auto *reply : qAsConst(asyncResponses))
         cancelJob(reply);
 #endif
+    // Decoders that are still running drop their results.
+    for (QQuickPixmapReply *reply : qAsConst(decoding)) {
+        if (!cancelled.contains(reply)) {
+            if (reply->data && reply->data->reply == reply)
+                reply->data->reply = nullptr;
+            cancelled.append(reply);
+        }
+    }
     if (threadObject) threadObject->processJobs();
     mutex.unlock();
 
+    // Decoders still running poke threadObject when done.
+    decoderPool.waitForDone();
+
     eventLoopQuitHack->deleteLater();
     wait();
+
+    // The thread may have quit before it got around to the cancelled jobs.
+    qDeleteAll(cancelled);
+    cancelled.clear();
 }
 
 #if QT_CONFIG(qml_network)
@@ -650,18 +727,34 @@ void QQuickPixmapReaderThreadObject::asyncResponseFinished()
     asyncResponseFinished(response);
 }
 
+bool QQuickPixmapReader::canStartJob(QQuickPixmapReply *job) const
+{
+    if (job->url.scheme() == QLatin1String("image"))
+        return true;
+    if (QQmlFile::isLocalFile(job->url))
+        return decoderThreadCount == 0 || decoding.size() < decoderThreadCount;
+#if QT_CONFIG(qml_network)
+    return networkJobs.count() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT;
+#else
+    return false;
+#endif
+}
+
 void QQuickPixmapReader::processJobs()
 {
     QMutexLocker locker(&mutex);
 
     while (true) {
-        if (cancelled.isEmpty() && jobs.isEmpty())
-            return; // Nothing else to do
-
         // Clean cancelled jobs
         if (!cancelled.isEmpty()) {
+            QList<QQuickPixmapReply*> stillDecoding;
             for (int i = 0; i < cancelled.count(); ++i) {
                 QQuickPixmapReply *job = cancelled.at(i);
+                if (decoding.contains(job)) {
+                    // the decoder still refers to it, clean it up once it returns
+                    stillDecoding.append(job);
+                    continue;
+                }
 #if QT_CONFIG(qml_network)
                 QNetworkReply *reply = networkJobs.key(job, 0);
                 if (reply) {
@@ -682,53 +775,129 @@ void QQuickPixmapReader::processJobs()
                 // deleteLater, since not owned by this thread
                 job->deleteLater();
             }
-            cancelled.clear();
+            cancelled = stillDecoding;
         }
 
-        if (!jobs.isEmpty()) {
-            // Find a job we can use
-            bool usableJob = false;
-            for (int i = jobs.count() - 1; !usableJob && i >= 0; i--) {
-                QQuickPixmapReply *job = jobs.at(i);
-                const QUrl url = job->url;
-                QString localFile;
-                QQuickImageProvider::ImageType imageType = QQuickImageProvider::Invalid;
-                QSharedPointer<QQuickImageProvider> provider;
-
-                if (url.scheme() == QLatin1String("image")) {
-                    QQmlEnginePrivate *enginePrivate = QQmlEnginePrivate::get(engine);
-                    provider = enginePrivate->imageProvider(imageProviderId(url)).staticCast<QQuickImageProvider>();
-                    if (provider)
-                        imageType = provider->imageType();
-
-                    usableJob = true;
-                } else {
-                    localFile = QQmlFile::urlToLocalFileOrQrc(url);
-                    usableJob = !localFile.isEmpty()
-#if QT_CONFIG(qml_network)
-                            || networkJobs.count() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT
-#endif
-                            ;
-                }
+        if (jobs.isEmpty())
+            return; // Nothing else to do
+
+        // Find the most urgent job we can start. Among jobs of equal priority, the one
+        // requested last wins.
+        int jobIndex = -1;
+        for (int i = jobs.count() - 1; i >= 0; i--) {
+            QQuickPixmapReply *job = jobs.at(i);
+            if (jobIndex != -1 && job->priority <= jobs.at(jobIndex)->priority)
+                continue;
+            if (canStartJob(job))
+                jobIndex = i;
+        }
+
+        if (jobIndex == -1)
+            return;
+
+        QQuickPixmapReply *job = jobs.takeAt(jobIndex);
+        const QUrl url = job->url;
+        QString localFile;
+        QQuickImageProvider::ImageType imageType = QQuickImageProvider::Invalid;
+        QSharedPointer<QQuickImageProvider> provider;
+
+        if (url.scheme() == QLatin1String("image")) {
+            QQmlEnginePrivate *enginePrivate = QQmlEnginePrivate::get(engine);
+            provider = enginePrivate->imageProvider(imageProviderId(url)).staticCast<QQuickImageProvider>();
+            if (provider)
+                imageType = provider->imageType();
+        } else {
+            localFile = QQmlFile::urlToLocalFileOrQrc(url);
+        }
 
+        job->loading = true;
 
-                if (usableJob) {
-                    jobs.removeAt(i);
+        PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingStarted>(url));
 
-                    job->loading = true;
+        if (!localFile.isEmpty() && decoderThreadCount > 0) {
+            decoding.insert(job);
+            decoderPool.start([this, job, url, localFile]() {
+                decodeJob(job, url, localFile);
+            }, job->priority);
+        } else {
+            locker.unlock();
+            processJob(job, url, localFile, imageType, provider);
+            locker.relock();
+        }
+    }
+}
 
-                    PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingStarted>(url));
+static QQuickTextureFactory *readLocalImage(QQuickPixmapReply *runningJob, const QUrl &url,
+                                            const QString &localFile,
+                                            QQuickPixmapReply::ReadError *errorCode,
+                                            QString *errorStr, QSize *readSize)
+{
+    QImage image;
 
-                    locker.unlock();
-                    processJob(job, url, localFile, imageType, provider);
-                    locker.relock();
+    if (runningJob->data && runningJob->data->specialDevice) {
+        int frameCount;
+        int const frame = runningJob->data ? runningJob->data->frame : 0;
+        if (!readImage(url, runningJob->data->specialDevice, &image, errorStr, readSize, &frameCount,
+                       runningJob->requestRegion, runningJob->requestSize,
+                       runningJob->providerOptions, nullptr, frame)) {
+            *errorCode = QQuickPixmapReply::Loading;
+        } else if (runningJob->data) {
+            runningJob->data->frameCount = frameCount;
+        }
+    } else {
+        QFile f(existingImageFileForPath(localFile));
+        if (f.open(QIODevice::ReadOnly)) {
+            QSGTextureReader texReader(&f, localFile);
+            if (backendSupport()->hasOpenGL && texReader.isTexture()) {
+                QQuickTextureFactory *factory = texReader.read();
+                if (factory) {
+                    *readSize = factory->textureSize();
+                } else {
+                    *errorStr = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
+                    if (f.fileName() != localFile)
+                        *errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
+                    *errorCode = QQuickPixmapReply::Decoding;
+                }
+                return factory;
+            } else {
+                int frameCount;
+                int const frame = runningJob->data ? runningJob->data->frame : 0;
+                if (!readImage(url, &f, &image, errorStr, readSize, &frameCount,
+                               runningJob->requestRegion, runningJob->requestSize,
+                               runningJob->providerOptions, nullptr, frame)) {
+                    *errorCode = QQuickPixmapReply::Loading;
+                    if (f.fileName() != localFile)
+                        *errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
+                } else if (runningJob->data) {
+                    runningJob->data->frameCount = frameCount;
                 }
             }
-
-            if (!usableJob)
-                return;
+        } else {
+            *errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
+            *errorCode = QQuickPixmapReply::Loading;
         }
     }
+
+    return QQuickTextureFactory::textureFactoryForImage(image);
+}
+
+void QQuickPixmapReader::decodeJob(QQuickPixmapReply *runningJob, const QUrl &url, const QString &localFile)
+{
+    // Runs on a decoderPool thread. runningJob stays alive while it is in decoding.
+    QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
+    QString errorStr;
+    QSize readSize;
+    QQuickTextureFactory *factory = readLocalImage(runningJob, url, localFile,
+                                                   &errorCode, &errorStr, &readSize);
+    QMutexLocker locker(&mutex);
+    decoding.remove(runningJob);
+    if (!cancelled.contains(runningJob))
+        runningJob->postReply(errorCode, errorStr, readSize, factory);
+    else
+        delete factory;
+    // a slot opened up, and a cancelled job may be waiting for cleanup
+    if (threadObject)
+        threadObject->processJobs();
 }
 
 void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &url, const QString &localFile,
@@ -859,61 +1028,16 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     } else {
         if (!localFile.isEmpty()) {
             // Image is local - load/decode immediately
-            QImage image;
             QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
             QString errorStr;
             QSize readSize;
-
-            if (runningJob->data && runningJob->data->specialDevice) {
-                int frameCount;
-                int const frame = runningJob->data ? runningJob->data->frame : 0;
-                if (!readImage(url, runningJob->data->specialDevice, &image, &errorStr, &readSize, &frameCount,
-                               runningJob->requestRegion, runningJob->requestSize,
-                               runningJob->providerOptions, nullptr, frame)) {
-                    errorCode = QQuickPixmapReply::Loading;
-                } else if (runningJob->data) {
-                    runningJob->data->frameCount = frameCount;
-                }
-            } else {
-                QFile f(existingImageFileForPath(localFile));
-                if (f.open(QIODevice::ReadOnly)) {
-                    QSGTextureReader texReader(&f, localFile);
-                    if (backendSupport()->hasOpenGL && texReader.isTexture()) {
-                        QQuickTextureFactory *factory = texReader.read();
-                        if (factory) {
-                            readSize = factory->textureSize();
-                        } else {
-                            errorStr = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
-                            if (f.fileName() != localFile)
-                                errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
-                            errorCode = QQuickPixmapReply::Decoding;
-                        }
-                        mutex.lock();
-                        if (!cancelled.contains(runningJob))
-                            runningJob->postReply(errorCode, errorStr, readSize, factory);
-                        mutex.unlock();
-                        return;
-                    } else {
-                        int frameCount;
-                        int const frame = runningJob->data ? runningJob->data->frame : 0;
-                        if (!readImage(url, &f, &image, &errorStr, &readSize, &frameCount,
-                                       runningJob->requestRegion, runningJob->requestSize,
-                                       runningJob->providerOptions, nullptr, frame)) {
-                            errorCode = QQuickPixmapReply::Loading;
-                            if (f.fileName() != localFile)
-                                errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
-                        } else if (runningJob->data) {
-                            runningJob->data->frameCount = frameCount;
-                        }
-                    }
-                } else {
-                    errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
-                    errorCode = QQuickPixmapReply::Loading;
-                }
-            }
+            QQuickTextureFactory *factory = readLocalImage(runningJob, url, localFile,
+                                                           &errorCode, &errorStr, &readSize);
             mutex.lock();
             if (!cancelled.contains(runningJob))
-                runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(image));
+                runningJob->postReply(errorCode, errorStr, readSize, factory);
+            else
+                delete factory;
             mutex.unlock();
         } else {
 #if QT_CONFIG(qml_network)
@@ -982,6 +1106,13 @@ void QQuickPixmapReader::cancel(QQuickPixmapReply *reply)
     mutex.unlock();
 }
 
+void QQuickPixmapReader::setPriority(QQuickPixmapReply *reply, int priority)
+{
+    // Only matters while the reply is still waiting in jobs.
+    QMutexLocker locker(&mutex);
+    reply->priority = priority;
+}
+
 void QQuickPixmapReader::run()
 {
     if (replyDownloadProgress == -1) {
@@ -1042,7 +1173,14 @@ public:
     void unreferencePixmap(QQuickPixmapData *);
     void referencePixmap(QQuickPixmapData *);
 
+    void addReferenced(QQuickPixmapData *);
+    void removeReferenced(QQuickPixmapData *);
+
     void purgeCache();
+    void trimCache();
+
+    void setLimits(qint64 totalLimit, qint64 unreferencedLimit);
+    QQuickPixmap::CacheStatistics statistics() const;
 
 protected:
     void timerEvent(QTimerEvent *) override;
@@ -1050,21 +1188,38 @@ protected:
 public:
     QHash<QQuickPixmapKey, QQuickPixmapData *> m_cache;
 
+    qint64 m_totalLimit;
+    qint64 m_unreferencedLimit;
+    quint64 m_hits;
+    quint64 m_misses;
+
 private:
-    void shrinkCache(int remove);
+    void shrinkCache(qint64 remove);
+    void evictAtlasTextures();
+    void releaseUnreferenced(QQuickPixmapData *data);
+    qint64 unreferencedLimit() const;
 
     QQuickPixmapData *m_unreferencedPixmaps;
     QQuickPixmapData *m_lastUnreferencedPixmap;
 
-    int m_unreferencedCost;
+    qint64 m_referencedCost;
+    qint64 m_unreferencedCost;
+    int m_unreferencedCount;
+    quint64 m_evictions;
     int m_timerId;
     bool m_destroying;
+    bool m_overTotalLimit;
 };
 Q_GLOBAL_STATIC(QQuickPixmapStore, pixmapStore);
 
 
+// The cost of an image counts both its texture and the copy kept in memory, so the default
+// limit for unreferenced images holds as many as the 2048 KB that only counted the texture.
 QQuickPixmapStore::QQuickPixmapStore()
-    : m_unreferencedPixmaps(nullptr), m_lastUnreferencedPixmap(nullptr), m_unreferencedCost(0), m_timerId(-1), m_destroying(false)
+    : m_totalLimit(-1), m_unreferencedLimit(2 * 2048 * 1024), m_hits(0), m_misses(0),
+      m_unreferencedPixmaps(nullptr), m_lastUnreferencedPixmap(nullptr), m_referencedCost(0),
+      m_unreferencedCost(0), m_unreferencedCount(0), m_evictions(0), m_timerId(-1),
+      m_destroying(false), m_overTotalLimit(false)
 {
 }
 
@@ -1114,8 +1269,10 @@ void QQuickPixmapStore::unreferencePixmap(QQuickPixmapData *data)
 
     data->nextUnreferenced = m_unreferencedPixmaps;
     data->prevUnreferencedPtr = &m_unreferencedPixmaps;
-    if (!m_destroying) // the texture factories may have been cleaned up already.
-        m_unreferencedCost += data->cost();
+    // the texture factories may have been cleaned up already when destroying.
+    data->accountedCost = m_destroying ? 0 : data->cost();
+    m_unreferencedCost += data->accountedCost;
+    ++m_unreferencedCount;
 
     m_unreferencedPixmaps = data;
     if (m_unreferencedPixmaps->nextUnreferenced) {
@@ -1126,7 +1283,7 @@ void QQuickPixmapStore::unreferencePixmap(QQuickPixmapData *data)
     if (!m_lastUnreferencedPixmap)
         m_lastUnreferencedPixmap = data;
 
-    shrinkCache(-1); // Shrink the cache in case it has become larger than cache_limit
+    shrinkCache(-1); // Shrink the cache in case it has become larger than its limit
 
     if (m_timerId == -1 && m_unreferencedPixmaps
             && !m_destroying && !QCoreApplication::closingDown()) {
@@ -1150,32 +1307,110 @@ void QQuickPixmapStore::referencePixmap(QQuickPixmapData *data)
     data->prevUnreferencedPtr = nullptr;
     data->prevUnreferenced = nullptr;
 
-    m_unreferencedCost -= data->cost();
+    m_unreferencedCost -= data->accountedCost;
+    data->accountedCost = 0;
+    --m_unreferencedCount;
+}
+
+void QQuickPixmapStore::addReferenced(QQuickPixmapData *data)
+{
+    const int cost = data->cost();
+    m_referencedCost += cost - data->accountedCost;
+    data->accountedCost = cost;
+
+    if (m_totalLimit < 0)
+        return;
+    // Make room for the pixmap by releasing unreferenced ones. Pixmaps in use cannot
+    // be released, so when they alone exceed the limit, all that is left is to warn.
+    shrinkCache(-1);
+    if (m_referencedCost > m_totalLimit && !m_overTotalLimit) {
+        m_overTotalLimit = true;
+        qCWarning(lcImg, "Images in use take %lld bytes, more than the image cache limit of "
+                         "%lld bytes. Unused images are no longer cached.",
+                  m_referencedCost, m_totalLimit);
+    }
 }
 
-void QQuickPixmapStore::shrinkCache(int remove)
+void QQuickPixmapStore::removeReferenced(QQuickPixmapData *data)
 {
-    while ((remove > 0 || m_unreferencedCost > cache_limit) && m_lastUnreferencedPixmap) {
+    m_referencedCost -= data->accountedCost;
+    data->accountedCost = 0;
+    if (m_overTotalLimit && m_referencedCost <= m_totalLimit)
+        m_overTotalLimit = false;
+}
+
+// Unreferenced pixmaps only get the room that the referenced ones leave within the total limit.
+qint64 QQuickPixmapStore::unreferencedLimit() const
+{
+    if (m_totalLimit < 0)
+        return m_unreferencedLimit;
+    return qBound<qint64>(0, m_totalLimit - m_referencedCost, m_unreferencedLimit);
+}
+
+// Releases least recently used pixmaps first, until at least remove bytes are gone and
+// the cache fits its limit.
+void QQuickPixmapStore::shrinkCache(qint64 remove)
+{
+    const qint64 limit = unreferencedLimit();
+    while ((remove > 0 || m_unreferencedCost > limit) && m_lastUnreferencedPixmap) {
         QQuickPixmapData *data = m_lastUnreferencedPixmap;
         Q_ASSERT(data->nextUnreferenced == nullptr);
 
-        *data->prevUnreferencedPtr = nullptr;
-        m_lastUnreferencedPixmap = data->prevUnreferenced;
-        data->prevUnreferencedPtr = nullptr;
-        data->prevUnreferenced = nullptr;
+        remove -= data->accountedCost;
+        releaseUnreferenced(data);
+    }
+
+    if (!m_destroying)
+        evictAtlasTextures();
+}
 
-        if (!m_destroying) {
-            remove -= data->cost();
-            m_unreferencedCost -= data->cost();
+// Full texture atlases ask for room, which only unreferenced pixmaps with a texture in an
+// atlas can give. Release those, least recently used first, until they cover the area that
+// was asked for. Pixmaps with standalone textures stay cached.
+void QQuickPixmapStore::evictAtlasTextures()
+{
+    qint64 area = QSGRhiAtlasTexture::Manager::takeEvictionRequest();
+    QQuickPixmapData *data = m_lastUnreferencedPixmap;
+    while (area > 0 && data) {
+        QQuickPixmapData *previous = data->prevUnreferenced;
+        const auto *factory = qobject_cast<QQuickDefaultTextureFactory *>(data->textureFactory);
+        if (factory && factory->isAtlasBacked()) {
+            const QSize size = factory->textureSize();
+            area -= qint64(size.width()) * size.height();
+            releaseUnreferenced(data);
         }
-        data->removeFromCache(this);
-        delete data;
+        data = previous;
     }
 }
 
+void QQuickPixmapStore::releaseUnreferenced(QQuickPixmapData *data)
+{
+    Q_ASSERT(data->prevUnreferencedPtr);
+
+    *data->prevUnreferencedPtr = data->nextUnreferenced;
+    if (data->nextUnreferenced) {
+        data->nextUnreferenced->prevUnreferencedPtr = data->prevUnreferencedPtr;
+        data->nextUnreferenced->prevUnreferenced = data->prevUnreferenced;
+    }
+    if (m_lastUnreferencedPixmap == data)
+        m_lastUnreferencedPixmap = data->prevUnreferenced;
+
+    data->nextUnreferenced = nullptr;
+    data->prevUnreferencedPtr = nullptr;
+    data->prevUnreferenced = nullptr;
+
+    m_unreferencedCost -= data->accountedCost;
+    data->accountedCost = 0;
+    --m_unreferencedCount;
+    if (!m_destroying)
+        ++m_evictions;
+    data->removeFromCache(this);
+    delete data;
+}
+
 void QQuickPixmapStore::timerEvent(QTimerEvent *)
 {
-    int removalCost = m_unreferencedCost / CACHE_REMOVAL_FRACTION;
+    qint64 removalCost = m_unreferencedCost / CACHE_REMOVAL_FRACTION;
 
     shrinkCache(removalCost);
 
@@ -1190,14 +1425,66 @@ void QQuickPixmapStore::purgeCache()
     shrinkCache(m_unreferencedCost);
 }
 
+void QQuickPixmapStore::trimCache()
+{
+    shrinkCache(m_unreferencedCost / 2);
+}
+
+void QQuickPixmapStore::setLimits(qint64 totalLimit, qint64 unreferencedLimit)
+{
+    m_totalLimit = totalLimit;
+    m_unreferencedLimit = qMax<qint64>(0, unreferencedLimit);
+    m_overTotalLimit = false;
+    shrinkCache(-1);
+}
+
+QQuickPixmap::CacheStatistics QQuickPixmapStore::statistics() const
+{
+    QQuickPixmap::CacheStatistics statistics;
+    statistics.referencedBytes = m_referencedCost;
+    statistics.unreferencedBytes = m_unreferencedCost;
+    statistics.unreferencedCount = m_unreferencedCount;
+    statistics.cachedCount = m_cache.size();
+    statistics.hits = m_hits;
+    statistics.misses = m_misses;
+    statistics.evictions = m_evictions;
+    return statistics;
+}
+
 void QQuickPixmap::purgeCache()
 {
     pixmapStore()->purgeCache();
 }
 
+void QQuickPixmap::trimCache()
+{
+    pixmapStore()->trimCache();
+}
+
+void QQuickPixmap::setCacheLimits(qint64 totalLimit, qint64 unreferencedLimit)
+{
+    pixmapStore()->setLimits(totalLimit, unreferencedLimit);
+}
+
+qint64 QQuickPixmap::totalCacheLimit()
+{
+    return pixmapStore()->m_totalLimit;
+}
+
+qint64 QQuickPixmap::unreferencedCacheLimit()
+{
+    return pixmapStore()->m_unreferencedLimit;
+}
+
+QQuickPixmap::CacheStatistics QQuickPixmap::cacheStatistics()
+{
+    return pixmapStore()->statistics();
+}
+
 QQuickPixmapReply::QQuickPixmapReply(QQuickPixmapData *d)
   : data(d), engineForReader(nullptr), requestRegion(d->requestRegion), requestSize(d->requestSize),
-    url(d->url), loading(false), providerOptions(d->providerOptions), redirectCount(0)
+    url(d->url), loading(false), providerOptions(d->providerOptions), redirectCount(0),
+    priority(QQuickPixmap::NormalPriority)
 {
     if (finishedIndex == -1) {
         finishedIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::finished).methodIndex();
@@ -1222,6 +1509,7 @@ bool QQuickPixmapReply::event(QEvent *event)
                 data->textureFactory = de->textureFactory;
                 de->textureFactory = nullptr;
                 data->implicitSize = de->implicitSize;
+                data->addReferencedCost();
                 PIXMAP_PROFILE(pixmapLoadingFinished(data->url,
                         data->textureFactory != nullptr && data->textureFactory->textureSize().isValid() ?
                         data->textureFactory->textureSize() :
@@ -1246,18 +1534,33 @@ bool QQuickPixmapReply::event(QEvent *event)
 }
 
 int QQuickPixmapData::cost() const
+{
+    if (!textureFactory)
+        return 0;
+
+    // The texture itself, plus the copy of the image the default factory keeps in memory
+    // to recreate it.
+    int cost = textureFactory->textureByteCount();
+    if (auto *defaultFactory = qobject_cast<QQuickDefaultTextureFactory *>(textureFactory))
+        cost += defaultFactory->imageByteCount();
+    return cost;
+}
+
+void QQuickPixmapData::addReferencedCost()
 {
     if (textureFactory)
-        return textureFactory->textureByteCount();
-    return 0;
+        pixmapStore()->addReferenced(this);
 }
 
 void QQuickPixmapData::addref()
 {
     ++refCount;
     PIXMAP_PROFILE(pixmapCountChanged<QQuickProfiler::PixmapReferenceCountChanged>(url, refCount));
-    if (prevUnreferencedPtr)
-        pixmapStore()->referencePixmap(this);
+    if (prevUnreferencedPtr) {
+        QQuickPixmapStore *store = pixmapStore();
+        store->referencePixmap(this);
+        store->addReferenced(this);
+    }
 }
 
 void QQuickPixmapData::release(QQuickPixmapStore *store)
@@ -1266,6 +1569,9 @@ void QQuickPixmapData::release(QQuickPixmapStore *store)
     --refCount;
     PIXMAP_PROFILE(pixmapCountChanged<QQuickProfiler::PixmapReferenceCountChanged>(url, refCount));
     if (refCount == 0) {
+        store = store ? store : pixmapStore();
+        store->removeReferenced(this);
+
         if (reply) {
             QQuickPixmapReply *cancelReply = reply;
             reply->data = nullptr;
@@ -1277,7 +1583,6 @@ void QQuickPixmapData::release(QQuickPixmapStore *store)
             QQuickPixmapReader::readerMutex.unlock();
         }
 
-        store = store ? store : pixmapStore();
         if (pixmapStatus == QQuickPixmap::Ready
 #ifdef Q_OS_WEBOS
                 && storeToCache
@@ -1661,8 +1966,13 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QRect &reques
             qWarning() << "Ignoring sourceSize request for image url that came from grabToImage. Use the targetSize parameter of the grabToImage() function instead.";
         const QQuickPixmapKey grabberKey = { &url, &dummyRegion, &dummySize, 0, QQuickImageProviderOptions() };
         iter = store->m_cache.find(grabberKey);
-    } else if (options & QQuickPixmap::Cache)
+    } else if (options & QQuickPixmap::Cache) {
         iter = store->m_cache.find(key);
+        if (iter == store->m_cache.end())
+            ++store->m_misses;
+        else
+            ++store->m_hits;
+    }
 
     if (iter == store->m_cache.end()) {
         if (url.scheme() == QLatin1String("image")) {
@@ -1780,6 +2090,22 @@ void QQuickPixmap::clear(QObject *obj)
     }
 }
 
+/*! \internal
+    Sets how urgently a pending asynchronous load should be started relative to other
+    pending loads of the same engine. Has no effect once loading has started.
+*/
+void QQuickPixmap::setLoadPriority(LoadPriority priority)
+{
+    if (!d || !d->reply)
+        return;
+
+    QQuickPixmapReader::readerMutex.lock();
+    QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(d->reply->engineForReader);
+    if (reader)
+        reader->setPriority(d->reply, priority);
+    QQuickPixmapReader::readerMutex.unlock();
+}
+
 bool QQuickPixmap::isCached(const QUrl &url, const QRect &requestRegion, const QSize &requestSize,
                             const int frame, const QQuickImageProviderOptions &options)
 {
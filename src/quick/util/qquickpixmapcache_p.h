@@ -27,6 +27,7 @@
 QT_BEGIN_NAMESPACE
 
 class QQmlEngine;
+class QQuickWindow;
 class QQuickPixmapData;
 class QQuickTextureFactory;
 class QQuickImageProviderOptionsPrivate;
@@ -40,10 +41,14 @@ public:
     QSize textureSize() const override { return size; }
     int textureByteCount() const override { return size.width() * size.height() * 4; }
     QImage image() const override { return im; }
+    int imageByteCount() const { return int(im.sizeInBytes()); }
+    bool isAtlasBacked() const { return atlasBacked.loadRelaxed(); }
 
 private:
     QImage im;
     QSize size;
+    // Set on the render thread once a texture was placed into an atlas
+    mutable QAtomicInt atlasBacked;
 };
 
 class QQuickImageProviderPrivate
@@ -106,6 +111,12 @@ public:
     };
     Q_DECLARE_FLAGS(Options, Option)
 
+    enum LoadPriority {
+        LowPriority = -1,
+        NormalPriority = 0,
+        HighPriority = 1
+    };
+
     bool isNull() const;
     bool isReady() const;
     bool isError() const;
@@ -145,12 +156,31 @@ public:
     void clear();
     void clear(QObject *);
 
+    void setLoadPriority(LoadPriority priority);
+
     bool connectFinished(QObject *, const char *);
     bool connectFinished(QObject *, int);
     bool connectDownloadProgress(QObject *, const char *);
     bool connectDownloadProgress(QObject *, int);
 
+    // The counterpart of QQuickWindow::ImageCacheStatistics
+    struct CacheStatistics
+    {
+        qint64 referencedBytes = 0;
+        qint64 unreferencedBytes = 0;
+        int unreferencedCount = 0;
+        int cachedCount = 0;
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
     static void purgeCache();
+    static void trimCache(); // releases half of the unreferenced cost
+    static void setCacheLimits(qint64 totalLimit, qint64 unreferencedLimit);
+    static qint64 totalCacheLimit();
+    static qint64 unreferencedCacheLimit();
+    static CacheStatistics cacheStatistics();
     static bool isCached(const QUrl &url, const QRect &requestRegion, const QSize &requestSize,
                          const int frame, const QQuickImageProviderOptions &options);
 
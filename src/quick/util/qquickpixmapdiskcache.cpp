@@ -0,0 +1,217 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qquickpixmapdiskcache_p.h"
+
+#include <QtGui/qcolorspace.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(lcImageDiskCache, "qt.quick.image.diskcache")
+
+static const quint32 DiskCacheMagic = 0x51504443; // "QPDC"
+static const quint32 DiskCacheVersion = 1;
+
+namespace {
+struct EntryHeader
+{
+    quint32 magic;
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+    qint32 implicitWidth;
+    qint32 implicitHeight;
+    qint32 frameCount;
+    qint32 appliedTransform;
+    qint32 iccProfileSize; // the ICC profile follows the header, then the pixels
+};
+}
+
+Q_GLOBAL_STATIC(QQuickPixmapDiskCache, diskCache);
+
+QQuickPixmapDiskCache::QQuickPixmapDiskCache()
+{
+    m_directory = qEnvironmentVariable("QML_IMAGE_DISK_CACHE_PATH");
+    if (m_directory.isEmpty()) {
+        m_directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                + QLatin1String("/qmlimagecache");
+    }
+
+    bool ok = false;
+    const int sizeInMB = qEnvironmentVariableIntValue("QML_IMAGE_DISK_CACHE_SIZE", &ok);
+    m_maximumSize = qint64(ok && sizeInMB > 0 ? sizeInMB : 512) * 1024 * 1024;
+
+    if (!QDir().mkpath(m_directory))
+        qCWarning(lcImageDiskCache) << "Cannot create image disk cache directory" << m_directory;
+
+    // Establishes m_size, and removes what earlier runs left above the limit.
+    trim(m_maximumSize);
+}
+
+QQuickPixmapDiskCache *QQuickPixmapDiskCache::instance()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QML_IMAGE_DISK_CACHE") > 0;
+    return enabled ? diskCache() : nullptr;
+}
+
+QByteArray QQuickPixmapDiskCache::key(const QIODevice *device, const QRect &requestRegion,
+                                      const QSize &requestSize,
+                                      const QQuickImageProviderOptions &providerOptions,
+                                      int frame, qreal devicePixelRatio) const
+{
+    // Only plain files (including resources) can tell whether they changed since last time.
+    const QFile *file = qobject_cast<const QFile *>(device);
+    if (!file)
+        return QByteArray();
+
+    const QFileInfo info(file->fileName());
+    const QDateTime lastModified = info.lastModified();
+    if (!lastModified.isValid())
+        return QByteArray();
+
+    QByteArray material;
+    {
+        QDataStream stream(&material, QIODevice::WriteOnly);
+        const QColorSpace colorSpace = providerOptions.targetColorSpace();
+        stream << DiskCacheVersion << QByteArray(QT_VERSION_STR)
+               << info.absoluteFilePath() << info.size() << lastModified.toMSecsSinceEpoch()
+               << requestRegion << requestSize << frame << devicePixelRatio
+               << qint32(providerOptions.autoTransform())
+               << providerOptions.preserveAspectRatioCrop()
+               << providerOptions.preserveAspectRatioFit()
+               << colorSpace.isValid() << qint32(colorSpace.primaries())
+               << qint32(colorSpace.transferFunction()) << colorSpace.gamma()
+               << colorSpace.iccProfile();
+    }
+    return QCryptographicHash::hash(material, QCryptographicHash::Sha1).toHex();
+}
+
+QString QQuickPixmapDiskCache::fileName(const QByteArray &key) const
+{
+    return m_directory + QLatin1Char('/') + QLatin1String(key);
+}
+
+bool QQuickPixmapDiskCache::load(const QByteArray &key, Entry *entry) const
+{
+    QFile file(fileName(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    EntryHeader header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != qint64(sizeof(header))
+            || header.magic != DiskCacheMagic || header.version != DiskCacheVersion
+            || header.width <= 0 || header.height <= 0 || header.iccProfileSize < 0
+            || header.format <= QImage::Format_Invalid || header.format >= QImage::NImageFormats) {
+        return false;
+    }
+
+    const QByteArray iccProfile = file.read(header.iccProfileSize);
+    if (iccProfile.size() != header.iccProfileSize)
+        return false;
+
+    // Read straight into the buffer the texture will be uploaded from.
+    QImage image(header.width, header.height, QImage::Format(header.format));
+    if (image.isNull() || image.bytesPerLine() != header.bytesPerLine)
+        return false;
+    const qint64 pixelBytes = image.sizeInBytes();
+    if (file.read(reinterpret_cast<char *>(image.bits()), pixelBytes) != pixelBytes)
+        return false;
+
+    if (!iccProfile.isEmpty())
+        image.setColorSpace(QColorSpace::fromIccProfile(iccProfile));
+
+    // The access time is not reliably updated by file systems, so the modification
+    // time of an entry tells when it was last used instead.
+    file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+
+    entry->image = image;
+    entry->implicitSize = QSize(header.implicitWidth, header.implicitHeight);
+    entry->frameCount = header.frameCount;
+    entry->appliedTransform = QQuickImageProviderOptions::AutoTransform(header.appliedTransform);
+    qCDebug(lcImageDiskCache) << "hit" << key << image.size();
+    return true;
+}
+
+void QQuickPixmapDiskCache::store(const QByteArray &key, const Entry &entry)
+{
+    // Store what QQuickDefaultTextureFactory would convert to anyway.
+    QImage image = entry.image;
+    if (image.format() != QImage::Format_ARGB32_Premultiplied
+            && image.format() != QImage::Format_RGB32) {
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    const QByteArray iccProfile = image.colorSpace().iccProfile();
+    const EntryHeader header = {
+        DiskCacheMagic, DiskCacheVersion,
+        image.width(), image.height(), qint32(image.bytesPerLine()), qint32(image.format()),
+        entry.implicitSize.width(), entry.implicitSize.height(),
+        entry.frameCount, qint32(entry.appliedTransform), qint32(iccProfile.size())
+    };
+
+    // QSaveFile only replaces the entry once it is complete, so that concurrent readers
+    // never see a partial one.
+    QSaveFile file(fileName(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(iccProfile);
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+    if (!file.commit()) {
+        qCDebug(lcImageDiskCache) << "failed to store" << key << file.errorString();
+        return;
+    }
+
+    const qint64 written = qint64(sizeof(header)) + iccProfile.size() + image.sizeInBytes();
+    if ((m_size += written) > m_maximumSize)
+        trim(m_maximumSize * 3 / 4);
+}
+
+// Removes the least recently used entries until the cache is below targetSize.
+void QQuickPixmapDiskCache::trim(qint64 targetSize)
+{
+    QMutexLocker locker(&m_trimMutex);
+
+    QList<QFileInfo> entries;
+    qint64 size = 0;
+    QDirIterator it(m_directory, QDir::Files);
+    while (it.hasNext()) {
+        const QFileInfo info = it.nextFileInfo();
+        if (info.fileName().contains(QLatin1Char('.')))
+            continue; // an entry QSaveFile is still writing
+        size += info.size();
+        entries.append(info);
+    }
+
+    if (size > targetSize) {
+        std::sort(entries.begin(), entries.end(), [](const QFileInfo &a, const QFileInfo &b) {
+            return a.lastModified() < b.lastModified();
+        });
+        for (const QFileInfo &info : std::as_const(entries)) {
+            if (size <= targetSize)
+                break;
+            if (QFile::remove(info.absoluteFilePath()))
+                size -= info.size();
+        }
+        qCDebug(lcImageDiskCache) << "trimmed to" << size << "bytes";
+    }
+
+    m_size = size;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,76 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKPIXMAPDISKCACHE_P_H
+#define QQUICKPIXMAPDISKCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qquickpixmapcache_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+#include <QtGui/qimage.h>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Persistent cache of decoded images, so that local image files do not have to be
+    decoded and scaled again on every launch.
+
+    Entries are keyed by the file, its size and modification time, and every option that
+    affects the decoded result. The pixels are stored raw, in the format the scene graph
+    uploads, so a cache hit is a single read into the image's buffer.
+
+    Disabled unless QML_IMAGE_DISK_CACHE is set to a non-zero value.
+*/
+class Q_QUICK_PRIVATE_EXPORT QQuickPixmapDiskCache
+{
+public:
+    struct Entry
+    {
+        QImage image;
+        QSize implicitSize;
+        int frameCount = 1;
+        QQuickImageProviderOptions::AutoTransform appliedTransform =
+                QQuickImageProviderOptions::UsePluginDefaultTransform;
+    };
+
+    QQuickPixmapDiskCache();
+
+    // nullptr when the cache is disabled
+    static QQuickPixmapDiskCache *instance();
+
+    // An empty key means that the result of reading from device cannot be cached.
+    QByteArray key(const QIODevice *device, const QRect &requestRegion, const QSize &requestSize,
+                   const QQuickImageProviderOptions &providerOptions, int frame,
+                   qreal devicePixelRatio) const;
+
+    bool load(const QByteArray &key, Entry *entry) const;
+    void store(const QByteArray &key, const Entry &entry);
+
+private:
+    QString fileName(const QByteArray &key) const;
+    void trim(qint64 targetSize);
+
+    QString m_directory;
+    qint64 m_maximumSize;
+    std::atomic<qint64> m_size = 0;
+    QMutex m_trimMutex;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKPIXMAPDISKCACHE_P_H
@@ -606,6 +606,8 @@ void QQuickShapePath::resetFillGradient()
 QQuickShapePrivate::QQuickShapePrivate()
       : effectRefCount(0)
 {
+    // Until containsMode makes the paths count, which can reach outside of the bounds.
+    hitTestLimitedToBounds = true;
 }
 
 QQuickShapePrivate::~QQuickShapePrivate()
@@ -783,6 +785,9 @@ void QQuickShape::setContainsMode(QQuickShape::ContainsMode containsMode)
         return;
 
     d->containsMode = containsMode;
+    d->hitTestLimitedToBounds = containsMode == BoundingRectContains;
+    if (d->hitIndexed)
+        d->invalidateHitIndexes();
     emit containsModeChanged();
 }
 
@@ -120,6 +120,7 @@ static bool isKeyFocusReason(Qt::FocusReason reason)
 
 QQuickControlPrivate::QQuickControlPrivate()
 {
+    hitTestLimitedToBounds = true;
 #if QT_CONFIG(accessibility)
     QAccessible::installActivationObserver(this);
 #endif
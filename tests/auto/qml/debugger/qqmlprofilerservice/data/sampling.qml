@@ -0,0 +1,29 @@
+import QtQml 2.0
+
+QtObject {
+    function inner(i) {
+        return Math.sqrt(i) * Math.sin(i);
+    }
+
+    function outer() {
+        var sum = 0;
+        var start = Date.now();
+        for (var i = 0; Date.now() - start < 200; ++i)
+            sum += inner(i);
+        return sum;
+    }
+
+    function spin() {
+        var count = 0;
+        var start = Date.now();
+        while (Date.now() - start < 200)
+            ++count;
+        return count;
+    }
+
+    Component.onCompleted: {
+        outer();
+        spin();
+        console.log("done");
+    }
+}
@@ -40,6 +40,7 @@ public:
     QVector<QQmlProfilerEvent> jsHeapMessages;
     QVector<QQmlProfilerEvent> asynchronousMessages;
     QVector<QQmlProfilerEvent> pixmapMessages;
+    QVector<QQmlProfilerEvent> sampleMessages;
 
     int numLoadedEventTypes() const override;
     void addEventType(const QQmlProfilerEventType &type) override;
@@ -125,8 +126,12 @@ void QQmlProfilerTestClient::addEvent(const QQmlProfilerEvent &event)
         jsHeapMessages.append(event);
         break;
     case DebugMessage:
+    case Quick3DFrame:
         // Unhandled
         break;
+    case JavaScriptSample:
+        sampleMessages.append(event);
+        break;
     case MaximumMessage:
         switch (type.rangeType()) {
         case Painting:
@@ -204,6 +209,7 @@ private slots:
     void controlFromJS();
     void signalSourceLocation();
     void javascript();
+    void javascriptSampling();
     void flushInterval();
     void translationBinding();
     void memory();
@@ -672,6 +678,42 @@ void tst_QQmlProfilerService::javascript()
            CheckMessageType | CheckDetailType | CheckNumbers, m_rangeEnd);
 }
 
+void tst_QQmlProfilerService::javascriptSampling()
+{
+    QCOMPARE(connectTo(true, "sampling.qml"), ConnectSuccess);
+
+    while (!(m_process->output().contains(QLatin1String("done"))))
+        QVERIFY(QQmlDebugTest::waitForSignal(m_process, SIGNAL(readyReadStandardOutput())));
+    m_client->client->setRecording(false);
+    checkTraceReceived();
+    checkJsHeap();
+
+    qint64 numSamples = 0;
+    qint64 numLoopSamples = 0;
+    bool foundNestedStack = false;
+    for (const QQmlProfilerEvent &event : qAsConst(m_client->sampleMessages)) {
+        const QQmlProfilerEventType &type = m_client->types[event.typeIndex()];
+        QCOMPARE(type.message(), JavaScriptSample);
+        QVERIFY(event.number<qint64>(0) > 0);
+        numSamples += event.number<qint64>(0);
+
+        // Folded stacks list the outermost frame first.
+        const QString stack = type.data();
+        const int outer = stack.indexOf(QLatin1String("outer ("));
+        if (outer != -1 && stack.indexOf(QLatin1String(";inner ("), outer) != -1)
+            foundNestedStack = true;
+
+        // spin() loops without calling any JavaScript function.
+        if (stack.contains(QLatin1String("spin (")))
+            numLoopSamples += event.number<qint64>(0);
+    }
+
+    QVERIFY(numSamples > 0);
+    QVERIFY(foundNestedStack);
+    // Each of the intervals spent in the loop is counted, not only one per poll.
+    QVERIFY2(numLoopSamples > 10, QByteArray::number(numLoopSamples));
+}
+
 void tst_QQmlProfilerService::flushInterval()
 {
     QCOMPARE(connectTo(true, "timer.qml", true, 1), ConnectSuccess);
@@ -10,6 +10,8 @@
 #include <QStandardPaths>
 #include <QSysInfo>
 #include <QLoggingCategory>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmlscriptdata_p.h>
 #include <private/qv4compileddata_p.h>
@@ -58,6 +60,8 @@ private slots:
 
     void reproducibleCache_data();
     void reproducibleCache();
+    void batchMode();
+    void bytecodeCoverage();
 
     void parameterAdjustment();
     void inlineComponent();
@@ -89,7 +93,7 @@ public:
     }
 };
 
-static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+static bool runQmlcachegen(const QStringList &arguments, QByteArray *capturedStderr = nullptr)
 {
 #if defined(QTEST_CROSS_COMPILED)
     QTest::qFail("You cannot call qmlcachegen on the target.", __FILE__, __LINE__);
@@ -100,7 +104,7 @@ static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr
         proc.setProcessChannelMode(QProcess::ForwardedChannels);
     proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
                     + QLatin1String("/qmlcachegen"));
-    proc.setArguments(QStringList() << qmlFileName);
+    proc.setArguments(arguments);
     proc.start();
     if (!proc.waitForFinished())
         return false;
@@ -113,6 +117,11 @@ static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr
     return proc.exitCode() == 0;
 }
 
+static bool generateCache(const QString &qmlFileName, QByteArray *capturedStderr = nullptr)
+{
+    return runQmlcachegen(QStringList() << qmlFileName, capturedStderr);
+}
+
 tst_qmlcachegen::tst_qmlcachegen()
     : QQmlDataTest(QT_QMLTEST_DATADIR)
 {
@@ -739,6 +748,128 @@ void tst_qmlcachegen::reproducibleCache()
     QCOMPARE(contents1, contents2);
 }
 
+void tst_qmlcachegen::batchMode()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QDir dataDir(dataDirectory());
+    const QStringList inputs = dataDir.entryList(
+                QStringList() << "*.qml" << "*.js" << "*.mjs", QDir::Files, QDir::Name);
+    QVERIFY(!inputs.isEmpty());
+
+    QByteArray batch;
+    QStringList outputs;
+    for (const QString &input : inputs) {
+        const QString output = tempDir.filePath(input + 'c');
+        outputs.append(output);
+        batch += (dataDir.filePath(input) + '\t' + output + '\n').toUtf8();
+    }
+
+    // Add one file we can modify later on.
+    const QString modifiedInput = tempDir.filePath("Modified.qml");
+    const QString modifiedOutput = modifiedInput + 'c';
+    const auto writeModifiedInput = [&](int value) {
+        QFile f(modifiedInput);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write("import QtQml\nQtObject { property int value: " + QByteArray::number(value)
+                + " }\n");
+    };
+    writeModifiedInput(1);
+    batch += (modifiedInput + '\t' + modifiedOutput + '\n').toUtf8();
+
+    const QString batchFile = tempDir.filePath("batch.txt");
+    {
+        QFile f(batchFile);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write(batch);
+    }
+
+    const QString cacheDir = tempDir.filePath("cache");
+    const QStringList batchArguments = QStringList()
+            << "--batch" << batchFile << "-j" << "4" << "--cache-dir" << cacheDir;
+
+    QVERIFY(runQmlcachegen(batchArguments));
+    QVERIFY(QFile::exists(cacheDir + "/qmlcachegen.cache"));
+
+    // The batch output has to be the same as compiling one file at a time.
+    for (qsizetype i = 0; i < inputs.size(); ++i) {
+        QFile batchOutput(outputs[i]);
+        QVERIFY2(batchOutput.open(QIODevice::ReadOnly), qPrintable(outputs[i]));
+
+        const QString singleFile = tempDir.filePath("single-" + inputs[i] + 'c');
+        QVERIFY(runQmlcachegen(QStringList() << dataDir.filePath(inputs[i]) << "-o" << singleFile));
+        QFile singleOutput(singleFile);
+        QVERIFY(singleOutput.open(QIODevice::ReadOnly));
+        QCOMPARE(batchOutput.readAll(), singleOutput.readAll());
+    }
+
+    QHash<QString, QDateTime> modificationTimes;
+    for (const QString &output : std::as_const(outputs))
+        modificationTimes.insert(output, QFileInfo(output).lastModified());
+
+    QFile modified(modifiedOutput);
+    QVERIFY(modified.open(QIODevice::ReadOnly));
+    const QByteArray modifiedBefore = modified.readAll();
+    modified.close();
+
+    // Running again with one changed input only recompiles that one.
+    writeModifiedInput(2);
+    QVERIFY(runQmlcachegen(batchArguments));
+
+    for (const QString &output : std::as_const(outputs))
+        QCOMPARE(QFileInfo(output).lastModified(), modificationTimes[output]);
+
+    QVERIFY(modified.open(QIODevice::ReadOnly));
+    QVERIFY(modified.readAll() != modifiedBefore);
+}
+
+void tst_qmlcachegen::bytecodeCoverage()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // One binding that can be compiled to C++, and one function that never can,
+    // because a direct eval() needs the scope of the interpreter.
+    const QString inputFile = tempDir.filePath("coverage.qml");
+    {
+        QFile f(inputFile);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write("import QtQml\n"
+                "QtObject {\n"
+                "    property int a: 12\n"
+                "    property int b: a + 1\n"
+                "    function evaluated(): int { return eval(\"a + 1\"); }\n"
+                "}\n");
+    }
+
+    const QString coverageFile = tempDir.filePath("coverage.json");
+    QVERIFY(runQmlcachegen(QStringList()
+                           << inputFile << "-o" << tempDir.filePath("coverage.cpp")
+                           << "--resource-path" << "/coverage.qml"
+                           << "--bytecode-coverage" << coverageFile));
+
+    QFile f(coverageFile);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QJsonParseError parseError;
+    const QJsonObject coverage = QJsonDocument::fromJson(f.readAll(), &parseError).object();
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+
+    QCOMPARE(coverage.value(u"compiled").toInt(), 1);
+    QCOMPARE(coverage.value(u"rejected").toInt(), 1);
+    const QJsonObject byInstruction = coverage.value(u"rejectionsByInstruction").toObject();
+    QCOMPARE(byInstruction.keys(), QStringList { u"CallPossiblyDirectEval"_s });
+    QCOMPARE(byInstruction.value(u"CallPossiblyDirectEval").toInt(), 1);
+}
+
 void tst_qmlcachegen::parameterAdjustment()
 {
     QQmlEngine engine;
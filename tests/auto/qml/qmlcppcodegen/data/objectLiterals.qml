@@ -0,0 +1,9 @@
+pragma Strict
+import QtQml
+
+QtObject {
+    property int a: 12
+    property var literal: ({ foo: a, bar: "bar", baz: [1, 2] })
+    property var ordered: ({ b: 1, a: 2, c: a })
+    property var array: [a, "x"]
+}
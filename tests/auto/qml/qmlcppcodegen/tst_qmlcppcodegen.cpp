@@ -127,6 +127,7 @@ private slots:
     void stringArg();
     void conversionDecrement();
     void unstoredUndefined();
+    void objectLiterals();
 };
 
 void tst_QmlCppCodegen::simpleBinding()
@@ -2318,6 +2319,47 @@ void tst_QmlCppCodegen::unstoredUndefined()
     QCOMPARE(o->objectName(), u"NaN"_s);
 }
 
+void tst_QmlCppCodegen::objectLiterals()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, QUrl(u"qrc:/qt/qml/TestTypes/objectLiterals.qml"_s));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> o(c.create());
+    QVERIFY(!o.isNull());
+
+    const QJSValue literal = engine.toScriptValue(o->property("literal"));
+    QVERIFY(literal.isObject());
+    QCOMPARE(literal.property(u"foo"_s).toInt(), 12);
+    QCOMPARE(literal.property(u"bar"_s).toString(), u"bar"_s);
+    const QJSValue baz = literal.property(u"baz"_s);
+    QCOMPARE(baz.property(u"length"_s).toInt(), 2);
+    QCOMPARE(baz.property(1).toInt(), 2);
+
+    const QJSValue array = engine.toScriptValue(o->property("array"));
+    QCOMPARE(array.property(u"length"_s).toInt(), 2);
+    QCOMPARE(array.property(0).toInt(), 12);
+    QCOMPARE(array.property(1).toString(), u"x"_s);
+
+    // Members keep the order in which they are defined, as in the interpreter.
+    const QJSValue ordered = engine.toScriptValue(o->property("ordered"));
+    const QJSValue keys = engine.globalObject().property(u"Object"_s).property(u"keys"_s)
+            .call(QJSValueList { ordered });
+    QCOMPARE(keys.property(u"length"_s).toInt(), 3);
+    QCOMPARE(keys.property(0).toString(), u"b"_s);
+    QCOMPARE(keys.property(1).toString(), u"a"_s);
+    QCOMPARE(keys.property(2).toString(), u"c"_s);
+    const QJSValue json = engine.globalObject().property(u"JSON"_s).property(u"stringify"_s)
+            .call(QJSValueList { ordered });
+    QCOMPARE(json.toString(), u"{\"b\":1,\"a\":2,\"c\":12}"_s);
+
+    // The property holds a reference to the object, not a copy of it.
+    QQmlExpression write(qmlContext(o.data()), o.data(), u"literal.foo = 5"_s);
+    write.evaluate();
+    QVERIFY(!write.hasError());
+    QQmlExpression read(qmlContext(o.data()), o.data(), u"literal.foo"_s);
+    QCOMPARE(read.evaluate().toInt(), 5);
+}
+
 void tst_QmlCppCodegen::runInterpreted()
 {
 #ifdef Q_OS_ANDROID
@@ -19,6 +19,8 @@
 #include <private/qqmlengine_p.h>
 #include <private/qqmltypedata_p.h>
 #include <private/qqmlcomponentattached_p.h>
+#include <private/qqmlcomponent_p.h>
+#include <private/qv4executablecompilationunit_p.h>
 #include <QQmlAbstractUrlInterceptor>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 
@@ -47,6 +49,7 @@ private slots:
     void outputWarningsToStandardError();
     void objectOwnership();
     void multipleEngines();
+    void sharedUnitDataAcrossEngines();
     void qtqmlModule_data();
     void qtqmlModule();
     void urlInterceptor_data();
@@ -815,6 +818,38 @@ void tst_qqmlengine::multipleEngines()
     }
 }
 
+void tst_qqmlengine::sharedUnitDataAcrossEngines()
+{
+    // An empty URL cannot be cached on disk. So each engine compiles the document on its own.
+    const QByteArray source = "import QtQml\nQtObject { objectName: 'shared' }\n";
+
+    QQmlEngine engine1;
+    QQmlComponent component1(&engine1);
+    component1.setData(source, QUrl());
+    QVERIFY2(component1.isReady(), qPrintable(component1.errorString()));
+    QV4::ExecutableCompilationUnit *unit1
+            = QQmlComponentPrivate::get(&component1)->compilationUnit.data();
+    QVERIFY(unit1->hasSharedUnitData());
+
+    {
+        QQmlEngine engine2;
+        QQmlComponent component2(&engine2);
+        component2.setData(source, QUrl());
+        QVERIFY2(component2.isReady(), qPrintable(component2.errorString()));
+        QV4::ExecutableCompilationUnit *unit2
+                = QQmlComponentPrivate::get(&component2)->compilationUnit.data();
+
+        QVERIFY(unit1 != unit2);
+        QVERIFY(unit2->hasSharedUnitData());
+        QCOMPARE(unit1->unitData(), unit2->unitData());
+    }
+
+    // The data has to stay alive after the other engine is gone.
+    QScopedPointer<QObject> object(component1.create());
+    QVERIFY(object);
+    QCOMPARE(object->objectName(), QStringLiteral("shared"));
+}
+
 void tst_qqmlengine::qtqmlModule_data()
 {
     QTest::addColumn<QUrl>("testFile");
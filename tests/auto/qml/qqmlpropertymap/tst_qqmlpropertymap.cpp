@@ -43,6 +43,7 @@ private slots:
     void freeze();
     void cachedSignals();
     void signalIndices();
+    void coalescedNotifications();
 };
 
 class LazyPropertyMap : public QQmlPropertyMap, public QQmlParserStatus
@@ -655,6 +656,47 @@ void tst_QQmlPropertyMap::signalIndices()
     QCOMPARE(spy.count(), 1);
 }
 
+void tst_QQmlPropertyMap::coalescedNotifications()
+{
+    QQmlPropertyMap map;
+    map.insert(QLatin1String("key1"), 100);
+    map.insert(QLatin1String("key2"), 1.5);
+    map.setNotificationsCoalesced(true);
+    QVERIFY(map.notificationsCoalesced());
+
+    const QMetaObject *mo = map.metaObject();
+    QSignalSpy spy1(&map, mo->property(mo->indexOfProperty("key1")).notifySignal());
+    QSignalSpy spy2(&map, mo->property(mo->indexOfProperty("key2")).notifySignal());
+
+    for (int i = 0; i < 10; ++i)
+        map.insert(QLatin1String("key1"), 200 + i);
+    map.insert(QLatin1String("key2"), 1.5); // unchanged
+    QCOMPARE(map.value(QLatin1String("key1")), QVariant(209));
+    QCOMPARE(spy1.count(), 0);
+
+    QTRY_COMPARE(spy1.count(), 1);
+    QCOMPARE(spy2.count(), 0);
+
+    // Bulk insertion of new and existing keys is coalesced, too.
+    QVariantHash values;
+    values.insert(QLatin1String("key1"), 300);
+    values.insert(QLatin1String("key2"), 2.5);
+    values.insert(QLatin1String("key3"), true);
+    map.insert(values);
+    QCOMPARE(map.count(), 3);
+    QCOMPARE(spy1.count(), 1);
+    QTRY_COMPARE(spy1.count(), 2);
+    QCOMPARE(spy2.count(), 1);
+
+    // Switching coalescing off delivers pending notifications right away.
+    map.insert(QLatin1String("key2"), 3.5);
+    QCOMPARE(spy2.count(), 1);
+    map.setNotificationsCoalesced(false);
+    QCOMPARE(spy2.count(), 2);
+    map.insert(QLatin1String("key2"), 4.5);
+    QCOMPARE(spy2.count(), 3);
+}
+
 QTEST_MAIN(tst_QQmlPropertyMap)
 
 #include "tst_qqmlpropertymap.moc"
@@ -40,7 +40,11 @@ struct ViewportTransformHelper : public QQuickDeliveryAgent::Transform
 
 struct HoverItem : public QQuickItem
 {
-    HoverItem(QQuickItem *parent) : QQuickItem(parent){}
+    HoverItem(QQuickItem *parent) : QQuickItem(parent)
+    {
+        // Lets a QQuickItemHitIndex leave it out, contains() is not overridden
+        QQuickItemPrivate::get(this)->hitTestLimitedToBounds = true;
+    }
     void hoverEnterEvent(QHoverEvent *e) override
     {
         hoverEnter = true;
@@ -135,6 +139,8 @@ private slots:
     void hoverPropagation_nested_data();
     void hoverPropagation_nested();
     void hoverPropagation_siblings();
+    void manyChildrenHitTesting();
+    void manyChildrenOutsideBounds();
 
 private:
     QScopedPointer<QPointingDevice> touchDevice = QScopedPointer<QPointingDevice>(QTest::createTouchDevice());
@@ -473,6 +479,126 @@ void tst_qquickdeliveryagent::hoverPropagation_siblings()
     QCOMPARE(sibling2.hoverEnter, true);
 }
 
+void tst_qquickdeliveryagent::manyChildrenHitTesting()
+{
+    QQuickWindow window;
+    window.resize(400, 400);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowActive(&window));
+
+    // Enough children to be looked up through a QQuickItemHitIndex, with gaps between them
+    QQuickItem parent(window.contentItem());
+    parent.setSize(QSizeF(400, 400));
+    QList<HoverItem *> children;
+    for (int i = 0; i < 400; ++i) {
+        HoverItem *child = new HoverItem(&parent);
+        child->setAcceptHoverEvents(true);
+        child->setPosition(QPointF(i % 20 * 20, i / 20 * 20));
+        child->setSize(QSizeF(10, 10));
+        children << child;
+    }
+    const auto hoveredCount = [&children]() {
+        return std::count_if(children.cbegin(), children.cend(),
+                             [](const HoverItem *child) { return child->hoverEnter; });
+    };
+
+    // A grandchild that sticks out of its parent, into the gap next to it
+    HoverItem grandChild(children.first());
+    grandChild.setAcceptHoverEvents(true);
+    grandChild.setPosition(QPointF(12, 0));
+    grandChild.setSize(QSizeF(6, 10));
+
+    QTest::mouseMove(&window, QPoint(105, 105));
+    QVERIFY(children.at(5 * 20 + 5)->hoverEnter);
+    QCOMPARE(hoveredCount(), 1);
+
+    QTest::mouseMove(&window, QPoint(15, 5));
+    QVERIFY(grandChild.hoverEnter);
+    QVERIFY(children.at(5 * 20 + 5)->hoverLeave);
+
+    // A child that moves on top of another one gets the next event
+    HoverItem *topChild = children.last();
+    topChild->setPosition(QPointF(102, 102));
+    QTest::mouseMove(&window, QPoint(105, 105));
+    QVERIFY(topChild->hoverEnter);
+
+    // So does a grandchild that grows out of its parent
+    grandChild.hoverEnter = false;
+    grandChild.setWidth(100);
+    QTest::mouseMove(&window, QPoint(95, 5));
+    QVERIFY(grandChild.hoverEnter);
+}
+
+// Accepts points in a margin around its bounds as well
+struct MarginItem : public HoverItem
+{
+    MarginItem(QQuickItem *parent) : HoverItem(parent)
+    {
+        // contains() accepts more points than the bounds
+        QQuickItemPrivate::get(this)->hitTestLimitedToBounds = false;
+        setAcceptedMouseButtons(Qt::LeftButton);
+    }
+
+    bool contains(const QPointF &point) const override
+    {
+        return boundingRect().adjusted(-8, -8, 8, 8).contains(point);
+    }
+
+    void mousePressEvent(QMouseEvent *event) override
+    {
+        pressed = true;
+        event->accept();
+    }
+
+    bool pressed = false;
+};
+
+void tst_qquickdeliveryagent::manyChildrenOutsideBounds()
+{
+    QQuickWindow window;
+    window.resize(400, 400);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowActive(&window));
+
+    // Enough children to be looked up through a QQuickItemHitIndex, with gaps between them
+    QQuickItem parent(window.contentItem());
+    parent.setSize(QSizeF(400, 400));
+    QList<HoverItem *> children;
+    for (int i = 0; i < 200; ++i) {
+        HoverItem *child = (i == 5 * 20 + 5) ? new MarginItem(&parent) : new HoverItem(&parent);
+        child->setAcceptHoverEvents(true);
+        child->setPosition(QPointF(i % 20 * 20, i / 20 * 20));
+        child->setSize(QSizeF(10, 10));
+        children << child;
+    }
+    QVERIFY(QQuickItemPrivate::get(&parent)->childItems.size() > 128);
+
+    // A child whose contains() reaches into the gap next to it
+    MarginItem *marginChild = static_cast<MarginItem *>(children.at(5 * 20 + 5));
+    QTest::mouseMove(&window, QPoint(115, 105));
+    QVERIFY(marginChild->hoverEnter);
+    QTest::mouseClick(&window, Qt::LeftButton, Qt::NoModifier, QPoint(115, 105));
+    QVERIFY(marginChild->pressed);
+
+    // A child whose containment mask is larger than the child
+    HoverItem *maskedChild = children.at(7 * 20 + 7);
+    QQuickItem mask;
+    mask.setPosition(QPointF(-10, -10));
+    mask.setSize(QSizeF(30, 30));
+    maskedChild->setContainmentMask(&mask);
+    QTest::mouseMove(&window, QPoint(155, 145));
+    QVERIFY(maskedChild->hoverEnter);
+    QVERIFY(marginChild->hoverLeave);
+
+    // Neither is found outside of the points it accepts
+    marginChild->hoverEnter = false;
+    maskedChild->hoverLeave = false;
+    QTest::mouseMove(&window, QPoint(175, 175));
+    QVERIFY(maskedChild->hoverLeave);
+    QVERIFY(!marginChild->hoverEnter);
+    maskedChild->setContainmentMask(nullptr);
+}
+
 QTEST_MAIN(tst_qquickdeliveryagent)
 
 #include "tst_qquickdeliveryagent.moc"
@@ -195,6 +195,7 @@ private slots:
 
     void paintOrder_data();
     void paintOrder();
+    void paintOrderAfterManyChanges();
 
     void acceptedMouseButtons();
 
@@ -1927,6 +1928,47 @@ void tst_qquickitem::paintOrder()
     QCOMPARE(items, expected);
 }
 
+void tst_qquickitem::paintOrderAfterManyChanges()
+{
+    QQuickItem root;
+    QQuickItem otherParent;
+    for (int i = 0; i < 50; ++i) {
+        QQuickItem *child = new QQuickItem(&root);
+        child->setZ(i % 5);
+    }
+
+    const auto expectedPaintOrder = [&root]() {
+        QList<QQuickItem *> sorted = root.childItems();
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](QQuickItem *lhs, QQuickItem *rhs) { return lhs->z() < rhs->z(); });
+        return sorted;
+    };
+    QCOMPARE(QQuickItemPrivate::get(&root)->paintOrderChildItems(), expectedPaintOrder());
+
+    // Once sorted, the children are kept in order one change at a time,
+    // including children with the same z, which stay in the order they were added.
+    for (int i = 0; i < 200; ++i) {
+        const QList<QQuickItem *> children = root.childItems();
+        QQuickItem *child = children.at((i * 7) % children.count());
+        switch (i % 4) {
+        case 0:
+            child->setZ((i * 3) % 5);
+            break;
+        case 1:
+            new QQuickItem(&root);
+            break;
+        case 2:
+            child->setParentItem(&otherParent);
+            break;
+        case 3:
+            otherParent.childItems().first()->setParentItem(&root);
+            root.childItems().last()->setZ(-1);
+            break;
+        }
+        QCOMPARE(QQuickItemPrivate::get(&root)->paintOrderChildItems(), expectedPaintOrder());
+    }
+}
+
 void tst_qquickitem::acceptedMouseButtons()
 {
     TestItem item;
@@ -0,0 +1,15 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+import QtQuick
+
+ListView {
+    width: 240
+    height: 640
+
+    delegate: Text {
+        height: 20
+        required property string display
+        text: display
+    }
+}
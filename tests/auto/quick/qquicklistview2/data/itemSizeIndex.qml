@@ -0,0 +1,30 @@
+import QtQuick
+
+ListView {
+    width: 240; height: 320
+
+    function itemHeight(index) {
+        return 20 + (index % 7) * 10
+    }
+
+    function insertItem(index, height) {
+        listModel.insert(index, { itemHeight: height })
+    }
+
+    model: ListModel {
+        id: listModel
+    }
+    delegate: Rectangle {
+        objectName: "delegate"
+        required property int index
+        required property real itemHeight
+        width: ListView.view.width
+        height: itemHeight
+        border.color: "black"
+    }
+
+    Component.onCompleted: {
+        for (let i = 0; i < 1000; ++i)
+            listModel.append({ itemHeight: itemHeight(i) })
+    }
+}
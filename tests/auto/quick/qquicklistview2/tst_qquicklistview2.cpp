@@ -5,6 +5,8 @@
 #include <QtQuick/qquickview.h>
 #include <QtQuick/private/qquickitemview_p_p.h>
 #include <QtQuick/private/qquicklistview_p.h>
+#include <QtQmlModels/private/qqmlchangeset_p.h>
+#include <QtQmlModels/private/qqmldelegatemodel_p.h>
 #include <QtQuickTest/QtQuickTest>
 #include <QStringListModel>
 #include <QQmlApplicationEngine>
@@ -43,6 +45,10 @@ private slots:
     void tapDelegateDuringFlicking();
     void flickDuringFlicking_data();
     void flickDuringFlicking();
+    void sizeHintRole();
+    void cacheItemSizes();
+    void coalescedModelChanges();
+    void flickWhileStreaming();
 
 private:
     void flickWithTouch(QQuickWindow *window, const QPoint &from, const QPoint &to);
@@ -537,6 +543,182 @@ void tst_QQuickListView2::delegateModelRefresh()
     QTRY_VERIFY(engine.rootObjects().first()->property("done").toBool());
 }
 
+// The position of item index in itemSizeIndex.qml
+static qreal itemSizeIndexPosition(int index)
+{
+    qreal position = 0;
+    for (int i = 0; i < index; ++i)
+        position += 20 + (i % 7) * 10;
+    return position;
+}
+
+void tst_QQuickListView2::sizeHintRole()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("itemSizeIndex.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+    QQuickListView *listView = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listView);
+    QCOMPARE(listView->count(), 1000);
+
+    // The sizes in the model make the content height exact, without creating every delegate.
+    listView->setSizeHintRole(QStringLiteral("itemHeight"));
+    QVERIFY(QQuickTest::qWaitForPolish(listView));
+    QCOMPARE(listView->contentHeight(), itemSizeIndexPosition(1000));
+
+    // ... and positioning the view at an index lands exactly.
+    listView->positionViewAtIndex(700, QQuickItemView::Beginning);
+    QQuickItem *item = findItem<QQuickItem>(listView->contentItem(), "delegate", 700);
+    QVERIFY(item);
+    QCOMPARE(item->y(), itemSizeIndexPosition(700));
+    QCOMPARE(listView->contentY(), itemSizeIndexPosition(700));
+    QCOMPARE(listView->originY(), qreal(0));
+    QCOMPARE(listView->contentHeight(), itemSizeIndexPosition(1000));
+
+    // Inserted items take their size from the model as well.
+    QVERIFY(QMetaObject::invokeMethod(listView, "insertItem", Q_ARG(QVariant, 10), Q_ARG(QVariant, 100)));
+    QTRY_COMPARE(listView->contentHeight(), itemSizeIndexPosition(1000) + 100);
+    QCOMPARE(listView->count(), 1001);
+}
+
+void tst_QQuickListView2::cacheItemSizes()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("itemSizeIndex.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+    QQuickListView *listView = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listView);
+    listView->setCacheItemSizes(true);
+    QVERIFY(QQuickTest::qWaitForPolish(listView));
+
+    // Once every item has been seen, the content height no longer depends on which are visible.
+    for (qreal y = 0; y < listView->contentHeight() - listView->height(); y += listView->height() / 2)
+        listView->setContentY(y);
+    listView->positionViewAtEnd();
+    QCOMPARE(listView->contentHeight(), itemSizeIndexPosition(1000));
+
+    listView->positionViewAtIndex(300, QQuickItemView::Beginning);
+    QQuickItem *item = findItem<QQuickItem>(listView->contentItem(), "delegate", 300);
+    QVERIFY(item);
+    QCOMPARE(item->y(), itemSizeIndexPosition(300));
+    QCOMPARE(listView->contentHeight(), itemSizeIndexPosition(1000));
+}
+
+void tst_QQuickListView2::coalescedModelChanges()
+{
+    QStringListModel model;
+    QStringList rows;
+    for (int i = 0; i < 10; ++i)
+        rows.append(QString::number(i));
+    model.setStringList(rows);
+
+    QScopedPointer<QQuickView> window(createView());
+    window->setInitialProperties({{ "model", QVariant::fromValue(&model) }});
+    window->setSource(testFileUrl("coalescedModelChanges.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+    QQuickListView *listView = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listView);
+    if (QQuickTest::qIsPolishScheduled(listView))
+        QVERIFY(QQuickTest::qWaitForPolish(listView));
+    QCOMPARE(listView->count(), 10);
+
+    QQmlDelegateModel *delegateModel = qobject_cast<QQmlDelegateModel *>(
+            QQuickItemViewPrivate::get(listView)->model);
+    QVERIFY(delegateModel);
+    int updates = 0;
+    connect(delegateModel, &QQmlInstanceModel::modelUpdated, this,
+            [&updates](const QQmlChangeSet &changeSet, bool) {
+        if (!changeSet.isEmpty())
+            ++updates;
+    });
+
+    // A burst of changes within one pass of the event loop, as from a model that
+    // streams in its rows.
+    auto insertRow = [&model](int row, const QString &text) {
+        QVERIFY(model.insertRows(row, 1));
+        QVERIFY(model.setData(model.index(row), text));
+    };
+    for (int i = 0; i < 5; ++i)
+        insertRow(10 + i, QStringLiteral("new %1").arg(i));
+    QVERIFY(model.removeRows(0, 2));
+    insertRow(0, QStringLiteral("first"));
+    QVERIFY(model.removeRows(4, 3));
+    insertRow(model.rowCount(), QStringLiteral("last"));
+
+    QVERIFY(QQuickTest::qWaitForPolish(listView));
+    QCOMPARE(updates, 1);
+    QCOMPARE(listView->count(), model.rowCount());
+    const QStringList expected = model.stringList();
+    for (int i = 0; i < expected.size(); ++i) {
+        QQuickItem *item = listView->itemAtIndex(i);
+        QVERIFY(item);
+        QCOMPARE(item->property("text").toString(), expected.at(i));
+        QCOMPARE(item->y(), qreal(i * 20));
+    }
+
+    // Nothing is left over for the next pass of the event loop.
+    QCoreApplication::processEvents();
+    QCOMPARE(updates, 1);
+}
+
+void tst_QQuickListView2::flickWhileStreaming()
+{
+    QStringListModel model;
+    QStringList rows;
+    for (int i = 0; i < 200; ++i)
+        rows.append(QString::number(i));
+    model.setStringList(rows);
+
+    QScopedPointer<QQuickView> window(createView());
+    window->setInitialProperties({{ "model", QVariant::fromValue(&model) }});
+    window->setSource(testFileUrl("coalescedModelChanges.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+    QQuickListView *listView = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listView);
+    if (QQuickTest::qIsPolishScheduled(listView))
+        QVERIFY(QQuickTest::qWaitForPolish(listView));
+
+    // Rows stream in, in front of and among the visible items, while the view
+    // moves, so that it refills while changes are held back.
+    int streamed = 0;
+    QTimer timer;
+    timer.setInterval(5);
+    connect(&timer, &QTimer::timeout, &model, [&model, &streamed, listView]() {
+        for (int row : { 0, listView->indexAt(0, listView->contentY() + 100) }) {
+            const int index = qMax(0, row);
+            model.insertRows(index, 1);
+            model.setData(model.index(index), QStringLiteral("streamed %1").arg(streamed++));
+        }
+    });
+    timer.start();
+    listView->flick(0, -4000);
+    QVERIFY(listView->isFlicking());
+    QTRY_VERIFY_WITH_TIMEOUT(!listView->isMoving(), 10000);
+    timer.stop();
+    QVERIFY(streamed > 0);
+    if (QQuickTest::qIsPolishScheduled(listView))
+        QVERIFY(QQuickTest::qWaitForPolish(listView));
+
+    // The visible items show their rows, one after the other without gaps or overlaps.
+    QCOMPARE(listView->count(), model.rowCount());
+    const QStringList expected = model.stringList();
+    const int first = listView->indexAt(0, listView->contentY());
+    const int last = listView->indexAt(0, listView->contentY() + listView->height() - 1);
+    QVERIFY(first >= 0);
+    QVERIFY(last > first);
+    for (int i = first; i <= last; ++i) {
+        QQuickItem *item = listView->itemAtIndex(i);
+        QVERIFY(item);
+        QCOMPARE(item->property("text").toString(), expected.at(i));
+        if (i > first)
+            QCOMPARE(item->y(), listView->itemAtIndex(i - 1)->y() + 20);
+    }
+}
+
 QTEST_MAIN(tst_QQuickListView2)
 
 #include "tst_qquicklistview2.moc"
@@ -5,6 +5,7 @@
 #include <QtQuick/private/qquickpixmapcache_p.h>
 #include <QtQml/qqmlengine.h>
 #include <QtQuick/qquickimageprovider.h>
+#include <QtQuick/qquickwindow.h>
 #include <QtQml/QQmlComponent>
 #include <QNetworkReply>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
@@ -32,6 +33,7 @@ private slots:
     void massive();
     void cancelcrash();
     void shrinkcache();
+    void cacheLimits();
 #if QT_CONFIG(concurrent)
     void networkCrash();
 #endif
@@ -339,6 +341,105 @@ void tst_qquickpixmapcache::shrinkcache()
     }
 }
 
+void tst_qquickpixmapcache::cacheLimits()
+{
+#ifdef Q_OS_WEBOS
+    QSKIP("QQuickPixmap always loads with QQuickPixmap::Cache option in webOS");
+#endif
+    const qint64 oldTotalLimit = QQuickWindow::totalImageCacheLimit();
+    const qint64 oldUnreferencedLimit = QQuickWindow::unreferencedImageCacheLimit();
+    auto cleanup = qScopeGuard([&] {
+        QQuickWindow::setImageCacheLimits(oldTotalLimit, oldUnreferencedLimit);
+    });
+
+    QQmlEngine engine;
+    engine.addImageProvider(QLatin1String("mypixmaps"), new MyPixmapProvider);
+    const QUrl url("image://mypixmaps/cacheLimits");
+
+    QQuickWindow::setImageCacheLimits(-1, 100 * 1024 * 1024);
+    QQuickPixmap::purgeCache();
+    const QQuickWindow::ImageCacheStatistics initial = QQuickWindow::imageCacheStatistics();
+    QCOMPARE(initial.unreferencedBytes, qint64(0));
+
+    qint64 cost = 0;
+    {
+        QQuickPixmap p(&engine, url);
+        QVERIFY(p.isReady());
+        const QQuickWindow::ImageCacheStatistics statistics = QQuickWindow::imageCacheStatistics();
+        QCOMPARE(statistics.misses, initial.misses + 1);
+        cost = statistics.referencedBytes - initial.referencedBytes;
+        QVERIFY(cost >= 800 * 600 * 4);
+    }
+
+    // no longer used, but kept
+    QQuickWindow::ImageCacheStatistics statistics = QQuickWindow::imageCacheStatistics();
+    QCOMPARE(statistics.unreferencedCount, 1);
+    QVERIFY(statistics.unreferencedBytes >= 800 * 600 * 4);
+    QCOMPARE(statistics.referencedBytes, initial.referencedBytes);
+
+    {
+        QQuickPixmap p(&engine, url);
+        QCOMPARE(QQuickWindow::imageCacheStatistics().hits, initial.hits + 1);
+        QCOMPARE(QQuickWindow::imageCacheStatistics().unreferencedCount, 0);
+    }
+
+    // a lower limit evicts it right away
+    QQuickWindow::setImageCacheLimits(-1, 1024);
+    statistics = QQuickWindow::imageCacheStatistics();
+    QCOMPARE(statistics.unreferencedCount, 0);
+    QCOMPARE(statistics.unreferencedBytes, qint64(0));
+    QCOMPARE(statistics.evictions, initial.evictions + 1);
+
+    // unused images only get the room that the ones in use leave within the total limit
+    QQuickWindow::setImageCacheLimits(initial.referencedBytes + cost * 5 / 2, 100 * 1024 * 1024);
+    auto isCached = [](const char *id) {
+        return QQuickPixmap::isCached(QUrl(QLatin1String("image://mypixmaps/") + QLatin1String(id)),
+                                      QRect(), QSize(), 0, QQuickImageProviderOptions());
+    };
+    {
+        QQuickPixmap inUse(&engine, QUrl("image://mypixmaps/inUse"));
+        {
+            QQuickPixmap first(&engine, QUrl("image://mypixmaps/first"));
+        }
+        QVERIFY(isCached("first"));
+        {
+            // there is no room for both
+            QQuickPixmap second(&engine, QUrl("image://mypixmaps/second"));
+            QVERIFY(!isCached("first"));
+        }
+        statistics = QQuickWindow::imageCacheStatistics();
+        QCOMPARE(statistics.unreferencedCount, 1);
+        QCOMPARE(statistics.unreferencedBytes, cost);
+        QVERIFY(isCached("second"));
+
+        QQuickPixmap third(&engine, QUrl("image://mypixmaps/third"));
+        QVERIFY(!isCached("second"));
+        QCOMPARE(QQuickWindow::imageCacheStatistics().unreferencedCount, 0);
+    }
+    QQuickPixmap::purgeCache();
+
+    // when the images in use alone exceed the limit, unused ones are not kept at all
+    QQuickWindow::setImageCacheLimits(1024, 100 * 1024 * 1024);
+    {
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Images in use take .* bytes"));
+        QQuickPixmap inUse(&engine, QUrl("image://mypixmaps/inUse"));
+        {
+            QQuickPixmap p(&engine, url);
+        }
+        QCOMPARE(QQuickWindow::imageCacheStatistics().unreferencedCount, 0);
+    }
+
+    // memory pressure releases unused images
+    QQuickWindow::setImageCacheLimits(-1, 100 * 1024 * 1024);
+    QQuickPixmap::purgeCache();
+    {
+        QQuickPixmap p(&engine, url);
+    }
+    QCOMPARE(QQuickWindow::imageCacheStatistics().unreferencedCount, 1);
+    QQuickWindow::handleMemoryPressure(QQuickWindow::CriticalMemoryPressure);
+    QCOMPARE(QQuickWindow::imageCacheStatistics().unreferencedCount, 0);
+}
+
 #if QT_CONFIG(concurrent)
 
 void createNetworkServer(TestHTTPServer *server)
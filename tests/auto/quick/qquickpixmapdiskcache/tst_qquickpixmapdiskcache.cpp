@@ -0,0 +1,196 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryDir>
+
+#include <QtQuick/private/qquickpixmapdiskcache_p.h>
+
+class tst_QQuickPixmapDiskCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void storeAndLoad();
+    void keyInvalidation();
+    void corruptedEntry();
+    void trim();
+
+private:
+    QByteArray key(const QQuickPixmapDiskCache &cache, const QString &fileName,
+                   const QSize &requestSize = QSize()) const;
+    QString entryFileName(const QByteArray &key) const;
+    QString writeSourceImage(const QString &name) const;
+
+    QTemporaryDir m_directory;
+    QString m_cacheDirectory;
+};
+
+void tst_QQuickPixmapDiskCache::initTestCase()
+{
+    QVERIFY(m_directory.isValid());
+    m_cacheDirectory = m_directory.filePath(QLatin1String("cache"));
+    // Read by each cache that is created.
+    qputenv("QML_IMAGE_DISK_CACHE_PATH", QFile::encodeName(m_cacheDirectory));
+    qputenv("QML_IMAGE_DISK_CACHE_SIZE", "2");
+}
+
+void tst_QQuickPixmapDiskCache::cleanup()
+{
+    QVERIFY(QDir(m_cacheDirectory).removeRecursively());
+}
+
+QByteArray tst_QQuickPixmapDiskCache::key(const QQuickPixmapDiskCache &cache,
+                                          const QString &fileName, const QSize &requestSize) const
+{
+    QFile file(fileName);
+    return cache.key(&file, QRect(), requestSize, QQuickImageProviderOptions(), 0, 1.0);
+}
+
+QString tst_QQuickPixmapDiskCache::entryFileName(const QByteArray &key) const
+{
+    return m_cacheDirectory + QLatin1Char('/') + QLatin1String(key);
+}
+
+QString tst_QQuickPixmapDiskCache::writeSourceImage(const QString &name) const
+{
+    const QString fileName = m_directory.filePath(name);
+    QImage image(16, 16, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    return image.save(fileName) ? fileName : QString();
+}
+
+static QQuickPixmapDiskCache::Entry createEntry(int width, int height, QColor color)
+{
+    QQuickPixmapDiskCache::Entry entry;
+    entry.image = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+    entry.image.fill(color);
+    entry.implicitSize = QSize(width * 2, height * 2);
+    entry.frameCount = 3;
+    return entry;
+}
+
+static bool setLastUsed(const QString &fileName, const QDateTime &time)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::ReadWrite)
+            && file.setFileTime(time, QFileDevice::FileModificationTime);
+}
+
+void tst_QQuickPixmapDiskCache::storeAndLoad()
+{
+    const QString source = writeSourceImage(QLatin1String("storeAndLoad.png"));
+    QVERIFY(!source.isEmpty());
+    const QQuickPixmapDiskCache::Entry stored = createEntry(64, 32, QColor(255, 0, 0, 128));
+
+    {
+        QQuickPixmapDiskCache cache;
+        const QByteArray entryKey = key(cache, source);
+        QVERIFY(!entryKey.isEmpty());
+        QQuickPixmapDiskCache::Entry entry;
+        QVERIFY(!cache.load(entryKey, &entry));
+        cache.store(entryKey, stored);
+    }
+
+    // As in the next run of the application.
+    QQuickPixmapDiskCache cache;
+    QQuickPixmapDiskCache::Entry entry;
+    QVERIFY(cache.load(key(cache, source), &entry));
+    QCOMPARE(entry.image, stored.image);
+    QCOMPARE(entry.implicitSize, stored.implicitSize);
+    QCOMPARE(entry.frameCount, stored.frameCount);
+    QCOMPARE(entry.appliedTransform, stored.appliedTransform);
+}
+
+void tst_QQuickPixmapDiskCache::keyInvalidation()
+{
+    const QString source = writeSourceImage(QLatin1String("keyInvalidation.png"));
+    QVERIFY(!source.isEmpty());
+
+    QQuickPixmapDiskCache cache;
+    const QByteArray entryKey = key(cache, source);
+    QVERIFY(!entryKey.isEmpty());
+    QCOMPARE(key(cache, source), entryKey);
+    QVERIFY(key(cache, source, QSize(8, 8)) != entryKey);
+
+    // Anything but a file cannot tell whether it changed.
+    QBuffer buffer;
+    QVERIFY(cache.key(&buffer, QRect(), QSize(), QQuickImageProviderOptions(), 0, 1.0).isEmpty());
+
+    cache.store(entryKey, createEntry(16, 16, Qt::red));
+    QVERIFY(setLastUsed(source, QDateTime::currentDateTimeUtc().addSecs(3600)));
+    const QByteArray modifiedKey = key(cache, source);
+    QVERIFY(!modifiedKey.isEmpty());
+    QVERIFY(modifiedKey != entryKey);
+    QQuickPixmapDiskCache::Entry entry;
+    QVERIFY(!cache.load(modifiedKey, &entry));
+}
+
+void tst_QQuickPixmapDiskCache::corruptedEntry()
+{
+    const QString source = writeSourceImage(QLatin1String("corruptedEntry.png"));
+    QVERIFY(!source.isEmpty());
+
+    QQuickPixmapDiskCache cache;
+    const QByteArray entryKey = key(cache, source);
+    cache.store(entryKey, createEntry(32, 32, Qt::green));
+    QQuickPixmapDiskCache::Entry entry;
+    QVERIFY(cache.load(entryKey, &entry));
+
+    // Missing pixels, as left behind by a full disk.
+    QFile file(entryFileName(entryKey));
+    QVERIFY(file.resize(file.size() - 100));
+    QVERIFY(!cache.load(entryKey, &entry));
+
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(QByteArray(4096, 'x')), 4096);
+    file.close();
+    QVERIFY(!cache.load(entryKey, &entry));
+
+    // A new entry replaces the corrupted one.
+    cache.store(entryKey, createEntry(32, 32, Qt::green));
+    QVERIFY(cache.load(entryKey, &entry));
+    QCOMPARE(entry.image.pixel(0, 0), QColor(Qt::green).rgb());
+}
+
+void tst_QQuickPixmapDiskCache::trim()
+{
+    QStringList sources;
+    for (int i = 0; i < 4; ++i) {
+        sources.append(writeSourceImage(QStringLiteral("trim%1.png").arg(i)));
+        QVERIFY(!sources.last().isEmpty());
+    }
+
+    // Each entry takes a little more than half a megabyte, so the fourth one takes the
+    // cache above its limit, and it is trimmed to three quarters of that, two entries.
+    QQuickPixmapDiskCache cache;
+    QList<QByteArray> keys;
+    for (int i = 0; i < 3; ++i) {
+        keys.append(key(cache, sources.at(i)));
+        cache.store(keys.last(), createEntry(256, 512, Qt::yellow));
+    }
+
+    // Age the entries, the first one the most. Loading it makes it the most recent one.
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (int i = 0; i < 3; ++i)
+        QVERIFY(setLastUsed(entryFileName(keys.at(i)), now.addSecs(-3600 * (3 - i))));
+    QQuickPixmapDiskCache::Entry entry;
+    QVERIFY(cache.load(keys.at(0), &entry));
+
+    keys.append(key(cache, sources.at(3)));
+    cache.store(keys.last(), createEntry(256, 512, Qt::yellow));
+
+    QVERIFY(!QFile::exists(entryFileName(keys.at(1))));
+    QVERIFY(!QFile::exists(entryFileName(keys.at(2))));
+    QVERIFY(!cache.load(keys.at(1), &entry));
+    QVERIFY(cache.load(keys.at(0), &entry));
+    QVERIFY(cache.load(keys.at(3), &entry));
+}
+
+QTEST_MAIN(tst_QQuickPixmapDiskCache)
+
+#include "tst_qquickpixmapdiskcache.moc"
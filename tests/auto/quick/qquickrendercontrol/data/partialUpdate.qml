@@ -0,0 +1,41 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 200
+    height: 200
+    color: "steelblue"
+
+    Grid {
+        x: 10
+        y: 100
+        columns: 6
+        spacing: 4
+        Repeater {
+            model: 18
+            Rectangle {
+                width: 26
+                height: 26
+                color: Qt.rgba(index / 18, 0.5, 1 - index / 18, 1)
+                opacity: index % 3 ? 1 : 0.5
+            }
+        }
+    }
+
+    Text {
+        x: 100
+        y: 10
+        text: "Partial"
+    }
+
+    Rectangle {
+        objectName: "changing"
+        x: 20
+        y: 20
+        width: 30
+        height: 30
+        color: "red"
+    }
+}
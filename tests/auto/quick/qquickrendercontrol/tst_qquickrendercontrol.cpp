@@ -21,6 +21,8 @@
 
 #include <QtGui/private/qrhi_p.h>
 #include <QtQuick/private/qquickrendercontrol_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qsgrenderer_p.h>
 
 #if QT_CONFIG(vulkan)
 #include <QVulkanInstance>
@@ -28,6 +30,7 @@
 #endif
 
 #include <QOperatingSystemVersion>
+#include <QScopeGuard>
 
 class AnimationDriver : public QAnimationDriver
 {
@@ -63,6 +66,8 @@ private slots:
     void renderAndReadBackWithRhi_data();
     void renderAndReadBackWithRhi();
     void renderAndReadBackWithVulkanNative();
+    void partialUpdate_data();
+    void partialUpdate();
 
 private:
 #if QT_CONFIG(vulkan)
@@ -704,4 +709,143 @@ void tst_RenderControl::renderAndReadBackWithVulkanNative()
 
 #include "tst_qquickrendercontrol.moc"
 
+void tst_RenderControl::partialUpdate_data()
+{
+    renderAndReadBackWithRhi_data();
+}
+
+void tst_RenderControl::partialUpdate()
+{
+    QFETCH(QSGRendererInterface::GraphicsApi, api);
+#if QT_CONFIG(vulkan)
+    if (api == QSGRendererInterface::VulkanRhi && !vulkanInstance.isValid())
+        QSKIP("Skipping Vulkan-based QRhi readback test due to failing to create a VkInstance");
+#endif
+
+#ifdef Q_OS_ANDROID
+    // QTBUG-102780
+    if (api == QSGRendererInterface::VulkanRhi)
+        QSKIP("Vulkan-based rendering tests on Android are flaky.");
+#endif
+
+    // Read when the renderer is created.
+    qputenv("QSG_RENDERER_PARTIAL_UPDATE", "1");
+    const auto restoreEnvironment = qScopeGuard([] { qunsetenv("QSG_RENDERER_PARTIAL_UPDATE"); });
+
+    QQuickWindow::setGraphicsApi(api);
+
+    QScopedPointer<QQuickRenderControl> renderControl(new QQuickRenderControl);
+    QScopedPointer<QQuickWindow> quickWindow(new QQuickWindow(renderControl.data()));
+#if QT_CONFIG(vulkan)
+    if (api == QSGRendererInterface::VulkanRhi)
+        quickWindow->setVulkanInstance(&vulkanInstance);
+#endif
+
+    QQmlEngine qmlEngine;
+    QQmlComponent qmlComponent(&qmlEngine, testFileUrl(QLatin1String("partialUpdate.qml")));
+    QScopedPointer<QQuickItem> rootItem(qobject_cast<QQuickItem *>(qmlComponent.create()));
+    QVERIFY2(rootItem, qPrintable(qmlComponent.errorString()));
+    QQuickItem *changing = rootItem->findChild<QQuickItem *>(QLatin1String("changing"));
+    QVERIFY(changing);
+
+    quickWindow->contentItem()->setSize(rootItem->size());
+    quickWindow->setGeometry(0, 0, rootItem->width(), rootItem->height());
+    rootItem->setParentItem(quickWindow->contentItem());
+
+    if (!renderControl->initialize()) {
+#if QT_CONFIG(opengl)
+        if (api != QSGRendererInterface::OpenGLRhi
+                || !QGuiApplicationPrivate::platformIntegration()->hasCapability(QPlatformIntegration::OpenGL))
+#endif
+        {
+            QSKIP("Could not initialize graphics, perhaps unsupported graphics API, skipping");
+        }
+        QFAIL("Could not initialize graphics");
+    }
+
+    QQuickRenderControlPrivate *rd = QQuickRenderControlPrivate::get(renderControl.data());
+    QRhi *rhi = rd->rhi;
+    Q_ASSERT(rhi);
+
+    const QSize size = rootItem->size().toSize();
+    QScopedPointer<QRhiTexture> tex(rhi->newTexture(QRhiTexture::RGBA8, size, 1,
+                                                    QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
+    QVERIFY(tex->create());
+    QScopedPointer<QRhiRenderBuffer> ds(rhi->newRenderBuffer(QRhiRenderBuffer::DepthStencil, size, 1));
+    QVERIFY(ds->create());
+    QRhiTextureRenderTargetDescription rtDesc(QRhiColorAttachment(tex.data()));
+    rtDesc.setDepthStencilBuffer(ds.data());
+
+    // Only a target that keeps its contents between frames can be updated partially.
+    QScopedPointer<QRhiTextureRenderTarget> texRt(
+                rhi->newTextureRenderTarget(rtDesc, QRhiTextureRenderTarget::PreserveColorContents));
+    QScopedPointer<QRhiRenderPassDescriptor> rp(texRt->newCompatibleRenderPassDescriptor());
+    texRt->setRenderPassDescriptor(rp.data());
+    QVERIFY(texRt->create());
+
+    QScopedPointer<QRhiTextureRenderTarget> fullTexRt(rhi->newTextureRenderTarget(rtDesc));
+    QScopedPointer<QRhiRenderPassDescriptor> fullRp(fullTexRt->newCompatibleRenderPassDescriptor());
+    fullTexRt->setRenderPassDescriptor(fullRp.data());
+    QVERIFY(fullTexRt->create());
+
+    const auto renderFrame = [&]() {
+        QCoreApplication::processEvents();
+        renderControl->polishItems();
+        renderControl->beginFrame();
+        renderControl->sync();
+        renderControl->render();
+
+        QRhiReadbackResult readResult;
+        QImage result;
+        readResult.completed = [&readResult, &result, &rhi] {
+            QImage wrapperImage(reinterpret_cast<const uchar *>(readResult.data.constData()),
+                                readResult.pixelSize.width(), readResult.pixelSize.height(),
+                                QImage::Format_RGBA8888_Premultiplied);
+            if (rhi->isYUpInFramebuffer())
+                result = wrapperImage.mirrored();
+            else
+                result = wrapperImage.copy();
+        };
+        QRhiResourceUpdateBatch *readbackBatch = rhi->nextResourceUpdateBatch();
+        readbackBatch->readBackTexture(tex.data(), &readResult);
+        rd->cb->resourceUpdate(readbackBatch);
+
+        // Offscreen frames are synchronous, the readback has finished once the frame is done.
+        renderControl->endFrame();
+        return result;
+    };
+    const auto damageRegion = [&]() {
+        QSGRenderer *renderer = QQuickWindowPrivate::get(quickWindow.data())->renderer;
+        return renderer ? renderer->damageRegion() : QRegion();
+    };
+
+    quickWindow->setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(texRt.data()));
+    QVERIFY(!renderFrame().isNull());
+    QCOMPARE(damageRegion(), QRegion(0, 0, size.width(), size.height()));
+
+    // Nothing changed, so nothing needs to be redrawn.
+    QVERIFY(!renderFrame().isNull());
+    QVERIFY(damageRegion().isEmpty());
+
+    changing->setX(60);
+    changing->setProperty("color", QColor(Qt::yellow));
+    const QImage partial = renderFrame();
+    QVERIFY(!partial.isNull());
+
+    // The old and the new area of the rectangle, plus a little padding for rounding.
+    const QRect damage = damageRegion().boundingRect();
+    const QRect changed(20, 20, 70, 30);
+    QVERIFY2(damage.contains(changed), qPrintable(QDebug::toString(damage)));
+    QVERIFY2(changed.adjusted(-2, -2, 2, 2).contains(damage), qPrintable(QDebug::toString(damage)));
+
+    // Draw everything into a target that does not preserve its contents, and make sure the
+    // partial update got to the same result.
+    quickWindow->setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(fullTexRt.data()));
+    const QImage full = renderFrame();
+    QCOMPARE(damageRegion(), QRegion(0, 0, size.width(), size.height()));
+    QCOMPARE(partial, full);
+    QCOMPARE(full.pixel(75, 35), qRgb(255, 255, 0));
+    QVERIFY(full.pixel(25, 25) != qRgb(255, 0, 0));
+}
+
 QTEST_MAIN(tst_RenderControl)
@@ -135,6 +135,7 @@ private slots:
     void checkIfDelegatesAreReused_data();
     void checkIfDelegatesAreReused();
     void checkIfDelegatesAreReusedAsymmetricTableSize();
+    void checkPrefetchLines();
     void checkContextProperties_data();
     void checkContextProperties();
     void checkContextPropertiesQQmlListProperyModel_data();
@@ -2012,6 +2013,58 @@ void tst_QQuickTableView::checkIfDelegatesAreReused()
     }
 }
 
+void tst_QQuickTableView::checkPrefetchLines()
+{
+    // Check that TableView starts to create the delegate items of the columns that
+    // the viewport is heading for, and that it takes them into use once the
+    // columns are loaded.
+    LOAD_TABLEVIEW("plaintableview.qml");
+
+    auto model = TestModelAsVariant(100, 100);
+    tableView->setModel(model);
+    tableView->setPrefetchLines(2);
+
+    WAIT_UNTIL_POLISHED;
+
+    const int rightColumn = tableView->rightColumn();
+    const int rowCount = tableViewPrivate->loadedRows.count();
+    QVERIFY(tableViewPrivate->prefetchedItems.isEmpty());
+
+    // Move the viewport one pixel to the right, which is not enough to load a new column
+    tableView->setContentX(1);
+    QCOMPARE(tableView->rightColumn(), rightColumn);
+    QCOMPARE(tableViewPrivate->prefetchedItems.count() + tableViewPrivate->pendingPrefetches.count(),
+             rowCount * 2);
+
+    // The items are incubated asynchronously, and are kept hidden while they wait
+    QTRY_COMPARE(tableViewPrivate->prefetchedItems.count(), rowCount * 2);
+    QVERIFY(tableViewPrivate->pendingPrefetches.isEmpty());
+    for (int row : tableViewPrivate->loadedRows) {
+        for (int column = rightColumn + 1; column <= rightColumn + 2; ++column) {
+            const int modelIndex = tableViewPrivate->modelIndexAtCell(QPoint(column, row));
+            auto item = qobject_cast<QQuickItem *>(tableViewPrivate->prefetchedItems.value(modelIndex));
+            QVERIFY(item);
+            QVERIFY(QQuickItemPrivate::get(item)->culled);
+        }
+    }
+
+    const QPoint cell(rightColumn + 1, tableView->topRow());
+    const int modelIndex = tableViewPrivate->modelIndexAtCell(cell);
+    QObject *prefetchedItem = tableViewPrivate->prefetchedItems.value(modelIndex);
+
+    // Move the next column into view, which should take the prefetched items into use
+    tableView->setContentX(50);
+    QCOMPARE(tableView->rightColumn(), rightColumn + 1);
+    QCOMPARE(tableView->itemAtCell(cell), prefetchedItem);
+    QVERIFY(!QQuickItemPrivate::get(tableView->itemAtCell(cell))->culled);
+    QVERIFY(!tableViewPrivate->prefetchedItems.contains(modelIndex));
+
+    // Turning prefetching off should release what is left
+    tableView->setPrefetchLines(0);
+    QVERIFY(tableViewPrivate->prefetchedItems.isEmpty());
+    QVERIFY(tableViewPrivate->pendingPrefetches.isEmpty());
+}
+
 void tst_QQuickTableView::checkIfDelegatesAreReusedAsymmetricTableSize()
 {
     // Check that we end up reusing all delegate items while flicking, also if the table contain
@@ -0,0 +1,16 @@
+import QtQuick
+
+Flickable {
+    width: 320; height: 240
+    contentWidth: edit.width
+    contentHeight: edit.height
+    clip: true
+
+    TextEdit {
+        id: edit
+        objectName: "edit"
+        font.pixelSize: 10
+        readOnly: true
+        virtualized: true
+    }
+}
@@ -18,6 +18,7 @@
 #include <private/qquicktextedit_p_p.h>
 #include <private/qquicktext_p.h>
 #include <private/qquicktextdocument_p.h>
+#include <private/qquickwindow_p.h>
 #include <QFontMetrics>
 #include <QtQuick/QQuickView>
 #include <QDir>
@@ -137,6 +138,7 @@ private slots:
     void implicitSizeBinding();
     void largeTextObservesViewport_data();
     void largeTextObservesViewport();
+    void virtualized();
 
     void signal_editingfinished();
 
@@ -3778,6 +3780,72 @@ void tst_qquicktextedit::largeTextObservesViewport()
     QCOMPARE(textPriv->cursorItem->isVisible(), textPriv->renderedRegion.intersects(textItem->cursorRectangle()));
 }
 
+void tst_qquicktextedit::virtualized()
+{
+    if ((QGuiApplication::platformName() == QLatin1String("offscreen"))
+        || (QGuiApplication::platformName() == QLatin1String("minimal")))
+        QSKIP("Skipping due to grabWindow not functional on offscreen/minimal platforms");
+
+    QQuickView window;
+    QByteArray errorMessage;
+    QVERIFY2(QQuickTest::initView(window, testFileUrl("virtualized.qml"), true, &errorMessage), errorMessage.constData());
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QQuickFlickable *flickable = qobject_cast<QQuickFlickable *>(window.rootObject());
+    QVERIFY(flickable);
+    QQuickTextEdit *textItem = flickable->findChild<QQuickTextEdit *>("edit");
+    QVERIFY(textItem);
+    QQuickTextEditPrivate *textPriv = QQuickTextEditPrivate::get(textItem);
+    QVERIFY(textItem->isVirtualized());
+    QVERIFY(textPriv->plainTextLayout());
+
+    const int lineCount = 100000;
+    QStringList lines;
+    lines.reserve(lineCount);
+    for (int i = 0; i < lineCount; ++i)
+        lines << QLatin1String("line ") + QString::number(i);
+    textItem->setText(lines.join('\n'));
+    QVERIFY(textItem->flags().testFlag(QQuickItem::ItemObservesViewport));
+
+    // Only the blocks around the viewport are rendered; the size of the rest is estimated.
+    const qreal lineHeight = QFontMetricsF(textItem->font()).height();
+    QTRY_VERIFY(textPriv->firstBlockPastViewport > 0);
+    QCOMPARE(textPriv->firstBlockInViewport, 0);
+    QVERIFY(textPriv->firstBlockPastViewport < 100);
+    QCOMPARE(textItem->lineCount(), lineCount);
+    QVERIFY(textItem->contentHeight() > lineCount * lineHeight / 2);
+    QVERIFY(textItem->contentHeight() < lineCount * lineHeight * 2);
+
+    // Scrolling to the middle renders the blocks there, without going through those above.
+    // They are laid out when the item is polished, before the render thread syncs.
+    const QTextDocument *document = textItem->textDocument()->textDocument();
+    const auto laidOutFrom = [document](int blockNumber) {
+        for (QTextBlock block = document->findBlockByNumber(blockNumber); block.isValid(); block = block.next()) {
+            if (block.layout()->lineCount() > 0)
+                return true;
+        }
+        return false;
+    };
+    flickable->setContentY(textItem->contentHeight() / 2);
+    QVERIFY(!laidOutFrom(lineCount / 4));
+    QQuickWindowPrivate::get(&window)->polishItems();
+    QVERIFY(laidOutFrom(lineCount / 4));
+    QTRY_VERIFY(textPriv->firstBlockInViewport > lineCount / 4);
+    QVERIFY(textPriv->firstBlockInViewport < lineCount * 3 / 4);
+    QVERIFY(textPriv->firstBlockPastViewport > textPriv->firstBlockInViewport);
+    QVERIFY(textPriv->firstBlockPastViewport - textPriv->firstBlockInViewport < 100);
+    QCOMPARE(textItem->lineCount(), lineCount);
+
+    // Editable text needs the regular layout.
+    textItem->setReadOnly(false);
+    QVERIFY(!textPriv->plainTextLayout());
+    QCOMPARE(textItem->lineCount(), lineCount);
+    textItem->setReadOnly(true);
+    QVERIFY(textPriv->plainTextLayout());
+    textItem->setVirtualized(false);
+    QVERIFY(!textPriv->plainTextLayout());
+}
+
 void tst_qquicktextedit::signal_editingfinished()
 {
     QQuickView *window = new QQuickView(nullptr);
@@ -503,6 +503,7 @@ private slots:
 
     void animatingSignal();
     void frameSignals();
+    void frameStatistics();
 
     void contentItemSize();
 
@@ -2453,6 +2454,48 @@ void tst_qquickwindow::frameSignals()
     QTRY_COMPARE(beforeSpy.count(), afterSpy.count());
 }
 
+void tst_qquickwindow::frameStatistics()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.setGeometry(100, 100, 300, 200);
+    QQuickRectangle *rect = new QQuickRectangle(window.contentItem());
+    rect->setSize(QSizeF(100, 100));
+    rect->setColor(Qt::red);
+
+    QVERIFY(!window.isFrameStatisticsEnabled());
+    window.setFrameStatisticsEnabled(true);
+    QVERIFY(window.isFrameStatisticsEnabled());
+
+    QSignalSpy statsSpy(&window, SIGNAL(frameStatisticsAvailable()));
+
+    window.show();
+    QTRY_VERIFY(window.isExposed());
+    QTRY_VERIFY(statsSpy.count() > 0);
+
+    const QQuickWindow::FrameStatistics stats = window.frameStatistics();
+    QVERIFY(stats.syncTime >= 0);
+    QVERIFY(stats.renderTime >= 0);
+    QVERIFY(stats.swapTime >= 0);
+    QCOMPARE(stats.batchCount, stats.mergedBatchCount + stats.unmergedBatchCount);
+    if (QSGRendererInterface::isApiRhiBased(window.rendererInterface()->graphicsApi()))
+        QVERIFY(stats.batchCount > 0);
+
+    window.setFrameStatisticsEnabled(false);
+    QSignalSpy swappedSpy(&window, SIGNAL(frameSwapped()));
+    // A frame that had already started when collection got disabled can still
+    // report. It is finished by the time the frame after it has been swapped.
+    window.update();
+    QTRY_VERIFY(swappedSpy.count() >= 1);
+    window.update();
+    QTRY_VERIFY(swappedSpy.count() >= 2);
+    const int count = statsSpy.count();
+    const int swapped = swappedSpy.count();
+    window.update();
+    QTRY_VERIFY(swappedSpy.count() > swapped);
+    QCOMPARE(statsSpy.count(), count);
+}
+
 // QTBUG-36938
 void tst_qquickwindow::contentItemSize()
 {
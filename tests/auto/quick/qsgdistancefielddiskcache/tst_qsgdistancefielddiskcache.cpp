@@ -0,0 +1,188 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QRawFont>
+
+#include <QtQuick/private/qsgdistancefielddiskcache_p.h>
+#include <QtGui/private/qdistancefield_p.h>
+
+class tst_QSGDistanceFieldDiskCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void storeAndLoad();
+    void sharedFile();
+    void truncatedFile();
+    void corruptedFile();
+
+private:
+    QSGDistanceFieldDiskCache *createCache() const;
+    QString cacheFileName() const;
+    void verifyGlyph(const QSGDistanceFieldDiskCache *cache, glyph_t glyph) const;
+
+    QTemporaryDir m_directory;
+    QRawFont m_font;
+    QList<glyph_t> m_glyphs;
+};
+
+void tst_QSGDistanceFieldDiskCache::initTestCase()
+{
+    QVERIFY(m_directory.isValid());
+    // The directory is read once, when the first cache is created.
+    qputenv("QSG_DISTANCEFIELD_CACHE_DIR", QFile::encodeName(m_directory.path()));
+
+    m_font = QRawFont(QFINDTESTDATA("data/tarzeau_ocr_a.ttf"), QT_DISTANCEFIELD_BASEFONTSIZE(false));
+    QVERIFY(m_font.isValid());
+    m_glyphs = m_font.glyphIndexesForString(QLatin1String("ABC"));
+    QCOMPARE(m_glyphs.size(), 3);
+}
+
+void tst_QSGDistanceFieldDiskCache::cleanup()
+{
+    QDir directory(m_directory.path());
+    for (const QString &entry : directory.entryList(QDir::Files))
+        QVERIFY(directory.remove(entry));
+}
+
+QSGDistanceFieldDiskCache *tst_QSGDistanceFieldDiskCache::createCache() const
+{
+    return QSGDistanceFieldDiskCache::create(m_font, false, 2);
+}
+
+QString tst_QSGDistanceFieldDiskCache::cacheFileName() const
+{
+    const QStringList files = QDir(m_directory.path()).entryList({ QLatin1String("*.qsgdf") });
+    return files.size() == 1 ? QDir(m_directory.path()).filePath(files.first()) : QString();
+}
+
+void tst_QSGDistanceFieldDiskCache::verifyGlyph(const QSGDistanceFieldDiskCache *cache,
+                                                glyph_t glyph) const
+{
+    const QSGDistanceFieldDiskCache::Glyph *cached = cache->glyph(glyph);
+    QVERIFY(cached);
+    const QDistanceField field(m_font, glyph, false);
+    QCOMPARE(cached->width, field.width());
+    QCOMPARE(cached->height, field.height());
+    QCOMPARE(cached->boundingRect, m_font.boundingRect(glyph));
+    QVERIFY(memcmp(cached->bits, field.constBits(), field.width() * field.height()) == 0);
+}
+
+static void insertGlyph(QSGDistanceFieldDiskCache *cache, const QRawFont &font, glyph_t glyph)
+{
+    cache->insert(glyph, font.boundingRect(glyph), QDistanceField(font, glyph, false));
+}
+
+void tst_QSGDistanceFieldDiskCache::storeAndLoad()
+{
+    {
+        QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+        QVERIFY(cache);
+        QVERIFY(cache->glyphs().isEmpty());
+        insertGlyph(cache.data(), m_font, m_glyphs.at(0));
+        insertGlyph(cache.data(), m_font, m_glyphs.at(1));
+        cache->flush();
+    }
+
+    QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+    QCOMPARE(cache->glyphs().size(), 2);
+    verifyGlyph(cache.data(), m_glyphs.at(0));
+    verifyGlyph(cache.data(), m_glyphs.at(1));
+    QVERIFY(!cache->glyph(m_glyphs.at(2)));
+}
+
+void tst_QSGDistanceFieldDiskCache::sharedFile()
+{
+    {
+        QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+        insertGlyph(cache.data(), m_font, m_glyphs.at(0));
+    }
+
+    // Two caches, as in two processes, that have mapped the same file append to it.
+    QScopedPointer<QSGDistanceFieldDiskCache> first(createCache());
+    QScopedPointer<QSGDistanceFieldDiskCache> second(createCache());
+    QCOMPARE(first->glyphs().size(), 1);
+    QCOMPARE(second->glyphs().size(), 1);
+
+    insertGlyph(first.data(), m_font, m_glyphs.at(1));
+    first->flush();
+    insertGlyph(second.data(), m_font, m_glyphs.at(2));
+    second->flush();
+
+    // Neither invalidated the glyphs the other one has mapped.
+    verifyGlyph(first.data(), m_glyphs.at(0));
+    verifyGlyph(second.data(), m_glyphs.at(0));
+
+    QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+    QCOMPARE(cache->glyphs().size(), 3);
+    for (glyph_t glyph : std::as_const(m_glyphs))
+        verifyGlyph(cache.data(), glyph);
+}
+
+void tst_QSGDistanceFieldDiskCache::truncatedFile()
+{
+    {
+        QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+        insertGlyph(cache.data(), m_font, m_glyphs.at(0));
+        insertGlyph(cache.data(), m_font, m_glyphs.at(1));
+    }
+
+    // Leave a partial record behind, as a writer that crashed would.
+    const QString fileName = cacheFileName();
+    QVERIFY(!fileName.isEmpty());
+    QFile file(fileName);
+    const qint64 size = file.size();
+    QVERIFY(file.resize(size - 10));
+
+    QScopedPointer<QSGDistanceFieldDiskCache> reader(createCache());
+    QCOMPARE(reader->glyphs().size(), 1);
+    verifyGlyph(reader.data(), m_glyphs.at(0));
+
+    {
+        QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+        QCOMPARE(cache->glyphs().size(), 1);
+        insertGlyph(cache.data(), m_font, m_glyphs.at(2));
+    }
+
+    // The file was replaced, so the glyphs that are still mapped stay valid.
+    verifyGlyph(reader.data(), m_glyphs.at(0));
+
+    QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+    QCOMPARE(cache->glyphs().size(), 2);
+    verifyGlyph(cache.data(), m_glyphs.at(0));
+    verifyGlyph(cache.data(), m_glyphs.at(2));
+}
+
+void tst_QSGDistanceFieldDiskCache::corruptedFile()
+{
+    {
+        QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+        insertGlyph(cache.data(), m_font, m_glyphs.at(0));
+    }
+
+    const QString fileName = cacheFileName();
+    QVERIFY(!fileName.isEmpty());
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QVERIFY(file.write(QByteArray(256, 'x')) == 256);
+    file.close();
+
+    {
+        QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+        QVERIFY(cache->glyphs().isEmpty());
+        insertGlyph(cache.data(), m_font, m_glyphs.at(1));
+    }
+
+    QScopedPointer<QSGDistanceFieldDiskCache> cache(createCache());
+    QCOMPARE(cache->glyphs().size(), 1);
+    verifyGlyph(cache.data(), m_glyphs.at(1));
+}
+
+QTEST_MAIN(tst_QSGDistanceFieldDiskCache)
+
+#include "tst_qsgdistancefielddiskcache.moc"
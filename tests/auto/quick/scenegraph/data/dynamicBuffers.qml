@@ -0,0 +1,23 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+// Enough rectangles of the same kind to end up in one large merged batch.
+Rectangle {
+    width: 400
+    height: 400
+    color: "#ffffff"
+
+    Repeater {
+        model: 400
+        Rectangle {
+            objectName: "cell"
+            x: (index % 20) * 20
+            y: Math.floor(index / 20) * 20
+            width: 16
+            height: 16
+            color: "#ff0000"
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.2
+
+/*
+    This test verifies that content hidden behind an opaque rectangle
+    is not rendered, and that it shows up correctly once the rectangle
+    no longer covers it.
+
+    #samples: 5
+                 PixelPos     R    G    B    Error-tolerance
+    #base:        20  20     0.0  1.0  0.0       0.05
+    #base:        20 110     0.0  1.0  0.0       0.05
+    #final:       20  20     1.0  0.0  0.0       0.05
+    #final:       20 110     0.5  0.5  1.0       0.05
+    #final:      150  20     0.0  1.0  0.0       0.05
+*/
+
+RenderTestBase {
+    Rectangle { color: "#ff0000"; x: 10; y: 10; width: 20; height: 20; }
+    Rectangle { color: "#0000ff"; x: 10; y: 100; width: 20; height: 20; opacity: 0.5; }
+    Rectangle { id: cover; color: "#00ff00"; x: 0; y: 0; width: 100; height: 200; }
+
+    onEnterFinalStage: {
+        cover.x = 100;
+        finalStageComplete = true;
+    }
+}
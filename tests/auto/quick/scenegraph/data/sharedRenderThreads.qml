@@ -0,0 +1,18 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 100
+    height: 100
+    color: "#0000ff"
+
+    Rectangle {
+        width: 30
+        height: 30
+        anchors.centerIn: parent
+        color: "#00ff00"
+        NumberAnimation on rotation { from: 0; to: 360; duration: 1000; loops: Animation.Infinite }
+    }
+}
@@ -11,6 +11,8 @@
 
 #include <QtQuick>
 #include <QtQml>
+#include <QScopeGuard>
+#include <QSignalSpy>
 
 #if QT_CONFIG(opengl)
 #include <private/qopenglcontext_p.h>
@@ -20,6 +22,9 @@
 #include <private/qsgrenderloop_p.h>
 #include <private/qsgrhisupport_p.h>
 #include <private/qsgplaintexture_p.h>
+#include <private/qsgdefaultrendercontext_p.h>
+#include <private/qsgrhiatlastexture_p.h>
+#include <private/qquickwindow_p.h>
 
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include <QtQuickTestUtils/private/visualtestutils_p.h>
@@ -27,6 +32,11 @@
 #include <QtGui/private/qguiapplication_p.h>
 #include <QtGui/qpa/qplatformintegration.h>
 
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#  include <malloc.h>
+#  define HAVE_MALLINFO2
+#endif
+
 using namespace QQuickVisualTestUtils;
 
 class PerPixelRect : public QQuickItem
@@ -86,9 +96,13 @@ private slots:
 
     void manyWindows_data();
     void manyWindows();
+    void sharedRenderThreads_data();
+    void sharedRenderThreads();
+    void sharedRenderThreadsResources();
 
     void render_data();
     void render();
+    void dynamicBufferUpdates();
 #if QT_CONFIG(opengl)
     void hideWithOtherContext();
 #endif
@@ -96,10 +110,13 @@ private slots:
     void createTextureFromImage();
     void withAdoptedRhi();
     void resizeTextureFromImage();
+    void releaseAtlasPages();
 
 private:
     QQuickView *createView(const QString &file, QWindow *parent = nullptr, int x = -1, int y = -1, int w = -1, int h = -1);
     bool isRunningOnRhi();
+    void renderWithThreads(const QByteArray &threads, int windowCount,
+                           QSet<QThread *> *renderThreads, qint64 *heapUsed);
 };
 
 template <typename T> class ScopedList : public QList<T> {
@@ -256,6 +273,200 @@ void tst_SceneGraph::manyWindows()
     }
 }
 
+void tst_SceneGraph::sharedRenderThreads_data()
+{
+    QTest::addColumn<QByteArray>("threads");
+    QTest::addColumn<bool>("nullBackend");
+
+    QTest::newRow("1 thread") << QByteArray("1") << false;
+    QTest::newRow("2 threads") << QByteArray("2") << false;
+    // The null backend renders nothing to compare, but runs on every platform.
+    QTest::newRow("1 thread, null backend") << QByteArray("1") << true;
+    QTest::newRow("2 threads, null backend") << QByteArray("2") << true;
+}
+
+// Bytes allocated on the heap by all threads, the render threads included.
+static qint64 heapInUse()
+{
+#ifdef HAVE_MALLINFO2
+    const struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+void tst_SceneGraph::sharedRenderThreads()
+{
+    QFETCH(QByteArray, threads);
+    QFETCH(bool, nullBackend);
+
+    if (!nullBackend && ((QGuiApplication::platformName() == QLatin1String("offscreen"))
+        || (QGuiApplication::platformName() == QLatin1String("minimal"))))
+        QSKIP("Skipping due to grabWindow not functional on offscreen/minimal platforms");
+    if (!QQuickWindow::sceneGraphBackend().isEmpty())
+        QSKIP("Skipping due to not running with QRhi");
+
+    // The render loop reads the variables when it is created, so start over with a new one,
+    // and leave a default one to the other tests.
+    const QSGRendererInterface::GraphicsApi graphicsApi = QQuickWindow::graphicsApi();
+    QSGRenderLoop::cleanup();
+    if (nullBackend)
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::NullRhi);
+    qputenv("QSG_RENDER_LOOP", "threaded");
+    qputenv("QSG_RENDER_THREADS", threads);
+    const auto restoreRenderLoop = qScopeGuard([graphicsApi] {
+        QSGRenderLoop::cleanup();
+        qunsetenv("QSG_RENDER_LOOP");
+        qunsetenv("QSG_RENDER_THREADS");
+        QQuickWindow::setGraphicsApi(graphicsApi);
+    });
+    if (!QSGRenderLoop::instance()->inherits("QSGThreadedRenderLoop"))
+        QSKIP("Skipping due to the threaded render loop not being available");
+
+    const auto verifyContent = [nullBackend](QQuickView *view) {
+        if (nullBackend)
+            return true;
+        const QImage content = view->grabWindow().convertToFormat(QImage::Format_RGB32);
+        if (content.isNull())
+            return false;
+        const QRgb corner = content.pixel(2, 2);
+        const QRgb center = content.pixel(content.width() / 2, content.height() / 2);
+        return qBlue(corner) > 240 && qRed(corner) < 16 && qGreen(corner) < 16
+                && qGreen(center) > 240 && qRed(center) < 16 && qBlue(center) < 16;
+    };
+
+    ScopedList<QQuickView *> views;
+    const int COUNT = 5;
+    for (int i = 0; i < COUNT; ++i)
+        views << createView(QStringLiteral("sharedRenderThreads.qml"), nullptr, (i % 3) * 110, (i / 3) * 110, 100, 100);
+    QSet<QThread *> renderThreads;
+    for (QQuickView *view : std::as_const(views)) {
+        QVERIFY(QTest::qWaitForWindowExposed(view));
+        QVERIFY(verifyContent(view));
+        renderThreads.insert(QQuickWindowPrivate::get(view)->context->thread());
+    }
+    QCOMPARE(renderThreads.size(), threads.toInt());
+    QVERIFY(!renderThreads.contains(QThread::currentThread()));
+
+    // All the windows keep animating, none is starved by the others.
+    for (QQuickView *view : std::as_const(views)) {
+        QSignalSpy frameSwapped(view, &QQuickWindow::frameSwapped);
+        QTRY_VERIFY(frameSwapped.count() >= 3);
+    }
+
+    // Resize some of them.
+    views.at(0)->resize(140, 120);
+    views.at(3)->resize(60, 80);
+    for (int i : { 0, 3 }) {
+        QSignalSpy frameSwapped(views.at(i), &QQuickWindow::frameSwapped);
+        QTRY_VERIFY(frameSwapped.count() >= 2);
+        QCOMPARE(views.at(i)->grabWindow().size(), views.at(i)->size() * views.at(i)->devicePixelRatio());
+        QVERIFY(verifyContent(views.at(i)));
+    }
+
+    // Hide and show one, and close and replace others, while the rest keep rendering
+    // on the same threads.
+    views.at(1)->hide();
+    delete views.takeAt(2);
+    QVERIFY(verifyContent(views.at(0)));
+    views.at(1)->show();
+    QVERIFY(QTest::qWaitForWindowExposed(views.at(1)));
+    QVERIFY(verifyContent(views.at(1)));
+
+    delete views.takeFirst();
+    views << createView(QStringLiteral("sharedRenderThreads.qml"), nullptr, 0, 220, 100, 100);
+    QVERIFY(QTest::qWaitForWindowExposed(views.last()));
+    for (QQuickView *view : std::as_const(views))
+        QVERIFY(verifyContent(view));
+
+    // Close them in creation order, the last one takes the threads down.
+    while (!views.isEmpty()) {
+        delete views.takeFirst();
+        for (QQuickView *view : std::as_const(views)) {
+            QSignalSpy frameSwapped(view, &QQuickWindow::frameSwapped);
+            QTRY_VERIFY(frameSwapped.count() >= 1);
+        }
+    }
+}
+
+void tst_SceneGraph::renderWithThreads(const QByteArray &threads, int windowCount,
+                                       QSet<QThread *> *renderThreads, qint64 *heapUsed)
+{
+    QSGRenderLoop::cleanup();
+    if (threads.isEmpty())
+        qunsetenv("QSG_RENDER_THREADS");
+    else
+        qputenv("QSG_RENDER_THREADS", threads);
+    QVERIFY(QSGRenderLoop::instance()->inherits("QSGThreadedRenderLoop"));
+
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    const qint64 heapBefore = heapInUse();
+
+    ScopedList<QQuickView *> views;
+    for (int i = 0; i < windowCount; ++i)
+        views << createView(QStringLiteral("sharedRenderThreads.qml"), nullptr, (i % 3) * 110, (i / 3) * 110, 100, 100);
+    for (QQuickView *view : std::as_const(views)) {
+        QVERIFY(QTest::qWaitForWindowExposed(view));
+        QSignalSpy frameSwapped(view, &QQuickWindow::frameSwapped);
+        QTRY_VERIFY(frameSwapped.count() >= 3);
+        renderThreads->insert(QQuickWindowPrivate::get(view)->context->thread());
+    }
+
+    *heapUsed = heapInUse() - heapBefore;
+}
+
+// Every render thread has a render context and a QRhi of its own. With the null backend,
+// which runs everywhere, check that sharing threads creates fewer of them and saves memory.
+void tst_SceneGraph::sharedRenderThreadsResources()
+{
+    if (heapInUse() < 0)
+        QSKIP("Heap usage can only be measured with glibc");
+    if (!QQuickWindow::sceneGraphBackend().isEmpty())
+        QSKIP("Skipping due to not running with QRhi");
+
+    const QSGRendererInterface::GraphicsApi graphicsApi = QQuickWindow::graphicsApi();
+    QSGRenderLoop::cleanup();
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::NullRhi);
+    qputenv("QSG_RENDER_LOOP", "threaded");
+    const auto restoreRenderLoop = qScopeGuard([graphicsApi] {
+        QSGRenderLoop::cleanup();
+        qunsetenv("QSG_RENDER_LOOP");
+        qunsetenv("QSG_RENDER_THREADS");
+        QQuickWindow::setGraphicsApi(graphicsApi);
+    });
+
+    const int COUNT = 6;
+    QSet<QThread *> renderThreads;
+    qint64 heapUsed = 0;
+
+    // Leave one-time initialization out of the measurements.
+    renderWithThreads(QByteArray(), 1, &renderThreads, &heapUsed);
+    if (QTest::currentTestFailed())
+        return;
+
+    QSet<QThread *> sharedThreads;
+    qint64 sharedHeapUsed = 0;
+    renderWithThreads(QByteArray("2"), COUNT, &sharedThreads, &sharedHeapUsed);
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(sharedThreads.size(), 2);
+    QVERIFY(!sharedThreads.contains(QThread::currentThread()));
+
+    QSet<QThread *> ownThreads;
+    qint64 ownHeapUsed = 0;
+    renderWithThreads(QByteArray(), COUNT, &ownThreads, &ownHeapUsed);
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(ownThreads.size(), COUNT);
+
+    qDebug() << "heap used by" << COUNT << "windows:" << sharedHeapUsed
+                     << "bytes on 2 render threads," << ownHeapUsed << "bytes on one thread each";
+    QVERIFY2(sharedHeapUsed < ownHeapUsed,
+             qPrintable(QString::fromLatin1("%1 bytes on 2 render threads, %2 bytes on one thread each")
+                                .arg(sharedHeapUsed).arg(ownHeapUsed)));
+}
+
 struct Sample {
     constexpr Sample(int xx, int yy, qreal rr, qreal gg, qreal bb, qreal errorMargin = 0.05)
         : x(xx)
@@ -363,7 +574,8 @@ void tst_SceneGraph::render_data()
           << "render_bug37422.qml"
           << "render_OpacityThroughBatchRoot.qml"
           << "render_Mipmap.qml"
-          << "render_AlphaOverlapRebuild.qml";
+          << "render_AlphaOverlapRebuild.qml"
+          << "render_Occlusion.qml";
 
     QRegularExpression sampleCount("#samples: *(\\d+)");
     //                          X:int   Y:int   R:float       G:float       B:float       Error:float
@@ -452,6 +664,55 @@ void tst_SceneGraph::render()
     }
 }
 
+void tst_SceneGraph::dynamicBufferUpdates()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping complex rendering tests due to not running with QRhi");
+
+    QQuickView view;
+    view.setSource(testFileUrl("dynamicBuffers.qml"));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QList<QQuickItem *> cells;
+    const auto childItems = view.rootObject()->childItems();
+    for (QQuickItem *child : childItems) {
+        if (child->objectName() == QLatin1String("cell"))
+            cells.append(child);
+    }
+    QCOMPARE(cells.size(), 400);
+
+    const qreal scale = view.devicePixelRatio();
+    auto verifyCells = [&](int frame) {
+        const QImage content = view.grabWindow();
+        for (QQuickItem *cell : std::as_const(cells)) {
+            const QPoint left(qRound((cell->x() + 4) * scale), qRound((cell->y() + 8) * scale));
+            const QPoint right(qRound((cell->x() + 12) * scale), qRound((cell->y() + 8) * scale));
+            const QRgb expectedRight = cell->width() > 12 ? 0xff0000 : 0xffffff;
+            if ((content.pixel(left) & 0xffffff) != 0xff0000
+                    || (content.pixel(right) & 0xffffff) != expectedRight) {
+                return QStringLiteral("frame %1: wrong contents at cell %2,%3")
+                        .arg(frame).arg(cell->x()).arg(cell->y());
+            }
+        }
+        return QString();
+    };
+
+    QString failure = verifyCells(0);
+    QVERIFY2(failure.isEmpty(), qPrintable(failure));
+
+    // Change the geometry of one rectangle per frame, at different places in the
+    // batch, long enough for its vertex buffer to become dynamic. The second half
+    // undoes the changes of the first half.
+    for (int frame = 1; frame <= 16; ++frame) {
+        QQuickItem *cell = cells.at(((frame - 1) % 8) * 53);
+        cell->setWidth(cell->width() > 12 ? 8 : 16);
+        failure = verifyCells(frame);
+        QVERIFY2(failure.isEmpty(), qPrintable(failure));
+    }
+}
+
 #if QT_CONFIG(opengl)
 // Testcase for QTBUG-34898. We make another context current on another surface
 // in the GUI thread and hide the QQuickWindow while the other context is
@@ -777,6 +1038,61 @@ void tst_SceneGraph::resizeTextureFromImage()
     TestOffscreenScene::cleanup();
 }
 
+void tst_SceneGraph::releaseAtlasPages()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping test due to not running with QRhi");
+
+    // The atlas is only touched on the thread of the scene graph, so use the
+    // offscreen infrastructure, as above.
+    {
+        QScopedPointer<TestOffscreenScene> scene(createOffscreenScene(testFileUrl(QLatin1String("renderControl_rect.qml"))));
+        QVERIFY(scene->renderControl && scene->window && scene->rootItem);
+
+        auto *rc = static_cast<QSGDefaultRenderContext *>(QQuickWindowPrivate::get(scene->window)->context);
+        QSGRhiAtlasTexture::Manager *atlas = rc->atlasManager();
+        QVERIFY(atlas);
+        QCOMPARE(atlas->pageCount(), 0);
+
+        // Only a handful of these fit into one page.
+        const int side = qMin(atlas->atlasSize().width(), atlas->atlasSize().height()) / 2 - 8;
+        QImage image(side, side, QImage::Format_RGB32);
+        image.fill(Qt::red);
+
+        ScopedList<QSGTexture *> firstPage;
+        ScopedList<QSGTexture *> secondPage;
+        while (atlas->pageCount() < 2) {
+            QSGTexture *texture = scene->window->createTextureFromImage(image, QQuickWindow::TextureCanUseAtlas);
+            QVERIFY(texture);
+            QVERIFY(texture->isAtlasTexture());
+            if (atlas->pageCount() < 2)
+                firstPage.append(texture);
+            else
+                secondPage.append(texture);
+            QVERIFY(firstPage.size() < 64);
+        }
+        secondPage.append(scene->window->createTextureFromImage(image, QQuickWindow::TextureCanUseAtlas));
+        QVERIFY(secondPage.last()->isAtlasTexture());
+        QCOMPARE(atlas->pageCount(), 2);
+
+        // The first page is kept, even when it is empty.
+        delete firstPage.takeLast();
+        QCOMPARE(atlas->pageCount(), 2);
+        qDeleteAll(firstPage);
+        firstPage.clear();
+        QCOMPARE(atlas->pageCount(), 2);
+
+        // The second page goes away together with its last texture.
+        delete secondPage.takeFirst();
+        QCOMPARE(atlas->pageCount(), 2);
+        qDeleteAll(secondPage);
+        secondPage.clear();
+        QCOMPARE(atlas->pageCount(), 1);
+    }
+
+    TestOffscreenScene::cleanup();
+}
+
 bool tst_SceneGraph::isRunningOnRhi()
 {
     static bool retval = false;
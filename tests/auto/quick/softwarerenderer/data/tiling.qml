@@ -0,0 +1,66 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 300
+    height: 300
+    color: "white"
+
+    // Overlapping, translucent and rounded rectangles that cross the tile edges.
+    Repeater {
+        model: 6
+        Rectangle {
+            x: 20 + index * 41
+            y: 30 + index * 23
+            width: 90
+            height: 70
+            radius: index * 4
+            border.width: index % 3
+            border.color: "black"
+            color: Qt.rgba(index / 6, 0.4, 1 - index / 6, 0.6)
+            rotation: index * 7
+        }
+    }
+
+    Item {
+        x: 50
+        y: 170
+        width: 120
+        height: 90
+        clip: true
+        Rectangle {
+            x: -30
+            y: 20
+            width: 200
+            height: 40
+            color: "orange"
+        }
+        Text {
+            x: -10
+            y: 50
+            text: "Clipped text crossing tiles"
+            font.pixelSize: 18
+        }
+    }
+
+    Text {
+        x: 10
+        y: 250
+        width: 280
+        wrapMode: Text.WordWrap
+        text: "Some text painted over several tiles, with glyphs split by their edges."
+        font.pixelSize: 15
+    }
+
+    Rectangle {
+        objectName: "mover"
+        x: 200
+        y: 120
+        width: 50
+        height: 50
+        radius: 10
+        color: "#8000ff00"
+    }
+}
@@ -4,6 +4,7 @@
 #include <QtQuick>
 #include <QtQml>
 #include <QGuiApplication>
+#include <QScopeGuard>
 
 #include <private/qsgrenderloop_p.h>
 
@@ -22,6 +23,7 @@ private slots:
     void initTestCase() override;
 
     void renderTarget();
+    void tiledRendering();
 };
 
 tst_SoftwareRenderer::tst_SoftwareRenderer()
@@ -93,6 +95,71 @@ void tst_SoftwareRenderer::renderTarget()
              qPrintable(errorMessage));
 }
 
+static QList<QImage> renderTiling(const QUrl &url, const QByteArray &tileSize)
+{
+    // Read when the renderer is created.
+    qputenv("QSG_SOFTWARE_RENDERER_TILE_SIZE", tileSize);
+    const auto restoreEnvironment = qScopeGuard([] { qunsetenv("QSG_SOFTWARE_RENDERER_TILE_SIZE"); });
+
+    QQuickRenderControl rc;
+    QScopedPointer<QQuickWindow> window(new QQuickWindow(&rc));
+    QQmlEngine engine;
+    QQmlComponent component(&engine, url);
+    QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+    if (!root)
+        return {};
+    root->setParentItem(window->contentItem());
+    window->resize(root->size().toSize());
+
+    QImage target(window->size(), QImage::Format_ARGB32_Premultiplied);
+    target.fill(Qt::transparent);
+    window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&target));
+
+    QList<QImage> frames;
+    const auto renderFrame = [&]() {
+        rc.polishItems();
+        rc.beginFrame();
+        rc.sync();
+        rc.render();
+        rc.endFrame();
+        frames.append(target.copy());
+    };
+
+    renderFrame();
+    // Only the area the rectangle moves over is repainted in the next frame.
+    QQuickItem *mover = root->findChild<QQuickItem *>(QLatin1String("mover"));
+    if (!mover)
+        return {};
+    mover->setPosition(QPointF(97, 61));
+    renderFrame();
+    return frames;
+}
+
+void tst_SoftwareRenderer::tiledRendering()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    const QList<QImage> single = renderTiling(testFileUrl("tiling.qml"), "0");
+    const QList<QImage> tiled = renderTiling(testFileUrl("tiling.qml"), "64");
+    QCOMPARE(single.size(), 2);
+    QCOMPARE(tiled.size(), 2);
+
+    for (int frame = 0; frame < single.size(); ++frame) {
+        QCOMPARE(tiled.at(frame).size(), single.at(frame).size());
+        for (int y = 0; y < single.at(frame).height(); ++y) {
+            for (int x = 0; x < single.at(frame).width(); ++x) {
+                if (tiled.at(frame).pixel(x, y) != single.at(frame).pixel(x, y)) {
+                    QFAIL(qPrintable(QString::fromLatin1("Frame %1 differs at %2, %3: %4 != %5")
+                                     .arg(frame).arg(x).arg(y)
+                                     .arg(tiled.at(frame).pixel(x, y), 8, 16, QLatin1Char('0'))
+                                     .arg(single.at(frame).pixel(x, y), 8, 16, QLatin1Char('0'))));
+                }
+            }
+        }
+    }
+}
+
 #include "tst_softwarerenderer.moc"
 
 QTEST_MAIN(tst_SoftwareRenderer)
@@ -4,8 +4,45 @@
 #include <qtest.h>
 
 #include <QDebug>
+#include <QAbstractListModel>
+#include <QQmlComponent>
+#include <QQmlEngine>
 
 #include <private/qqmlchangeset_p.h>
+#include <private/qqmldelegatemodel_p.h>
+#include <private/qqmllistcompositor_p.h>
+
+// A model that receives its rows in batches, as from a streaming source.
+class StreamingModel : public QAbstractListModel
+{
+public:
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_count;
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        return role == Qt::DisplayRole ? QVariant(index.row()) : QVariant();
+    }
+
+    void insertBatch(int row, int count)
+    {
+        beginInsertRows(QModelIndex(), row, row + count - 1);
+        m_count += count;
+        endInsertRows();
+    }
+
+    void clear()
+    {
+        beginResetModel();
+        m_count = 0;
+        endResetModel();
+    }
+
+private:
+    int m_count = 0;
+};
 
 class tst_qqmlchangeset : public QObject
 {
@@ -13,6 +50,13 @@ class tst_qqmlchangeset : public QObject
 
 private slots:
     void move();
+    void streamingInserts_data();
+    void streamingInserts();
+    void applyChangeSet();
+    void delegateModelStreamingInserts_data();
+    void delegateModelStreamingInserts();
+    void compositorStreamingInserts_data();
+    void compositorStreamingInserts();
 };
 
 void tst_qqmlchangeset::move()
@@ -26,5 +70,147 @@ void tst_qqmlchangeset::move()
     }
 }
 
+void tst_qqmlchangeset::streamingInserts_data()
+{
+    QTest::addColumn<int>("stride");
+
+    // Where each batch of rows arrives, relative to the end of the previous one.
+    QTest::newRow("append") << 0;
+    QTest::newRow("prepend") << -1;
+    QTest::newRow("fragmented") << 7;
+}
+
+// A model that receives rows in many small batches between two frames of a view
+// that coalesces them into one change set.
+void tst_qqmlchangeset::streamingInserts()
+{
+    QFETCH(int, stride);
+
+    const int batches = 1000;
+    const int batchSize = 100;
+
+    QBENCHMARK {
+        QQmlChangeSet set;
+        int count = 0;
+        for (int i = 0; i < batches; ++i) {
+            int index = count;
+            if (stride < 0)
+                index = 0;
+            else if (stride > 0)
+                index = (i * stride * batchSize) % (count + 1);
+            set.insert(index, batchSize);
+            count += batchSize;
+        }
+    }
+}
+
+void tst_qqmlchangeset::applyChangeSet()
+{
+    QQmlChangeSet batch;
+    for (int i = 0; i < 1000; ++i)
+        batch.insert(i * 3, 2);
+
+    QBENCHMARK {
+        QQmlChangeSet set;
+        for (int i = 0; i < 100; ++i)
+            set.apply(batch);
+    }
+}
+
+void tst_qqmlchangeset::delegateModelStreamingInserts_data()
+{
+    QTest::addColumn<bool>("coalesce");
+    QTest::addColumn<int>("stride");
+
+    QTest::newRow("append") << false << 0;
+    QTest::newRow("append, coalesced") << true << 0;
+    QTest::newRow("fragmented") << false << 7;
+    QTest::newRow("fragmented, coalesced") << true << 7;
+}
+
+// 10000 rows arriving in 100 rowsInserted() signals, through the delegate model
+// that a view would own, up to the change sets that the view would apply.
+void tst_qqmlchangeset::delegateModelStreamingInserts()
+{
+    QFETCH(bool, coalesce);
+    QFETCH(int, stride);
+
+    const int batches = 100;
+    const int batchSize = 100;
+
+    QQmlEngine engine;
+    QQmlComponent delegate(&engine);
+    delegate.setData("import QtQml; QtObject {}", QUrl());
+    QVERIFY(delegate.isReady());
+
+    StreamingModel model;
+    QQmlDelegateModel delegateModel(engine.rootContext());
+    delegateModel.setCoalesceChanges(coalesce);
+    delegateModel.setModel(QVariant::fromValue<QObject *>(&model));
+    delegateModel.setDelegate(&delegate);
+    delegateModel.componentComplete();
+
+    int changeSets = 0;
+    connect(&delegateModel, &QQmlInstanceModel::modelUpdated, this,
+            [&changeSets](const QQmlChangeSet &changeSet, bool) {
+        if (!changeSet.isEmpty())
+            ++changeSets;
+    });
+
+    QBENCHMARK {
+        model.clear();
+        changeSets = 0;
+        for (int i = 0; i < batches; ++i) {
+            const int count = i * batchSize;
+            model.insertBatch(stride > 0 ? (i * stride * batchSize) % (count + 1) : count, batchSize);
+        }
+        delegateModel.flushChanges();
+    }
+
+    QCOMPARE(delegateModel.count(), batches * batchSize);
+    QCOMPARE(changeSets, coalesce ? 1 : batches);
+}
+
+void tst_qqmlchangeset::compositorStreamingInserts_data()
+{
+    QTest::addColumn<int>("fragment");
+    QTest::addColumn<int>("batches");
+
+    // How often a row is a member of a second group, splitting the compositor into ranges.
+    QTest::newRow("contiguous") << 0 << 100;
+    QTest::newRow("contiguous, coalesced") << 0 << 1;
+    QTest::newRow("every 20th") << 20 << 100;
+    QTest::newRow("every 20th, coalesced") << 20 << 1;
+    QTest::newRow("every 2nd") << 2 << 100;
+    QTest::newRow("every 2nd, coalesced") << 2 << 1;
+}
+
+// The compositor walks every range of a list for each source insertion, so the cost of
+// a signal depends on how fragmented the groups are rather than on the number of rows.
+void tst_qqmlchangeset::compositorStreamingInserts()
+{
+    QFETCH(int, fragment);
+    QFETCH(int, batches);
+
+    const int rows = 10000;
+    const int batchSize = rows / batches;
+    int list = 0;
+
+    QBENCHMARK {
+        QQmlListCompositor compositor;
+        compositor.setGroupCount(4);
+        compositor.setDefaultGroups(QQmlListCompositor::DefaultFlag);
+        compositor.append(&list, 0, rows, QQmlListCompositor::DefaultFlag
+                | QQmlListCompositor::AppendFlag | QQmlListCompositor::PrependFlag);
+        for (int i = 0; fragment > 0 && i < rows; i += fragment)
+            compositor.setFlags(QQmlListCompositor::Default, i, 1, 1 << 3);
+
+        for (int i = 0; i < batches; ++i) {
+            QVector<QQmlListCompositor::Insert> inserts;
+            compositor.listItemsInserted(&list, rows + i * batchSize, batchSize, &inserts);
+        }
+    }
+}
+
 QTEST_MAIN(tst_qqmlchangeset)
 #include "tst_qqmlchangeset.moc"
@@ -0,0 +1,176 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlPropertyMap>
+
+class tst_qqmlpropertymap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertNew_data();
+    void insertNew();
+    void insertBulkNew_data();
+    void insertBulkNew();
+    void updateExisting_data();
+    void updateExisting();
+    void lookup_data();
+    void lookup();
+    void bindingUpdates_data();
+    void bindingUpdates();
+
+private:
+    static QVariantHash makeValues(int count, int offset = 0);
+    void addCountRows();
+};
+
+QVariantHash tst_qqmlpropertymap::makeValues(int count, int offset)
+{
+    QVariantHash values;
+    values.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString key = QLatin1String("key") + QString::number(i);
+        switch (i % 3) {
+        case 0: values.insert(key, i + offset); break;
+        case 1: values.insert(key, (i + offset) * 0.5); break;
+        default: values.insert(key, QString::number(i + offset)); break;
+        }
+    }
+    return values;
+}
+
+void tst_qqmlpropertymap::addCountRows()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void tst_qqmlpropertymap::insertNew_data()
+{
+    addCountRows();
+}
+
+void tst_qqmlpropertymap::insertNew()
+{
+    QFETCH(int, count);
+    const QVariantHash values = makeValues(count);
+
+    QBENCHMARK {
+        QQmlPropertyMap map;
+        for (auto it = values.cbegin(), end = values.cend(); it != end; ++it)
+            map.insert(it.key(), it.value());
+    }
+}
+
+void tst_qqmlpropertymap::insertBulkNew_data()
+{
+    addCountRows();
+}
+
+void tst_qqmlpropertymap::insertBulkNew()
+{
+    QFETCH(int, count);
+    const QVariantHash values = makeValues(count);
+
+    QBENCHMARK {
+        QQmlPropertyMap map;
+        map.insert(values);
+    }
+}
+
+void tst_qqmlpropertymap::updateExisting_data()
+{
+    addCountRows();
+}
+
+void tst_qqmlpropertymap::updateExisting()
+{
+    QFETCH(int, count);
+    const QVariantHash values[] = { makeValues(count), makeValues(count, 1) };
+
+    QQmlPropertyMap map;
+    map.insert(values[0]);
+
+    int round = 0;
+    QBENCHMARK {
+        const QVariantHash &next = values[++round % 2];
+        for (auto it = next.cbegin(), end = next.cend(); it != end; ++it)
+            map.insert(it.key(), it.value());
+    }
+}
+
+void tst_qqmlpropertymap::lookup_data()
+{
+    addCountRows();
+}
+
+void tst_qqmlpropertymap::lookup()
+{
+    QFETCH(int, count);
+    const QVariantHash values = makeValues(count);
+    const QStringList keys = values.keys();
+
+    QQmlPropertyMap map;
+    map.insert(values);
+
+    QBENCHMARK {
+        for (const QString &key : keys) {
+            if (!map.contains(key))
+                QFAIL("missing key");
+            map.value(key);
+        }
+    }
+}
+
+void tst_qqmlpropertymap::bindingUpdates_data()
+{
+    QTest::addColumn<bool>("coalesced");
+
+    QTest::newRow("immediate") << false;
+    QTest::newRow("coalesced") << true;
+}
+
+void tst_qqmlpropertymap::bindingUpdates()
+{
+    QFETCH(bool, coalesced);
+
+    const int count = 100;
+    QQmlPropertyMap map;
+    map.insert(makeValues(count));
+    map.setNotificationsCoalesced(coalesced);
+
+    QByteArray source = "import QtQml\nQtObject {\n";
+    for (int i = 0; i < count; ++i)
+        source += "    property var p" + QByteArray::number(i) + ": map.key" + QByteArray::number(i) + "\n";
+    source += "}\n";
+
+    QQmlEngine engine;
+    engine.rootContext()->setContextProperty(QLatin1String("map"), &map);
+    QQmlComponent component(&engine);
+    component.setData(source, QUrl());
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(object);
+
+    QList<QVariantHash> updates;
+    for (int update = 0; update < 11; ++update)
+        updates.append(makeValues(count, update));
+
+    // Simulate a data feed that updates every value several times per frame.
+    int round = 0;
+    QBENCHMARK {
+        for (int update = 0; update < 10; ++update)
+            map.insert(updates.at(++round % updates.size()));
+        QCoreApplication::processEvents();
+    }
+}
+
+QTEST_MAIN(tst_qqmlpropertymap)
+#include "tst_qqmlpropertymap.moc"
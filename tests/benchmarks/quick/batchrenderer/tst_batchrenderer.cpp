@@ -0,0 +1,107 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQuick/qquickitem.h>
+#include <QtQuick/qquickwindow.h>
+#include <QtQuick/qsgrectanglenode.h>
+
+// A single item that owns a large number of rectangle nodes and moves all of them every frame,
+// so that every batch has to be merged and uploaded again.
+class DenseScene : public QQuickItem
+{
+public:
+    DenseScene(int count)
+        : m_count(count)
+    {
+        setFlag(ItemHasContents);
+    }
+
+    void advance()
+    {
+        ++m_frame;
+        update();
+    }
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *) override
+    {
+        static const QColor colors[] = {
+            Qt::red, Qt::green, Qt::blue, Qt::cyan,
+            Qt::magenta, Qt::yellow, Qt::gray, Qt::darkRed
+        };
+        const int colorCount = int(sizeof(colors) / sizeof(colors[0]));
+
+        if (!node) {
+            node = new QSGNode;
+            for (int i = 0; i < m_count; ++i) {
+                QSGRectangleNode *rect = window()->createRectangleNode();
+                rect->setColor(colors[i % colorCount]);
+                node->appendChildNode(rect);
+            }
+        }
+
+        const int columns = 200;
+        int i = 0;
+        for (QSGNode *child = node->firstChild(); child; child = child->nextSibling(), ++i) {
+            const qreal offset = (i + m_frame) % 7;
+            static_cast<QSGRectangleNode *>(child)->setRect(
+                        (i % columns) * 4 + offset, (i / columns) * 4 + offset, 3, 3);
+        }
+        return node;
+    }
+
+private:
+    int m_count;
+    int m_frame = 0;
+};
+
+class tst_batchrenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void render_data();
+    void render();
+};
+
+void tst_batchrenderer::initTestCase()
+{
+    // Measure the renderer itself rather than the graphics driver.
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+}
+
+void tst_batchrenderer::render_data()
+{
+    QTest::addColumn<QByteArray>("uploadThreshold");
+
+    QTest::newRow("serial") << QByteArray("0");
+    QTest::newRow("parallel") << QByteArray("1");
+}
+
+void tst_batchrenderer::render()
+{
+    QFETCH(QByteArray, uploadThreshold);
+
+    // The renderer reads the threshold when it is created for the window.
+    qputenv("QSG_RENDERER_PARALLEL_UPLOAD_THRESHOLD", uploadThreshold);
+
+    QQuickWindow window;
+    window.resize(800, 400);
+    DenseScene *scene = new DenseScene(20000);
+    scene->setSize(window.size());
+    scene->setParentItem(window.contentItem());
+
+    window.grabWindow();
+
+    QBENCHMARK {
+        scene->advance();
+        window.grabWindow();
+    }
+
+    qunsetenv("QSG_RENDERER_PARALLEL_UPLOAD_THRESHOLD");
+}
+
+QTEST_MAIN(tst_batchrenderer)
+#include "tst_batchrenderer.moc"
@@ -0,0 +1,17 @@
+import QtQuick
+
+Rectangle {
+    width: 800
+    height: 800
+    color: "white"
+
+    property alias glyphs: text.text
+
+    Text {
+        id: text
+        anchors.fill: parent
+        font.pixelSize: 12
+        wrapMode: Text.WrapAnywhere
+        renderType: Text.QtRendering
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQuick/qquickview.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtTest/qsignalspy.h>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+// Measures the time until the first frame of a window showing many glyphs that have not been
+// rendered before. This is dominated by creating the distance fields for the glyph cache.
+class tst_distancefieldglyphs : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_distancefieldglyphs();
+
+private slots:
+    void firstFrame_data();
+    void firstFrame();
+
+private:
+    QString freshGlyphs(int count);
+
+    char16_t m_nextCharacter = 0x4e00;
+};
+
+tst_distancefieldglyphs::tst_distancefieldglyphs()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+// Glyph caches outlive the windows, so every row uses CJK ideographs no other row has used.
+QString tst_distancefieldglyphs::freshGlyphs(int count)
+{
+    QString glyphs;
+    glyphs.reserve(count);
+    for (int i = 0; i < count && m_nextCharacter < 0x9fff; ++i)
+        glyphs.append(QChar(m_nextCharacter++));
+    return glyphs;
+}
+
+void tst_distancefieldglyphs::firstFrame_data()
+{
+    QTest::addColumn<int>("glyphCount");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("5000") << 5000;
+}
+
+void tst_distancefieldglyphs::firstFrame()
+{
+    QFETCH(int, glyphCount);
+
+    const QString glyphs = freshGlyphs(glyphCount);
+    if (glyphs.size() < glyphCount)
+        QSKIP("Ran out of unused characters");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QQuickView view;
+    QSignalSpy frameSwapped(&view, &QQuickWindow::frameSwapped);
+    view.setInitialProperties({ { QStringLiteral("glyphs"), glyphs } });
+    view.setSource(testFileUrl("glyphs.qml"));
+    QVERIFY(view.rootObject());
+    view.show();
+    QVERIFY(frameSwapped.wait(60000));
+
+    QTest::setBenchmarkResult(timer.elapsed(), QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_distancefieldglyphs)
+#include "tst_distancefieldglyphs.moc"
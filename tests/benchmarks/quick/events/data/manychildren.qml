@@ -0,0 +1,29 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+import QtQuick
+
+// 10000 markers on a map, all children of the same item
+Item {
+    width: 800
+    height: 800
+
+    Repeater {
+        model: 10000
+
+        Rectangle {
+            required property int index
+            x: index % 100 * 8
+            y: Math.floor(index / 100) * 8
+            width: 6
+            height: 6
+            color: mouseArea.containsMouse ? "red" : "steelblue"
+
+            MouseArea {
+                id: mouseArea
+                objectName: "mouseArea" + parent.index
+                anchors.fill: parent
+                hoverEnabled: true
+            }
+        }
+    }
+}
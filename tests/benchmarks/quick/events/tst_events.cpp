@@ -27,6 +27,8 @@ private slots:
     void mouseMove();
     void touchToMousePressRelease();
     void touchToMousePressMove();
+    void mouseHoverManyChildren();
+    void mousePressReleaseManyChildren();
 
 public slots:
     void initTestCase() override {
@@ -127,5 +129,53 @@ void tst_events::touchToMousePressMove()
     QCOMPARE(mouseArea->pressed(), false);
 }
 
+void tst_events::mouseHoverManyChildren()
+{
+    TestView view;
+    view.setSource(testFileUrl("manychildren.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QQuickMouseArea *mouseArea1 = view.rootObject()->findChild<QQuickMouseArea *>("mouseArea5050");
+    QQuickMouseArea *mouseArea2 = view.rootObject()->findChild<QQuickMouseArea *>("mouseArea5051");
+    QVERIFY(mouseArea1);
+    QVERIFY(mouseArea2);
+
+    const QPoint localPos1(403, 403);
+    const QPoint globalPos1 = view.mapToGlobal(localPos1);
+    const QPoint localPos2(411, 403);
+    const QPoint globalPos2 = view.mapToGlobal(localPos2);
+    QMouseEvent moveEvent1(QEvent::MouseMove, localPos1, globalPos1, Qt::NoButton, Qt::NoButton, {});
+    QMouseEvent moveEvent2(QEvent::MouseMove, localPos2, globalPos2, Qt::NoButton, Qt::NoButton, {});
+    QBENCHMARK {
+        view.handleEvent(&moveEvent1);
+        QVERIFY(mouseArea1->hovered());
+        view.handleEvent(&moveEvent2);
+        QVERIFY(mouseArea2->hovered());
+    }
+}
+
+void tst_events::mousePressReleaseManyChildren()
+{
+    TestView view;
+    view.setSource(testFileUrl("manychildren.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QQuickMouseArea *mouseArea = view.rootObject()->findChild<QQuickMouseArea *>("mouseArea5050");
+    QVERIFY(mouseArea);
+
+    const QPoint localPos(403, 403);
+    const QPoint globalPos = view.mapToGlobal(localPos);
+    QBENCHMARK {
+        QMouseEvent pressEvent(QEvent::MouseButtonPress, localPos, globalPos, Qt::LeftButton, Qt::LeftButton, {});
+        view.handleEvent(&pressEvent);
+        QCOMPARE(mouseArea->pressed(), true);
+        QMouseEvent releaseEvent(QEvent::MouseButtonRelease, localPos, globalPos, Qt::LeftButton, Qt::LeftButton, {});
+        view.handleEvent(&releaseEvent);
+    }
+    QCOMPARE(mouseArea->pressed(), false);
+}
+
 QTEST_MAIN(tst_events)
 #include "tst_events.moc"
@@ -0,0 +1,28 @@
+import QtQuick
+
+GridView {
+    id: grid
+    width: 800
+    height: 800
+    cellWidth: 100
+    cellHeight: 100
+    // instantiate every delegate, the ones outside the window are loaded last
+    cacheBuffer: 100000
+
+    property var sources: []
+    property int finishedCount: 0
+
+    model: sources
+    delegate: Image {
+        width: 96
+        height: 96
+        asynchronous: true
+        cache: false
+        sourceSize: Qt.size(96, 96)
+        source: modelData
+        onStatusChanged: {
+            if (status === Image.Ready || status === Image.Error)
+                ++grid.finishedCount
+        }
+    }
+}
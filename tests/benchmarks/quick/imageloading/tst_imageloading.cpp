@@ -0,0 +1,95 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQuick/qquickview.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qthread.h>
+#include <QtGui/qimage.h>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+// Measures the time until every thumbnail of a grid of asynchronously loaded images has been
+// decoded, for different numbers of image decoder threads.
+class tst_imageloading : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_imageloading();
+
+private slots:
+    void initTestCase() override;
+    void cleanup();
+    void thumbnailGrid_data();
+    void thumbnailGrid();
+
+private:
+    QTemporaryDir m_imageDir;
+    QStringList m_sources;
+};
+
+tst_imageloading::tst_imageloading()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_imageloading::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+    QVERIFY(m_imageDir.isValid());
+
+    // Noise does not compress well, so decoding costs about as much as for a photo.
+    QRandomGenerator random(42);
+    QImage image(1024, 768, QImage::Format_RGB32);
+    for (int i = 0; i < 200; ++i) {
+        for (int y = 0; y < image.height(); ++y) {
+            QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x)
+                line[x] = random.generate() | 0xff000000;
+        }
+        const QString path = m_imageDir.filePath(QStringLiteral("image%1.jpg").arg(i));
+        QVERIFY(image.save(path, "JPG", 90));
+        m_sources.append(QUrl::fromLocalFile(path).toString());
+    }
+}
+
+void tst_imageloading::cleanup()
+{
+    qunsetenv("QML_IMAGE_DECODER_THREADS");
+}
+
+void tst_imageloading::thumbnailGrid_data()
+{
+    QTest::addColumn<int>("decoderThreads");
+
+    QTest::newRow("reader thread") << 0;
+    QTest::newRow("1 decoder") << 1;
+    QTest::newRow("4 decoders") << 4;
+    QTest::newRow("ideal") << QThread::idealThreadCount();
+}
+
+void tst_imageloading::thumbnailGrid()
+{
+    QFETCH(int, decoderThreads);
+
+    // Read when the view's engine creates its pixmap reader.
+    qputenv("QML_IMAGE_DECODER_THREADS", QByteArray::number(decoderThreads));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QQuickView view;
+    view.setInitialProperties({ { QStringLiteral("sources"), m_sources } });
+    view.setSource(testFileUrl("thumbnails.qml"));
+    QObject *grid = view.rootObject();
+    QVERIFY(grid);
+    view.show();
+    QTRY_COMPARE_WITH_TIMEOUT(grid->property("finishedCount").toInt(), m_sources.size(), 60000);
+
+    QTest::setBenchmarkResult(timer.elapsed(), QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(tst_imageloading)
+#include "tst_imageloading.moc"
@@ -0,0 +1,64 @@
+import QtQuick
+
+Item {
+    id: root
+    width: 800; height: 600
+
+    property var model
+    property int prefetchLines
+    readonly property TableView tableView: loader.item
+
+    // Incubates the table, and with it the delegate items of the first
+    // frame, asynchronously, the way applications load heavy views.
+    Loader {
+        id: loader
+        anchors.fill: parent
+        asynchronous: true
+        active: false
+
+        sourceComponent: TableView {
+            clip: true
+            columnSpacing: 1
+            rowSpacing: 1
+            model: root.model
+            prefetchLines: root.prefetchLines
+
+            delegate: Rectangle {
+                required property int row
+                required property string display
+                // The content of the cell is incubated asynchronously, also
+                // for the cells that the view creates while it is flicked.
+                readonly property bool ready: content.status === Loader.Ready
+
+                implicitWidth: 90
+                implicitHeight: 24
+                color: row % 2 ? "#f4f4f4" : "white"
+
+                Loader {
+                    id: content
+                    anchors.fill: parent
+                    asynchronous: true
+
+                    sourceComponent: Item {
+                        Text {
+                            anchors.left: parent.left
+                            anchors.leftMargin: 4
+                            anchors.verticalCenter: parent.verticalCenter
+                            text: display
+                        }
+                        Text {
+                            anchors.right: parent.right
+                            anchors.rightMargin: 4
+                            anchors.verticalCenter: parent.verticalCenter
+                            font.pixelSize: 9
+                            text: (row % 3 ? "+" : "-") + (row % 100) / 100 + "%"
+                            color: row % 3 ? "green" : "red"
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    function load() { loader.active = true }
+}
@@ -0,0 +1,123 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/qabstractitemmodel.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/private/qquicktableview_p.h>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+class PriceModel : public QAbstractTableModel
+{
+public:
+    int rowCount(const QModelIndex & = QModelIndex()) const override { return 1000; }
+    int columnCount(const QModelIndex & = QModelIndex()) const override { return 200; }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (!index.isValid() || role != Qt::DisplayRole)
+            return QVariant();
+        return QString::number((index.row() * 7919 + index.column() * 104729) % 100000 / 100.0, 'f', 2);
+    }
+
+    QHash<int, QByteArray> roleNames() const override
+    {
+        return { { Qt::DisplayRole, "display" } };
+    }
+};
+
+// Flicks through a table of 200 columns at a steady speed, and counts the frames
+// in which part of the viewport is not covered by cells with their content,
+// because it was still being incubated.
+class tst_tableview : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_tableview();
+
+private slots:
+    void blankFrames_data();
+    void blankFrames();
+};
+
+tst_tableview::tst_tableview()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_tableview::blankFrames_data()
+{
+    QTest::addColumn<int>("prefetchLines");
+
+    QTest::newRow("no prefetch") << 0;
+    QTest::newRow("prefetch 3 lines") << 3;
+}
+
+void tst_tableview::blankFrames()
+{
+    QFETCH(int, prefetchLines);
+
+    PriceModel model;
+    QQuickView view;
+    view.setSource(testFileUrl("tableview.qml"));
+    QQuickItem *root = view.rootObject();
+    QVERIFY(root);
+    root->setProperty("prefetchLines", prefetchLines);
+    root->setProperty("model", QVariant::fromValue<QObject *>(&model));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    // TableView only incubates its delegate items asynchronously when it is
+    // itself being incubated asynchronously, so load it through a Loader.
+    QVERIFY(QMetaObject::invokeMethod(root, "load"));
+    QTRY_VERIFY(root->property("tableView").value<QQuickTableView *>());
+    auto *tableView = root->property("tableView").value<QQuickTableView *>();
+
+    // Every cell that is at least partly inside the viewport needs its delegate item,
+    // with the content it loads.
+    const auto isCovered = [tableView]() {
+        const QPointF topLeft(tableView->contentX(), tableView->contentY());
+        const QPointF bottomRight = topLeft + QPointF(tableView->width() - 1, tableView->height() - 1);
+        const QPoint topLeftCell = tableView->cellAtPosition(topLeft, true);
+        const QPoint bottomRightCell = tableView->cellAtPosition(bottomRight, true);
+        if (topLeftCell == QPoint(-1, -1) || bottomRightCell == QPoint(-1, -1))
+            return false;
+        for (int row = topLeftCell.y(); row <= bottomRightCell.y(); ++row) {
+            for (int column = topLeftCell.x(); column <= bottomRightCell.x(); ++column) {
+                const QQuickItem *item = tableView->itemAtCell(column, row);
+                if (!item || !item->property("ready").toBool())
+                    return false;
+            }
+        }
+        return true;
+    };
+    QTRY_VERIFY_WITH_TIMEOUT(isCovered(), 10000);
+
+    // About 3600 pixels per second at 60 frames per second. Each frame checks what
+    // the previous one rendered, and then moves the viewport along.
+    const qreal step = 60;
+    int blankFrames = 0;
+    bool done = false;
+    connect(&view, &QQuickWindow::afterAnimating, tableView, [&]() {
+        if (done)
+            return;
+        if (!isCovered())
+            ++blankFrames;
+        const qreal maxContentX = tableView->contentWidth() - tableView->width();
+        const qreal contentX = tableView->contentX();
+        if (contentX >= maxContentX) {
+            done = true;
+            return;
+        }
+        tableView->setContentX(qMin(contentX + step, maxContentX));
+        view.update();
+    });
+    view.update();
+    QTRY_VERIFY_WITH_TIMEOUT(done, 60000);
+
+    QTest::setBenchmarkResult(blankFrames, QTest::Events);
+}
+
+QTEST_MAIN(tst_tableview)
+#include "tst_tableview.moc"
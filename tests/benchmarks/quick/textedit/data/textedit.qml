@@ -0,0 +1,16 @@
+import QtQuick
+
+Flickable {
+    width: 640; height: 480
+    contentWidth: edit.width
+    contentHeight: edit.height
+    clip: true
+
+    property alias text: edit.text
+    property alias virtualized: edit.virtualized
+
+    TextEdit {
+        id: edit
+        readOnly: true
+    }
+}
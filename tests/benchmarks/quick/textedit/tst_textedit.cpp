@@ -0,0 +1,163 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtTest/qsignalspy.h>
+#include <QtQuick/qquickview.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#  include <malloc.h>
+#  define HAVE_MALLINFO2
+#endif
+
+// Measures the time it takes to open a large read-only plain text document in a TextEdit,
+// and to scroll through it, with and without virtualized layout, and how much memory the
+// document, its layout and the nodes take.
+class tst_textedit : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_textedit();
+
+private slots:
+    void initTestCase() override;
+    void open_data();
+    void open();
+    void scroll_data();
+    void scroll();
+
+private:
+    bool startMeasuring();
+    void stopMeasuring();
+
+    QString m_text;
+    QElapsedTimer m_timer;
+    qint64 m_heapBefore = 0;
+    bool m_memory = false;
+};
+
+// Bytes allocated on the heap by all threads, the render thread included.
+static qint64 heapInUse()
+{
+#ifdef HAVE_MALLINFO2
+    const struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+tst_textedit::tst_textedit()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_textedit::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+
+    // Something like a log file: about 10 MB in 200000 lines.
+    QStringList lines;
+    lines.reserve(200000);
+    for (int i = 0; i < 200000; ++i) {
+        lines << QStringLiteral("%1 [info] request %2 handled in %3 ms by worker %4, "
+                                "response size %5 bytes")
+                         .arg(i, 8, 10, QLatin1Char('0')).arg(i * 7).arg(i % 97)
+                         .arg(i % 8).arg(i * 13 % 65536);
+    }
+    m_text = lines.join(QLatin1Char('\n'));
+}
+
+bool tst_textedit::startMeasuring()
+{
+    QFETCH(bool, memory);
+    m_memory = memory;
+    if (m_memory) {
+        m_heapBefore = heapInUse();
+        if (m_heapBefore < 0)
+            return false;
+    } else {
+        m_timer.start();
+    }
+    return true;
+}
+
+void tst_textedit::stopMeasuring()
+{
+    if (m_memory)
+        QTest::setBenchmarkResult(heapInUse() - m_heapBefore, QTest::BytesAllocated);
+    else
+        QTest::setBenchmarkResult(m_timer.elapsed(), QTest::WalltimeMilliseconds);
+}
+
+void tst_textedit::open_data()
+{
+    QTest::addColumn<bool>("virtualized");
+    QTest::addColumn<bool>("memory");
+
+    QTest::newRow("regular") << false << false;
+    QTest::newRow("virtualized") << true << false;
+    QTest::newRow("regular, memory") << false << true;
+    QTest::newRow("virtualized, memory") << true << true;
+}
+
+// From setting the text until the first frame is on screen. The memory rows report the heap
+// that the document, its layout and the nodes of the first frame take.
+void tst_textedit::open()
+{
+    QFETCH(bool, virtualized);
+
+    QQuickView view;
+    view.setSource(testFileUrl("textedit.qml"));
+    QObject *flickable = view.rootObject();
+    QVERIFY(flickable);
+    flickable->setProperty("virtualized", virtualized);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    if (!startMeasuring())
+        QSKIP("Heap usage can only be measured with glibc");
+    flickable->setProperty("text", m_text);
+    QSignalSpy frameSwapped(&view, &QQuickWindow::frameSwapped);
+    QTRY_VERIFY_WITH_TIMEOUT(frameSwapped.size() > 0, 60000);
+    stopMeasuring();
+}
+
+void tst_textedit::scroll_data()
+{
+    open_data();
+}
+
+// Jumps through the document a page at a time, rendering a frame at each position. The memory
+// rows report how much the heap grew on the way, as blocks get laid out.
+void tst_textedit::scroll()
+{
+    QFETCH(bool, virtualized);
+
+    QQuickView view;
+    view.setSource(testFileUrl("textedit.qml"));
+    QObject *flickable = view.rootObject();
+    QVERIFY(flickable);
+    flickable->setProperty("virtualized", virtualized);
+    flickable->setProperty("text", m_text);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy frameSwapped(&view, &QQuickWindow::frameSwapped);
+    if (!startMeasuring())
+        QSKIP("Heap usage can only be measured with glibc");
+    const int pages = 100;
+    for (int i = 1; i <= pages; ++i) {
+        const qreal contentHeight = flickable->property("contentHeight").toReal();
+        const qreal height = flickable->property("height").toReal();
+        flickable->setProperty("contentY", (contentHeight - height) * i / pages);
+        QTRY_VERIFY_WITH_TIMEOUT(frameSwapped.size() >= i, 10000);
+    }
+    stopMeasuring();
+}
+
+QTEST_MAIN(tst_textedit)
+#include "tst_textedit.moc"
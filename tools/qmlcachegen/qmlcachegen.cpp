@@ -13,6 +13,10 @@
 #include <QScopeGuard>
 #include <QLibraryInfo>
 #include <QLoggingCategory>
+#include <QThread>
+#include <QThreadPool>
+#include <QMutex>
+#include <QCryptographicHash>
 
 #include <private/qqmlirbuilder_p.h>
 #include <private/qqmljsparser_p.h>
@@ -22,7 +26,11 @@
 #include <private/qqmljscompiler_p.h>
 #include <private/qresourcerelocater_p.h>
 
+#include "qmlcachegenbuildcache.h"
+
 #include <algorithm>
+#include <atomic>
+#include <memory>
 
 static bool argumentsFromCommandLineAndFile(QStringList& allArguments, const QStringList &arguments)
 {
@@ -53,6 +61,363 @@ static bool argumentsFromCommandLineAndFile(QStringList& allArguments, const QSt
     return true;
 }
 
+enum Output {
+    GenerateCpp,
+    GenerateCacheFile,
+    GenerateLoader,
+    GenerateLoaderStandAlone,
+};
+
+struct CompileOptions
+{
+    QStringList importPaths;
+    QStringList qmldirFiles;
+    QQmlJSResourceFileMapper *fileMapper = nullptr;
+    bool hasResourceFiles = false;
+    bool onlyBytecode = false;
+};
+
+struct CompileTask
+{
+    QString inputFile;
+    QString outputFileName;
+    QString inputResourcePath;
+};
+
+static Output outputTarget(const QString &outputFileName)
+{
+    if (outputFileName.endsWith(QLatin1String(".cpp"))) {
+        if (outputFileName.endsWith(QLatin1String("qmlcache_loader.cpp")))
+            return GenerateLoader;
+        return GenerateCpp;
+    }
+    return GenerateCacheFile;
+}
+
+static std::unique_ptr<QQmlJSImporter> createImporter(const CompileOptions &options)
+{
+    return std::make_unique<QQmlJSImporter>(
+                options.importPaths, options.hasResourceFiles ? options.fileMapper : nullptr);
+}
+
+// Determines the resource path of a file if the user didn't specify it, from the resource files.
+static bool resolveResourcePath(CompileTask *task, Output target, const CompileOptions &options,
+                                const QString &resourcePathOptionName, QString *errorMessage)
+{
+    if (!task->inputResourcePath.isEmpty())
+        return true;
+
+    const QStringList resourcePaths = options.fileMapper->resourcePaths(
+                QQmlJSResourceFileMapper::localFileFilter(task->inputFile));
+    if (target == GenerateCpp && resourcePaths.isEmpty()) {
+        *errorMessage = QStringLiteral("No resource path for file: %1\n").arg(task->inputFile);
+        return false;
+    }
+
+    if (resourcePaths.size() == 1) {
+        task->inputResourcePath = resourcePaths.first();
+    } else if (target == GenerateCpp) {
+        *errorMessage = QStringLiteral("Multiple resource paths for file %1. "
+                                       "Use the --%2 option to disambiguate:\n")
+                .arg(task->inputFile, resourcePathOptionName);
+        for (const QString &resourcePath: resourcePaths)
+            *errorMessage += QStringLiteral("\t%1\n").arg(resourcePath);
+        return false;
+    }
+    return true;
+}
+
+// Compiles a single QML or JS file. If an importer is given, it is used (and populated) for
+// resolving the types of the ahead-of-time compiled functions. This way multiple files can share
+// the work of reading qmldir and qmltypes files. If coverage is given, the number of compiled and
+// rejected functions is added to it.
+static bool compileFile(const CompileTask &task, const CompileOptions &options,
+                        QQmlJSImporter *sharedImporter, QQmlJSBytecodeCoverage *coverage,
+                        QQmlJSCompileError *error)
+{
+    const Output target = outputTarget(task.outputFileName);
+    const QString &inputFile = task.inputFile;
+    const QString &outputFileName = task.outputFileName;
+    const QString &inputResourcePath = task.inputResourcePath;
+    QString inputFileUrl = inputFile;
+
+    QQmlJSSaveFunction saveFunction;
+    if (target == GenerateCpp) {
+        inputFileUrl = QStringLiteral("qrc://") + inputResourcePath;
+        saveFunction = [inputResourcePath, outputFileName](
+                               const QV4::CompiledData::SaveableUnitPointer &unit,
+                               const QQmlJSAotFunctionMap &aotFunctions,
+                               QString *errorString) {
+            return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit, aotFunctions,
+                                       errorString);
+        };
+
+    } else {
+        saveFunction = [outputFileName](const QV4::CompiledData::SaveableUnitPointer &unit,
+                                        const QQmlJSAotFunctionMap &aotFunctions,
+                                        QString *errorString) {
+            Q_UNUSED(aotFunctions);
+            return unit.saveToDisk<char>(
+                    [&outputFileName, errorString](const char *data, quint32 size) {
+                        return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
+                                outputFileName, data, size, errorString);
+            });
+        };
+    }
+
+    if (inputFile.endsWith(QLatin1String(".qml"))) {
+        if (target != GenerateCpp || inputResourcePath.isEmpty() || options.onlyBytecode) {
+            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, error,
+                                 /* storeSourceLocation */ false)) {
+                *error = error->augment(QStringLiteral("Error compiling qml file: "));
+                return false;
+            }
+        } else {
+            std::unique_ptr<QQmlJSImporter> ownImporter;
+            QQmlJSImporter *importer = sharedImporter;
+            if (!importer) {
+                ownImporter = createImporter(options);
+                importer = ownImporter.get();
+            }
+
+            QQmlJSLogger logger;
+
+            // Always trigger the qFatal() on "pragma Strict" violations.
+            logger.setCategoryLevel(qmlCompiler, QtCriticalMsg);
+            logger.setCategoryIgnored(qmlCompiler, false);
+
+            // By default, we're completely silent,
+            // as the lcAotCompiler category default is QtFatalMsg
+            const bool loggingEnabled = lcAotCompiler().isDebugEnabled()
+                    || lcAotCompiler().isInfoEnabled() || lcAotCompiler().isWarningEnabled()
+                    || lcAotCompiler().isCriticalEnabled();
+            if (!loggingEnabled)
+                logger.setSilent(true);
+
+            QQmlJSAotCompiler cppCodeGen(
+                        importer, u':' + inputResourcePath, options.qmldirFiles, &logger);
+            cppCodeGen.setBytecodeCoverage(coverage);
+
+            if (!qCompileQmlFile(inputFile, saveFunction, &cppCodeGen, error,
+                                 /* storeSourceLocation */ true)) {
+                *error = error->augment(QStringLiteral("Error compiling qml file: "));
+                return false;
+            }
+
+            QList<QQmlJS::DiagnosticMessage> warnings = importer->takeGlobalWarnings();
+
+            if (!warnings.isEmpty()) {
+                logger.log(QStringLiteral("Type warnings occurred while compiling file:"),
+                           qmlImport, QQmlJS::SourceLocation());
+                logger.processMessages(warnings, qmlImport);
+            }
+        }
+    } else if (inputFile.endsWith(QLatin1String(".js")) || inputFile.endsWith(QLatin1String(".mjs"))) {
+        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, error)) {
+            *error = error->augment(QLatin1String("Error compiling js file: "));
+            return false;
+        }
+    } else {
+        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
+    }
+
+    return true;
+}
+
+/*
+    Reads a batch file. Each non-empty line describes one file to be compiled as tab-separated
+    input file, output file and, optionally, resource path.
+*/
+static bool readBatchFile(const QString &batchFile, QList<CompileTask> *tasks)
+{
+    QFile f(batchFile);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        fprintf(stderr, "Cannot open batch file %s\n", qPrintable(batchFile));
+        return false;
+    }
+
+    int lineNumber = 0;
+    while (!f.atEnd()) {
+        ++lineNumber;
+        const QString line = QString::fromLocal8Bit(f.readLine()).trimmed();
+        if (line.isEmpty())
+            continue;
+
+        const QStringList fields = line.split(QLatin1Char('\t'));
+        if (fields.size() < 2 || fields.size() > 3 || fields[0].isEmpty() || fields[1].isEmpty()) {
+            fprintf(stderr, "%s:%d: Expected <input>\\t<output>[\\t<resource path>]\n",
+                    qPrintable(batchFile), lineNumber);
+            return false;
+        }
+
+        tasks->append({ fields[0], fields[1], fields.size() > 2 ? fields[2] : QString() });
+    }
+    return true;
+}
+
+// Everything that influences the output of all files in a batch.
+static QByteArray batchGlobalKey(const CompileOptions &options, const QStringList &resourceFiles)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArrayView(QT_VERSION_STR));
+    hash.addData(QByteArrayView(QLibraryInfo::build()));
+    hash.addData(QFileInfo(QCoreApplication::applicationFilePath()).lastModified()
+                 .toString(Qt::ISODateWithMs).toUtf8());
+    const auto addList = [&](const QStringList &list) {
+        for (const QString &entry : list) {
+            hash.addData(entry.toUtf8());
+            hash.addData(QByteArrayView("\0", 1));
+        }
+        hash.addData(QByteArrayView("\1", 1));
+    };
+    addList(options.importPaths);
+    addList(options.qmldirFiles);
+    addList(resourceFiles);
+    for (const QString &resourceFile : resourceFiles)
+        hash.addData(QmlCacheGenBuildCache::hashFile(resourceFile));
+    hash.addData(QByteArrayView(options.onlyBytecode ? "1" : "0"));
+    return hash.result();
+}
+
+static bool writeBytecodeCoverage(const QString &fileName, const QQmlJSBytecodeCoverage &coverage)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(coverage.toJson()) < 0 || !file.commit()) {
+        fprintf(stderr, "Cannot write bytecode coverage to %s: %s\n",
+                qPrintable(fileName), qPrintable(file.errorString()));
+        return false;
+    }
+    return true;
+}
+
+/*
+    Compiles all files from the batch file in one process. The files are distributed over a number
+    of worker threads. Each worker keeps its own QQmlJSImporter, since the importer lazily
+    resolves types and isn't thread safe. The imports it has resolved are shared among all files
+    compiled by the same worker.
+
+    If a cache directory is given, files whose inputs, options and dependencies haven't changed
+    since the last run are skipped. Skipped files don't contribute to the bytecode coverage.
+*/
+static int compileBatch(const QString &batchFile, const CompileOptions &options,
+                        const QStringList &resourceFiles, const QString &resourcePathOptionName,
+                        int jobs, const QString &cacheDirectory, const QString &coverageFile)
+{
+    QList<CompileTask> tasks;
+    if (!readBatchFile(batchFile, &tasks))
+        return EXIT_FAILURE;
+
+    for (CompileTask &task : tasks) {
+        const Output target = outputTarget(task.outputFileName);
+        if (target == GenerateLoader) {
+            fprintf(stderr, "Cannot generate loaders in batch mode: %s\n",
+                    qPrintable(task.outputFileName));
+            return EXIT_FAILURE;
+        }
+
+        QString errorMessage;
+        if (!resolveResourcePath(&task, target, options, resourcePathOptionName, &errorMessage)) {
+            fprintf(stderr, "%s", qPrintable(errorMessage));
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::unique_ptr<QmlCacheGenBuildCache> cache;
+    if (!cacheDirectory.isEmpty()) {
+        cache = std::make_unique<QmlCacheGenBuildCache>(cacheDirectory);
+        cache->setGlobalKey(batchGlobalKey(options, resourceFiles));
+        cache->load();
+    }
+
+    struct TaskResult
+    {
+        QByteArray taskKey;
+        QQmlJSBytecodeCoverage coverage;
+        QQmlJSCompileError error;
+        bool skipped = false;
+        bool success = false;
+    };
+
+    QList<TaskResult> results(tasks.size());
+    std::atomic<qsizetype> nextTask = 0;
+    QMutex dependencyMutex;
+    QStringList dependencies;
+
+    const auto work = [&]() {
+        // Created on first use, so that workers that only see up to date files don't import.
+        std::unique_ptr<QQmlJSImporter> importer;
+        for (qsizetype i = nextTask++; i < tasks.size(); i = nextTask++) {
+            const CompileTask &task = tasks[i];
+            TaskResult &result = results[i];
+            if (cache) {
+                result.taskKey = cache->taskKey(
+                            task.inputFile, task.outputFileName, task.inputResourcePath);
+                if (cache->isUpToDate(task.outputFileName, result.taskKey)) {
+                    result.skipped = true;
+                    result.success = true;
+                    continue;
+                }
+            }
+
+            if (!importer)
+                importer = createImporter(options);
+            result.success = compileFile(task, options, importer.get(), &result.coverage,
+                                         &result.error);
+        }
+
+        if (importer) {
+            const QStringList workerDependencies = importer->dependencyFiles();
+            QMutexLocker locker(&dependencyMutex);
+            dependencies.append(workerDependencies);
+        }
+    };
+
+    const int numWorkers = qBound(1, jobs, int(qMax<qsizetype>(1, tasks.size())));
+    QThreadPool pool;
+    pool.setMaxThreadCount(numWorkers);
+    for (int i = 1; i < numWorkers; ++i)
+        pool.start(work);
+    work();
+    pool.waitForDone();
+
+    bool success = true;
+    QQmlJSBytecodeCoverage coverage;
+    for (qsizetype i = 0; i < tasks.size(); ++i) {
+        TaskResult &result = results[i];
+        coverage.merge(result.coverage);
+        if (!result.success) {
+            result.error.print();
+            success = false;
+        }
+        if (cache && !result.skipped) {
+            if (result.success)
+                cache->update(tasks[i].outputFileName, result.taskKey);
+            else
+                cache->remove(tasks[i].outputFileName);
+        }
+    }
+
+    if (!coverageFile.isEmpty() && !writeBytecodeCoverage(coverageFile, coverage))
+        return EXIT_FAILURE;
+
+    if (cache) {
+        // Skipped files didn't import anything this time, but still depend on what they imported
+        // before.
+        dependencies.append(cache->dependencies());
+        dependencies.removeDuplicates();
+        cache->setDependencies(dependencies);
+
+        QString errorString;
+        if (!cache->save(&errorString)) {
+            fprintf(stderr, "Cannot write qmlcachegen cache: %s\n", qPrintable(errorString));
+            return EXIT_FAILURE;
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(int argc, char **argv)
 {
     // Produce reliably the same output for the same input by disabling QHash's random seeding.
@@ -99,6 +464,37 @@ int main(int argc, char **argv)
 
     QCommandLineOption outputFileOption(QStringLiteral("o"), QCoreApplication::translate("main", "Output file name"), QCoreApplication::translate("main", "file name"));
     parser.addOption(outputFileOption);
+    QCommandLineOption batchOption(
+                QStringLiteral("batch"),
+                QCoreApplication::translate(
+                    "main", "Compile all files listed in the given file in one process. Each line "
+                            "holds an input file, an output file and, optionally, a resource path, "
+                            "separated by tabs."),
+                QCoreApplication::translate("main", "batch file"));
+    parser.addOption(batchOption);
+    QCommandLineOption jobsOption(
+                QStringLiteral("j"),
+                QCoreApplication::translate(
+                    "main", "Number of threads to use in batch mode. Defaults to the number of "
+                            "CPU cores."),
+                QCoreApplication::translate("main", "jobs"));
+    parser.addOption(jobsOption);
+    QCommandLineOption cacheDirOption(
+                QStringLiteral("cache-dir"),
+                QCoreApplication::translate(
+                    "main", "Directory for keeping track of compiled files in batch mode. Files "
+                            "that didn't change since the last run, and whose imports didn't "
+                            "change either, are skipped."),
+                QCoreApplication::translate("main", "directory"));
+    parser.addOption(cacheDirOption);
+    QCommandLineOption bytecodeCoverageOption(
+                QStringLiteral("bytecode-coverage"),
+                QCoreApplication::translate(
+                    "main", "Write a JSON report of how many functions and bindings could be "
+                            "compiled to C++, and which instructions caused the others to be "
+                            "rejected, to the given file."),
+                QCoreApplication::translate("main", "file name"));
+    parser.addOption(bytecodeCoverageOption);
 
     parser.addPositionalArgument(QStringLiteral("[qml file]"),
             QStringLiteral("QML source file to generate cache for."));
@@ -112,22 +508,45 @@ int main(int argc, char **argv)
 
     parser.process(arguments);
 
-    enum Output {
-        GenerateCpp,
-        GenerateCacheFile,
-        GenerateLoader,
-        GenerateLoaderStandAlone,
-    } target = GenerateCacheFile;
+    QQmlJSResourceFileMapper fileMapper(parser.values(resourceOption));
+
+    CompileOptions options;
+    if (parser.isSet(importPathOption))
+        options.importPaths = parser.values(importPathOption);
+    options.importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
+    options.qmldirFiles = parser.values(importsOption);
+    options.fileMapper = &fileMapper;
+    options.hasResourceFiles = parser.isSet(resourceOption);
+    options.onlyBytecode = parser.isSet(onlyBytecode);
+
+    if (parser.isSet(batchOption)) {
+        if (!parser.positionalArguments().isEmpty() || parser.isSet(outputFileOption)) {
+            fprintf(stderr, "Input and output files cannot be given in addition to --%s\n",
+                    qPrintable(batchOption.names().first()));
+            return EXIT_FAILURE;
+        }
+
+        int jobs = QThread::idealThreadCount();
+        if (parser.isSet(jobsOption)) {
+            bool ok = false;
+            jobs = parser.value(jobsOption).toInt(&ok);
+            if (!ok || jobs < 1) {
+                fprintf(stderr, "Invalid number of jobs: %s\n",
+                        qPrintable(parser.value(jobsOption)));
+                return EXIT_FAILURE;
+            }
+        }
+
+        return compileBatch(parser.value(batchOption), options, parser.values(resourceOption),
+                            resourcePathOption.names().first(), jobs,
+                            parser.value(cacheDirOption), parser.value(bytecodeCoverageOption));
+    }
 
     QString outputFileName;
     if (parser.isSet(outputFileOption))
         outputFileName = parser.value(outputFileOption);
 
-    if (outputFileName.endsWith(QLatin1String(".cpp"))) {
-        target = GenerateCpp;
-        if (outputFileName.endsWith(QLatin1String("qmlcache_loader.cpp")))
-            target = GenerateLoader;
-    }
+    Output target = outputTarget(outputFileName);
 
     if (target == GenerateLoader && parser.isSet(resourceNameOption))
         target = GenerateLoaderStandAlone;
@@ -169,114 +588,28 @@ int main(int argc, char **argv)
         }
         return EXIT_SUCCESS;
     }
-    QString inputFileUrl = inputFile;
 
-    QQmlJSSaveFunction saveFunction;
-    QQmlJSResourceFileMapper fileMapper(parser.values(resourceOption));
-    QString inputResourcePath = parser.value(resourcePathOption);
+    CompileTask task { inputFile, outputFileName, parser.value(resourcePathOption) };
 
     // If the user didn't specify the resource path corresponding to the file on disk being
     // compiled, try to determine it from the resource file, if one was supplied.
-    if (inputResourcePath.isEmpty()) {
-        const QStringList resourcePaths = fileMapper.resourcePaths(
-                    QQmlJSResourceFileMapper::localFileFilter(inputFile));
-        if (target == GenerateCpp && resourcePaths.isEmpty()) {
-            fprintf(stderr, "No resource path for file: %s\n", qPrintable(inputFile));
-            return EXIT_FAILURE;
-        }
-
-        if (resourcePaths.size() == 1) {
-            inputResourcePath = resourcePaths.first();
-        } else if (target == GenerateCpp) {
-            fprintf(stderr, "Multiple resource paths for file %s. "
-                            "Use the --%s option to disambiguate:\n",
-                    qPrintable(inputFile),
-                    qPrintable(resourcePathOption.names().first()));
-            for (const QString &resourcePath: resourcePaths)
-                fprintf(stderr, "\t%s\n", qPrintable(resourcePath));
-            return EXIT_FAILURE;
-        }
+    QString errorMessage;
+    if (!resolveResourcePath(&task, target, options, resourcePathOption.names().first(),
+                             &errorMessage)) {
+        fprintf(stderr, "%s", qPrintable(errorMessage));
+        return EXIT_FAILURE;
     }
 
-    if (target == GenerateCpp) {
-        inputFileUrl = QStringLiteral("qrc://") + inputResourcePath;
-        saveFunction = [inputResourcePath, outputFileName](
-                               const QV4::CompiledData::SaveableUnitPointer &unit,
-                               const QQmlJSAotFunctionMap &aotFunctions,
-                               QString *errorString) {
-            return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit, aotFunctions,
-                                       errorString);
-        };
-
-    } else {
-        saveFunction = [outputFileName](const QV4::CompiledData::SaveableUnitPointer &unit,
-                                        const QQmlJSAotFunctionMap &aotFunctions,
-                                        QString *errorString) {
-            Q_UNUSED(aotFunctions);
-            return unit.saveToDisk<char>(
-                    [&outputFileName, errorString](const char *data, quint32 size) {
-                        return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
-                                outputFileName, data, size, errorString);
-            });
-        };
+    QQmlJSBytecodeCoverage coverage;
+    QQmlJSCompileError error;
+    if (!compileFile(task, options, nullptr, &coverage, &error)) {
+        error.print();
+        return EXIT_FAILURE;
     }
 
-    if (inputFile.endsWith(QLatin1String(".qml"))) {
-        QQmlJSCompileError error;
-        if (target != GenerateCpp || inputResourcePath.isEmpty() || parser.isSet(onlyBytecode)) {
-            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, &error,
-                                 /* storeSourceLocation */ false)) {
-                error.augment(QStringLiteral("Error compiling qml file: ")).print();
-                return EXIT_FAILURE;
-            }
-        } else {
-            QStringList importPaths;
-            if (parser.isSet(importPathOption))
-                importPaths = parser.values(importPathOption);
-
-            importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
-
-            QQmlJSImporter importer(
-                        importPaths, parser.isSet(resourceOption) ? &fileMapper : nullptr);
-            QQmlJSLogger logger;
-
-            // Always trigger the qFatal() on "pragma Strict" violations.
-            logger.setCategoryLevel(qmlCompiler, QtCriticalMsg);
-            logger.setCategoryIgnored(qmlCompiler, false);
-
-            // By default, we're completely silent,
-            // as the lcAotCompiler category default is QtFatalMsg
-            const bool loggingEnabled = lcAotCompiler().isDebugEnabled()
-                    || lcAotCompiler().isInfoEnabled() || lcAotCompiler().isWarningEnabled()
-                    || lcAotCompiler().isCriticalEnabled();
-            if (!loggingEnabled)
-                logger.setSilent(true);
-
-            QQmlJSAotCompiler cppCodeGen(
-                        &importer, u':' + inputResourcePath, parser.values(importsOption), &logger);
-
-            if (!qCompileQmlFile(inputFile, saveFunction, &cppCodeGen, &error,
-                                 /* storeSourceLocation */ true)) {
-                error.augment(QStringLiteral("Error compiling qml file: ")).print();
-                return EXIT_FAILURE;
-            }
-
-            QList<QQmlJS::DiagnosticMessage> warnings = importer.takeGlobalWarnings();
-
-            if (!warnings.isEmpty()) {
-                logger.log(QStringLiteral("Type warnings occurred while compiling file:"),
-                           qmlImport, QQmlJS::SourceLocation());
-                logger.processMessages(warnings, qmlImport);
-            }
-        }
-    } else if (inputFile.endsWith(QLatin1String(".js")) || inputFile.endsWith(QLatin1String(".mjs"))) {
-        QQmlJSCompileError error;
-        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, &error)) {
-            error.augment(QLatin1String("Error compiling js file: ")).print();
-            return EXIT_FAILURE;
-        }
-    } else {
-        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
+    if (parser.isSet(bytecodeCoverageOption)
+            && !writeBytecodeCoverage(parser.value(bytecodeCoverageOption), coverage)) {
+        return EXIT_FAILURE;
     }
 
     return EXIT_SUCCESS;
@@ -0,0 +1,190 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qmlcachegenbuildcache.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+static const quint32 CacheMagic = 0x51434743; // "QCGC"
+static const quint32 CacheFormatVersion = 1;
+
+QmlCacheGenBuildCache::QmlCacheGenBuildCache(const QString &cacheDirectory)
+    : m_cacheFile(QDir(cacheDirectory).filePath(QStringLiteral("qmlcachegen.cache")))
+{
+}
+
+QByteArray QmlCacheGenBuildCache::hashFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(&file);
+    return hash.result();
+}
+
+QByteArray QmlCacheGenBuildCache::fingerprint(const QString &path)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+        return QByteArray("<missing>");
+
+    if (info.isDir()) {
+        // Directory imports depend on the set of QML files in the directory, not on the
+        // directory's other contents.
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        const QStringList entries = QDir(path).entryList(
+                    QStringList() << QStringLiteral("*.qml"), QDir::Files, QDir::Name);
+        for (const QString &entry : entries) {
+            hash.addData(entry.toUtf8());
+            hash.addData(QByteArrayView("\0", 1));
+        }
+        return hash.result();
+    }
+
+    return hashFile(path);
+}
+
+QByteArray QmlCacheGenBuildCache::taskKey(const QString &inputFile, const QString &outputFile,
+                                          const QString &resourcePath) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(m_globalKey);
+    for (const QString &part : { inputFile, outputFile, resourcePath }) {
+        hash.addData(part.toUtf8());
+        hash.addData(QByteArrayView("\0", 1));
+    }
+    hash.addData(hashFile(inputFile));
+    return hash.result();
+}
+
+bool QmlCacheGenBuildCache::isUpToDate(const QString &outputFile,
+                                       const QByteArray &taskKey) const
+{
+    const auto it = m_entries.constFind(outputFile);
+    if (it == m_entries.constEnd() || it->taskKey != taskKey)
+        return false;
+
+    // Someone else may have touched the output in the mean time.
+    return hashFile(outputFile) == it->outputHash;
+}
+
+void QmlCacheGenBuildCache::update(const QString &outputFile, const QByteArray &taskKey)
+{
+    const QByteArray outputHash = hashFile(outputFile);
+    if (outputHash.isEmpty())
+        m_entries.remove(outputFile);
+    else
+        m_entries.insert(outputFile, { taskKey, outputHash });
+}
+
+void QmlCacheGenBuildCache::setDependencies(const QStringList &dependencies)
+{
+    m_dependencies.clear();
+    for (const QString &dependency : dependencies)
+        m_dependencies.insert(dependency, fingerprint(dependency));
+}
+
+bool QmlCacheGenBuildCache::dependenciesUnchanged() const
+{
+    for (auto it = m_dependencies.constBegin(), end = m_dependencies.constEnd(); it != end; ++it) {
+        if (fingerprint(it.key()) != it.value())
+            return false;
+    }
+    return true;
+}
+
+bool QmlCacheGenBuildCache::load()
+{
+    m_entries.clear();
+    m_dependencies.clear();
+
+    QFile file(m_cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray globalKey;
+    stream >> magic >> version;
+    if (magic != CacheMagic || version != CacheFormatVersion)
+        return false;
+
+    stream >> globalKey;
+    if (globalKey != m_globalKey)
+        return false;
+
+    quint32 numDependencies = 0;
+    stream >> numDependencies;
+    for (quint32 i = 0; i < numDependencies && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        QByteArray fingerprint;
+        stream >> path >> fingerprint;
+        m_dependencies.insert(path, fingerprint);
+    }
+
+    quint32 numEntries = 0;
+    stream >> numEntries;
+    for (quint32 i = 0; i < numEntries && stream.status() == QDataStream::Ok; ++i) {
+        QString outputFile;
+        Entry entry;
+        stream >> outputFile >> entry.taskKey >> entry.outputHash;
+        m_entries.insert(outputFile, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok || !dependenciesUnchanged()) {
+        m_entries.clear();
+        m_dependencies.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool QmlCacheGenBuildCache::save(QString *errorString) const
+{
+    if (!QDir().mkpath(QFileInfo(m_cacheFile).absolutePath())) {
+        *errorString = QStringLiteral("Cannot create cache directory for ") + m_cacheFile;
+        return false;
+    }
+
+    QSaveFile file(m_cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << CacheMagic << CacheFormatVersion << m_globalKey;
+
+    // Sort, so that the cache file is reproducible.
+    QStringList dependencies = m_dependencies.keys();
+    dependencies.sort();
+    stream << quint32(dependencies.size());
+    for (const QString &dependency : std::as_const(dependencies))
+        stream << dependency << m_dependencies.value(dependency);
+
+    QStringList outputs = m_entries.keys();
+    outputs.sort();
+    stream << quint32(outputs.size());
+    for (const QString &output : std::as_const(outputs)) {
+        const Entry entry = m_entries.value(output);
+        stream << output << entry.taskKey << entry.outputHash;
+    }
+
+    if (!file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,64 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QMLCACHEGENBUILDCACHE_H
+#define QMLCACHEGENBUILDCACHE_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Persistent record of what a previous qmlcachegen batch run produced.
+
+    Each output file is associated with a key derived from the contents of its input file and
+    the options it was compiled with, as well as with a hash of the output it was compiled to.
+    Additionally the cache records a fingerprint of every qmldir, qmltypes and QML file the
+    importers looked at. If any of those change, all entries are dropped since we cannot tell
+    which outputs depended on them.
+*/
+class QmlCacheGenBuildCache
+{
+public:
+    explicit QmlCacheGenBuildCache(const QString &cacheDirectory);
+
+    bool load();
+    bool save(QString *errorString) const;
+
+    static QByteArray hashFile(const QString &path);
+
+    // Options that affect every output, such as import paths and the compiler build.
+    void setGlobalKey(const QByteArray &globalKey) { m_globalKey = globalKey; }
+
+    QByteArray taskKey(const QString &inputFile, const QString &outputFile,
+                       const QString &resourcePath) const;
+
+    bool isUpToDate(const QString &outputFile, const QByteArray &taskKey) const;
+    void update(const QString &outputFile, const QByteArray &taskKey);
+    void remove(const QString &outputFile) { m_entries.remove(outputFile); }
+
+    QStringList dependencies() const { return m_dependencies.keys(); }
+    void setDependencies(const QStringList &dependencies);
+
+private:
+    struct Entry
+    {
+        QByteArray taskKey;
+        QByteArray outputHash;
+    };
+
+    static QByteArray fingerprint(const QString &path);
+    bool dependenciesUnchanged() const;
+
+    QString m_cacheFile;
+    QByteArray m_globalKey;
+    QHash<QString, Entry> m_entries;
+    QHash<QString, QByteArray> m_dependencies;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMLCACHEGENBUILDCACHE_H
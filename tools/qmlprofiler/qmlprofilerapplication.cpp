@@ -43,7 +43,9 @@ static const char *features[] = {
     "binding",
     "handlingsignal",
     "inputevents",
-    "debugmessages"
+    "debugmessages",
+    "quick3d",
+    "javascriptsampling"
 };
 
 Q_STATIC_ASSERT(sizeof(features) == MaximumProfileFeature * sizeof(char *));
@@ -146,7 +148,8 @@ void QmlProfilerApplication::parseArguments()
 
     QCommandLineOption include(QLatin1String("include"),
                                tr("Comma-separated list of features to record. By default all "
-                                  "features supported by the QML engine are recorded. If --include "
+                                  "features supported by the QML engine, except "
+                                  "javascriptsampling, are recorded. If --include "
                                   "is specified, only the given features will be recorded. "
                                   "The following features are unserstood by qmlprofiler: %1").arg(
                                    featureList.join(", ")),
@@ -160,6 +163,14 @@ void QmlProfilerApplication::parseArguments()
                             QLatin1String("feature,..."));
     parser.addOption(exclude);
 
+    QCommandLineOption flamegraph(QLatin1String("flamegraph"),
+                                  tr("Sample the JavaScript call stacks instead of tracing every "
+                                     "function call, and save them as folded stacks, suitable "
+                                     "for flamegraph tools, instead of a trace file. Unless "
+                                     "--include or --exclude are given, only the "
+                                     "javascriptsampling feature is recorded."));
+    parser.addOption(flamegraph);
+
     QCommandLineOption interactive(QLatin1String("interactive"),
                                    tr("Manually control the recording from the command line. The "
                                       "profiler will not terminate itself when the application "
@@ -206,7 +217,13 @@ void QmlProfilerApplication::parseArguments()
     m_recording = (parser.value(record) == QLatin1String("on"));
     m_interactive = parser.isSet(interactive);
 
-    quint64 features = std::numeric_limits<quint64>::max();
+    // Sampling is an alternative to tracing each JavaScript call, and only useful on its own.
+    quint64 features = parser.isSet(flamegraph)
+            ? (quint64(1) << ProfileJavaScriptSampling)
+            : std::numeric_limits<quint64>::max() & ~(quint64(1) << ProfileJavaScriptSampling);
+    if (parser.isSet(flamegraph))
+        m_profilerData->setOutputFormat(QmlProfilerData::FoldedStacks);
+
     if (parser.isSet(include)) {
         if (parser.isSet(exclude)) {
             logError(tr("qmlprofiler can only process either --include or --exclude, not both."));
@@ -215,8 +232,11 @@ void QmlProfilerApplication::parseArguments()
         features = parseFeatures(featureList, parser.value(include), false);
     }
 
-    if (parser.isSet(exclude))
+    if (parser.isSet(exclude)) {
         features = parseFeatures(featureList, parser.value(exclude), true);
+        if (!parser.isSet(flamegraph))
+            features &= ~(quint64(1) << ProfileJavaScriptSampling);
+    }
 
     if (features == 0)
         parser.showHelp(4);
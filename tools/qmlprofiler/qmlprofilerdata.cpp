@@ -37,7 +37,9 @@ static const char *MESSAGE_STRINGS[] = {
     "PixmapCache",
     "SceneGraph",
     "MemoryAllocation",
-    "DebugMessage"
+    "DebugMessage",
+    "Quick3DFrame",
+    "JavaScriptSample"
 };
 
 Q_STATIC_ASSERT(sizeof(MESSAGE_STRINGS) == MaximumMessage * sizeof(const char *));
@@ -58,6 +60,7 @@ public:
     // internal state while collecting events
     qint64 qmlMeasuredTime;
     QmlProfilerData::State state;
+    QmlProfilerData::OutputFormat outputFormat = QmlProfilerData::TraceXml;
 };
 
 /////////////////////////////////////////////////////////////////
@@ -135,7 +138,9 @@ void QmlProfilerData::addEventType(const QQmlProfilerEventType &type)
 
     QString details;
     // generate details string
-    if (!type.data().isEmpty()) {
+    if (type.message() == JavaScriptSample) {
+        details = type.data();
+    } else if (!type.data().isEmpty()) {
         details = type.data().simplified();
         QRegularExpression rewrite(QStringLiteral("^\\(function \\$(\\w+)\\(\\) \\{ (return |)(.+) \\}\\)$"));
         QRegularExpressionMatch match = rewrite.match(details);
@@ -186,6 +191,15 @@ void QmlProfilerData::addEventType(const QQmlProfilerEventType &type)
     case DebugMessage:
         displayName = QString::fromLatin1("DebugMessage:%1").arg(type.detailType());
         break;
+    case Quick3DFrame:
+        displayName = QString::fromLatin1("Quick3D:%1").arg(type.detailType());
+        break;
+    case JavaScriptSample: {
+        // The innermost frame, without its location.
+        const QString frame = type.data().mid(type.data().lastIndexOf(QLatin1Char(';')) + 1);
+        displayName = QLatin1String("Sample:") + frame.left(frame.lastIndexOf(QLatin1String(" (")));
+        break;
+    }
     case MaximumMessage: {
         const QQmlProfilerEventLocation eventLocation = type.location();
         // generate hash
@@ -375,6 +389,11 @@ private:
     QXmlStreamWriter stream;
 };
 
+void QmlProfilerData::setOutputFormat(OutputFormat format)
+{
+    d->outputFormat = format;
+}
+
 bool QmlProfilerData::save(const QString &filename)
 {
     if (isEmpty()) {
@@ -382,6 +401,9 @@ bool QmlProfilerData::save(const QString &filename)
         return false;
     }
 
+    if (d->outputFormat == FoldedStacks)
+        return saveFoldedStacks(filename);
+
     StreamWriter stream(filename);
     if (!stream.error.isEmpty()) {
         emit error(stream.error);
@@ -477,6 +499,8 @@ bool QmlProfilerData::save(const QString &filename)
             stream.writeAttribute("timing5", event, 4, false);
         } else if (type.message() == MemoryAllocation) {
             stream.writeAttribute("amount", event, 0);
+        } else if (type.message() == JavaScriptSample) {
+            stream.writeAttribute("sampleCount", event, 0);
         }
         stream.writeEndElement();
     };
@@ -555,6 +579,51 @@ bool QmlProfilerData::save(const QString &filename)
     return true;
 }
 
+bool QmlProfilerData::saveFoldedStacks(const QString &filename)
+{
+    // One line per distinct stack, "outer;...;inner count", as expected by flamegraph.pl and
+    // compatible tools. Each flush sends the stacks aggregated since the previous one, so the
+    // same stack can show up multiple times in the trace.
+    QHash<int, qint64> counts;
+    for (const QQmlProfilerEvent &event : qAsConst(d->events)) {
+        if (d->eventTypes.at(event.typeIndex()).message() == JavaScriptSample)
+            counts[event.typeIndex()] += event.number<qint64>(0);
+    }
+
+    if (counts.isEmpty()) {
+        emit error(tr("No JavaScript samples to save. Record with the \"javascriptsampling\" "
+                      "feature enabled."));
+        return false;
+    }
+
+    QStringList lines;
+    lines.reserve(counts.size());
+    for (auto it = counts.constBegin(), end = counts.constEnd(); it != end; ++it) {
+        QString stack = d->eventTypes.at(it.key()).data();
+        lines.append(stack.replace(QLatin1Char('\n'), QLatin1Char(' '))
+                     + QLatin1Char(' ') + QString::number(it.value()));
+    }
+    lines.sort();
+
+    QFile file;
+    if (!filename.isEmpty()) {
+        file.setFileName(filename);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            emit error(tr("Could not open %1 for writing").arg(filename));
+            return false;
+        }
+    } else if (!file.open(stdout, QIODevice::WriteOnly | QIODevice::Text)) {
+        emit error(tr("Could not open stdout for writing"));
+        return false;
+    }
+
+    for (const QString &line : qAsConst(lines)) {
+        file.write(line.toUtf8());
+        file.write("\n");
+    }
+    return true;
+}
+
 void QmlProfilerData::setState(QmlProfilerData::State state)
 {
     // It's not an error, we are continuously calling "AcquiringData" for example
@@ -22,6 +22,11 @@ public:
         Done
     };
 
+    enum OutputFormat {
+        TraceXml,
+        FoldedStacks
+    };
+
     explicit QmlProfilerData(QObject *parent = nullptr);
     ~QmlProfilerData();
 
@@ -43,6 +48,7 @@ public:
     void setTraceStartTime(qint64 time);
 
     void complete();
+    void setOutputFormat(OutputFormat format);
     bool save(const QString &filename);
 
 signals:
@@ -51,6 +57,7 @@ signals:
     void dataReady();
 
 private:
+    bool saveFoldedStacks(const QString &filename);
     void sortStartTimes();
     void computeQmlTime();
     void setState(QmlProfilerData::State state);